@@ -129,40 +129,41 @@ extern "C" void addfields(int* nshg, int* vtkNotUsed(ndof), double* dofArray, in
     return;
   }
   vtkIdType NumberOfNodes = UnstructuredGrid->GetNumberOfPoints();
-  // now add numerical field data
+  // now add numerical field data. The fields are stored one after the other
+  // in dofArray, with nshg values per component, and are registered as
+  // buffers that Catalyst uses without copying them.
   // velocity
-  if (idd->IsFieldNeeded("velocity"))
+  if (idd->IsFieldNeeded("velocity", vtkDataObject::POINT))
   {
-    vtkDoubleArray* velocity = vtkDoubleArray::New();
-    velocity->SetName("velocity");
-    velocity->SetNumberOfComponents(3);
-    velocity->SetNumberOfTuples(NumberOfNodes);
-    for (vtkIdType idx = 0; idx < NumberOfNodes; idx++)
-    {
-      velocity->SetTuple3(idx, dofArray[idx], dofArray[idx + *nshg], dofArray[idx + *nshg * 2]);
-    }
-    UnstructuredGrid->GetPointData()->AddArray(velocity);
-    velocity->Delete();
+    void* velocity[3] = { dofArray, dofArray + *nshg, dofArray + 2 * *nshg };
+    idd->AddSOAFieldBuffer(
+      "velocity", vtkDataObject::POINT, VTK_DOUBLE, velocity, NumberOfNodes, 3);
+  }
+  else
+  {
+    idd->RemoveFieldBuffer("velocity", vtkDataObject::POINT);
   }
 
   // pressure
-  if (idd->IsFieldNeeded("pressure"))
+  if (idd->IsFieldNeeded("pressure", vtkDataObject::POINT))
   {
-    vtkDoubleArray* pressure = vtkDoubleArray::New();
-    pressure->SetName("pressure");
-    pressure->SetArray(dofArray + *nshg * 3, NumberOfNodes, 1);
-    UnstructuredGrid->GetPointData()->AddArray(pressure);
-    pressure->Delete();
+    idd->AddFieldBuffer(
+      "pressure", vtkDataObject::POINT, VTK_DOUBLE, dofArray + *nshg * 3, NumberOfNodes, 1);
+  }
+  else
+  {
+    idd->RemoveFieldBuffer("pressure", vtkDataObject::POINT);
   }
 
   // Temperature
   // temperature only varies from compressible flow
-  if (idd->IsFieldNeeded("temperature") && *compressibleFlow == 1)
+  if (idd->IsFieldNeeded("temperature", vtkDataObject::POINT) && *compressibleFlow == 1)
+  {
+    idd->AddFieldBuffer(
+      "temperature", vtkDataObject::POINT, VTK_DOUBLE, dofArray + *nshg * 4, NumberOfNodes, 1);
+  }
+  else
   {
-    vtkDoubleArray* temperature = vtkDoubleArray::New();
-    temperature->SetName("temperature");
-    temperature->SetArray(dofArray + *nshg * 4, NumberOfNodes, 1);
-    UnstructuredGrid->GetPointData()->AddArray(temperature);
-    temperature->Delete();
+    idd->RemoveFieldBuffer("temperature", vtkDataObject::POINT);
   }
 }
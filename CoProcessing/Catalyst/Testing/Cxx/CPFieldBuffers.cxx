@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    CPFieldBuffers.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the field buffers registered with vtkCPInputDataDescription
+// are wrapped without copies in arrays of structures, structures of arrays
+// and strided views, and that their release callbacks only run once no array
+// wraps them, including when a buffer is registered again at each time step.
+#include "vtkCPInputDataDescription.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const vtkIdType NumberOfTuples = 4;
+
+void CountRelease(void* clientData)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+// Tuple i of the expected field is (i, 10 + i, 20 + i).
+double Expected(vtkIdType tuple, int comp)
+{
+  return comp * 10 + tuple;
+}
+
+bool HasExpectedValues(vtkDataArray* array)
+{
+  if (!array || array->GetNumberOfTuples() != NumberOfTuples ||
+    array->GetNumberOfComponents() != 3)
+  {
+    return false;
+  }
+  for (vtkIdType tuple = 0; tuple < NumberOfTuples; ++tuple)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      if (array->GetComponent(tuple, comp) != Expected(tuple, comp))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int CPFieldBuffers(int, char* [])
+{
+  // the expected field as an array of structures and as a structure of arrays.
+  double aos[NumberOfTuples * 3];
+  double soa[3 * NumberOfTuples];
+  for (vtkIdType tuple = 0; tuple < NumberOfTuples; ++tuple)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      aos[tuple * 3 + comp] = Expected(tuple, comp);
+      soa[comp * NumberOfTuples + tuple] = Expected(tuple, comp);
+    }
+  }
+
+  vtkNew<vtkCPInputDataDescription> idd;
+  vtkNew<vtkPolyData> grid;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfTuples);
+  grid->SetPoints(points);
+  idd->SetGrid(grid);
+
+  // Arrays of structures are wrapped in the regular array.
+  int aosReleases = 0;
+  idd->AddFieldBuffer("aos", vtkDataObject::POINT, VTK_DOUBLE, aos, NumberOfTuples, 3, 0, 1,
+    CountRelease, &aosReleases);
+  vtkDataArray* aosArray = idd->GetFieldBufferArray("aos", vtkDataObject::POINT);
+  expect(vtkDoubleArray::SafeDownCast(aosArray) && aosArray->GetVoidPointer(0) == aos,
+    "an array of structures was not wrapped in a vtkDoubleArray.");
+  expect(HasExpectedValues(aosArray), "wrong values for an array of structures.");
+
+  // Structures of arrays are wrapped in vtkSOADataArrayTemplate.
+  int soaReleases = 0;
+  void* components[3] = { soa, soa + NumberOfTuples, soa + 2 * NumberOfTuples };
+  idd->AddSOAFieldBuffer("soa", vtkDataObject::POINT, VTK_DOUBLE, components, NumberOfTuples, 3,
+    CountRelease, &soaReleases);
+  vtkDataArray* soaArray = idd->GetFieldBufferArray("soa", vtkDataObject::POINT);
+  expect(vtkSOADataArrayTemplate<double>::SafeDownCast(soaArray),
+    "a structure of arrays was not wrapped in a vtkSOADataArrayTemplate.");
+  expect(HasExpectedValues(soaArray), "wrong values for a structure of arrays.");
+
+  // Other layouts use a strided view reading and writing the buffer in place.
+  int stridedReleases = 0;
+  idd->AddFieldBuffer("strided", vtkDataObject::POINT, VTK_DOUBLE, soa, NumberOfTuples, 3,
+    /*tupleStride=*/1, /*componentStride=*/NumberOfTuples, CountRelease, &stridedReleases);
+  vtkDataArray* stridedArray = idd->GetFieldBufferArray("strided", vtkDataObject::POINT);
+  expect(HasExpectedValues(stridedArray), "wrong values for a strided view.");
+  const double* copy = static_cast<double*>(stridedArray->GetVoidPointer(0));
+  expect(copy[3 * 2 + 1] == Expected(2, 1), "wrong array of structures copy of a strided view.");
+  stridedArray->SetComponent(2, 1, -1.0);
+  expect(soa[NumberOfTuples + 2] == -1.0, "a strided view did not write to its buffer.");
+  soa[NumberOfTuples + 2] = Expected(2, 1);
+  stridedArray->Modified();
+  vtkSmartPointer<vtkDataArray> deepCopy;
+  deepCopy.TakeReference(stridedArray->NewInstance());
+  deepCopy->DeepCopy(stridedArray);
+  expect(HasExpectedValues(deepCopy), "wrong deep copy of a strided view.");
+
+  idd->AttachFieldBuffers();
+  expect(grid->GetPointData()->GetArray("aos") == aosArray &&
+      grid->GetPointData()->GetArray("soa") == soaArray &&
+      grid->GetPointData()->GetArray("strided") == stridedArray,
+    "the buffers were not attached to the grid.");
+
+  // Release callbacks run once no array uses the buffer, e.g. when the
+  // pipelines keep a reference to the array after it is unregistered.
+  vtkSmartPointer<vtkDataArray> kept = aosArray;
+  idd->RemoveFieldBuffer("aos", vtkDataObject::POINT);
+  expect(grid->GetPointData()->GetArray("aos") == nullptr,
+    "an unregistered buffer was not removed from the grid.");
+  expect(aosReleases == 0, "a buffer was released while an array used it.");
+  kept = nullptr;
+  expect(aosReleases == 1, "a buffer was not released with its last array.");
+
+  // Registering a buffer again while the pipelines still use the array of
+  // the previous registration, as simulations do at each time step.
+  int firstReleases = 0, secondReleases = 0;
+  idd->AddFieldBuffer("aos", vtkDataObject::POINT, VTK_DOUBLE, aos, NumberOfTuples, 3, 0, 1,
+    CountRelease, &firstReleases);
+  kept = idd->GetFieldBufferArray("aos", vtkDataObject::POINT);
+  idd->AddFieldBuffer("aos", vtkDataObject::POINT, VTK_DOUBLE, aos, NumberOfTuples, 3, 0, 1,
+    CountRelease, &secondReleases);
+  kept = nullptr;
+  expect(firstReleases == 0 && secondReleases == 0,
+    "a buffer registered again was released while the new array used it.");
+  idd->RemoveFieldBuffer("aos", vtkDataObject::POINT);
+  expect(firstReleases == 1 && secondReleases == 1,
+    "a buffer registered twice was not released with its last array.");
+
+  // The same for the components of a structure of arrays, which the
+  // pressure of the Phasta adaptor shares with its velocity.
+  int pressureReleases = 0;
+  idd->AddFieldBuffer("pressure", vtkDataObject::POINT, VTK_DOUBLE, soa, NumberOfTuples, 1, 0, 1,
+    CountRelease, &pressureReleases);
+  idd->RemoveFieldBuffer("soa", vtkDataObject::POINT);
+  expect(soaReleases == 0, "a structure of arrays was released while another array used it.");
+  idd->RemoveFieldBuffer("pressure", vtkDataObject::POINT);
+  expect(soaReleases == 1 && pressureReleases == 1,
+    "a structure of arrays was not released with its last array.");
+
+  // The strided view holds its buffer itself.
+  kept = stridedArray;
+  idd->RemoveAllFieldBuffers();
+  expect(stridedReleases == 0 && idd->GetNumberOfFieldBuffers() == 0,
+    "a strided view was released while it was used.");
+  kept = nullptr;
+  expect(stridedReleases == 1, "a strided view was not released.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,274 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    CPProcessorAsynchronous.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCPProcessor co-processes time steps asynchronously on a
+// snapshot of the inputs, blocks the simulation when MaximumNumberOfPendingSteps
+// time steps are pending, reports failures of pending time steps and falls
+// back to synchronous execution for pipelines that require it and when a
+// working directory is given.
+#include "vtkCPDataDescription.h"
+#include "vtkCPInputDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Records the value of the "step" array of its input. CoProcess() waits until
+// the pipeline is opened, standing for a pipeline that takes a long time.
+class TestPipeline : public vtkCPPipeline
+{
+public:
+  static TestPipeline* New();
+  vtkTypeMacro(TestPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription* dataDescription) override
+  {
+    vtkCPInputDataDescription* idd = dataDescription->GetInputDescriptionByName("input");
+    idd->GenerateMeshOn();
+    idd->AllFieldsOn();
+    return 1;
+  }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->NumberOfStarted++;
+    this->Condition.notify_all();
+    this->Condition.wait(lock, [this]() { return this->Open; });
+    vtkDataSet* grid =
+      vtkDataSet::SafeDownCast(dataDescription->GetInputDescriptionByName("input")->GetGrid());
+    this->Values.push_back(grid->GetPointData()->GetArray("step")->GetTuple1(0));
+    this->ThreadIds.push_back(std::this_thread::get_id());
+    this->WorkingDirectories.push_back(vtksys::SystemTools::GetCurrentWorkingDirectory());
+    return this->Fail ? 0 : 1;
+  }
+
+  bool CanCoProcessAsynchronously() override { return this->Asynchronous; }
+
+  void SetOpen(bool open)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Open = open;
+    this->Condition.notify_all();
+  }
+
+  void WaitForStarted(int count)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [&]() { return this->NumberOfStarted >= count; });
+  }
+
+  std::vector<double> GetValues()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Values;
+  }
+
+  std::vector<std::thread::id> GetThreadIds()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->ThreadIds;
+  }
+
+  std::vector<std::string> GetWorkingDirectories()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->WorkingDirectories;
+  }
+
+  bool Asynchronous = true;
+  bool Fail = false;
+
+private:
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  bool Open = true;
+  int NumberOfStarted = 0;
+  std::vector<double> Values;
+  std::vector<std::thread::id> ThreadIds;
+  std::vector<std::string> WorkingDirectories;
+};
+vtkStandardNewMacro(TestPipeline);
+
+// Stands for a simulation whose single point has the time step as value.
+class Simulation
+{
+public:
+  Simulation(vtkCPProcessor* processor)
+    : Processor(processor)
+  {
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(0.0, 0.0, 0.0);
+    this->Grid->SetPoints(points);
+    this->Values->SetName("step");
+    this->Values->SetNumberOfTuples(1);
+    this->Grid->GetPointData()->AddArray(this->Values);
+    this->DataDescription->AddInput("input");
+  }
+
+  // Co-processes a time step and then changes the values in place, as the
+  // simulation going on would.
+  int Step(int step)
+  {
+    this->DataDescription->SetTimeData(step, step);
+    if (!this->Processor->RequestDataDescription(this->DataDescription))
+    {
+      return 0;
+    }
+    this->Values->SetValue(0, step);
+    this->DataDescription->GetInputDescriptionByName("input")->SetGrid(this->Grid);
+    const int success = this->Processor->CoProcess(this->DataDescription);
+    this->Values->SetValue(0, -1);
+    return success;
+  }
+
+private:
+  vtkCPProcessor* Processor;
+  vtkNew<vtkCPDataDescription> DataDescription;
+  vtkNew<vtkPolyData> Grid;
+  vtkNew<vtkDoubleArray> Values;
+};
+
+// Runs a time step from another thread and returns whether it was still
+// blocked after a while, then opens the pipeline and waits for the step.
+bool IsBlocked(Simulation& simulation, TestPipeline* pipeline, int step)
+{
+  std::atomic<bool> returned(false);
+  std::thread thread([&]() {
+    simulation.Step(step);
+    returned = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  const bool blocked = !returned;
+  pipeline->SetOpen(true);
+  thread.join();
+  return blocked;
+}
+}
+
+int CPProcessorAsynchronous(int argc, char* argv[])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+  vtkNew<TestPipeline> pipeline;
+  processor->AddPipeline(pipeline);
+  processor->AsynchronousOn();
+  processor->SetMaximumNumberOfPendingSteps(1);
+  Simulation simulation(processor);
+  const std::thread::id mainThreadId = std::this_thread::get_id();
+
+  // CoProcess() returns while the pipeline is executing, and the next time
+  // step waits for it.
+  pipeline->SetOpen(false);
+  expect(simulation.Step(0) == 1, "co-processing time step 0 failed.");
+  pipeline->WaitForStarted(1);
+  expect(pipeline->GetValues().empty(), "CoProcess() waited for the pipeline.");
+  expect(IsBlocked(simulation, pipeline, 1), "CoProcess() did not wait for a pending step.");
+  expect(processor->WaitForPendingSteps() == 1, "pending time steps failed.");
+
+  // With 2 pending steps, one being executed and one queued, the third waits.
+  processor->SetMaximumNumberOfPendingSteps(2);
+  pipeline->SetOpen(false);
+  expect(simulation.Step(2) == 1, "co-processing time step 2 failed.");
+  pipeline->WaitForStarted(3);
+  expect(simulation.Step(3) == 1, "co-processing time step 3 failed.");
+  expect(IsBlocked(simulation, pipeline, 4), "CoProcess() did not wait for 2 pending steps.");
+  expect(processor->WaitForPendingSteps() == 1, "pending time steps failed.");
+
+  // The pipelines get a snapshot of the inputs, in order, on another thread.
+  std::vector<double> values = pipeline->GetValues();
+  expect(values.size() == 5, "expected 5 co-processed time steps, got " << values.size() << ".");
+  for (size_t cc = 0; cc < values.size(); ++cc)
+  {
+    expect(values[cc] == static_cast<double>(cc),
+      "time step " << cc << " was co-processed with " << values[cc] << ".");
+  }
+  for (const std::thread::id& id : pipeline->GetThreadIds())
+  {
+    expect(id != mainThreadId, "a time step was co-processed by the simulation thread.");
+  }
+
+  // Failures of pending time steps are reported once.
+  pipeline->Fail = true;
+  simulation.Step(5);
+  expect(processor->WaitForPendingSteps() == 0, "the failure of a pending step was lost.");
+  expect(processor->WaitForPendingSteps() == 1, "the failure of a pending step was kept.");
+  pipeline->Fail = false;
+
+  // Pipelines that cannot be executed asynchronously are executed by the
+  // simulation thread, before CoProcess() returns.
+  pipeline->Asynchronous = false;
+  expect(simulation.Step(6) == 1, "co-processing time step 6 failed.");
+  values = pipeline->GetValues();
+  expect(values.size() == 7 && values.back() == 6, "time step 6 was not co-processed.");
+  expect(pipeline->GetThreadIds().back() == mainThreadId,
+    "a synchronous pipeline was co-processed by another thread.");
+  processor->Finalize();
+
+  // With a working directory, the pipelines are executed by the simulation
+  // thread in that directory, since changing it from another thread would
+  // change it for the simulation too.
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string workingDirectory = vtksys::SystemTools::CollapseFullPath(
+    std::string(tempDir) + "/CPProcessorAsynchronous");
+  delete[] tempDir;
+  const std::string originalWorkingDirectory = vtksys::SystemTools::GetCurrentWorkingDirectory();
+  {
+    vtkNew<vtkCPProcessor> wdProcessor;
+    wdProcessor->Initialize(workingDirectory.c_str());
+    vtkNew<TestPipeline> wdPipeline;
+    wdProcessor->AddPipeline(wdPipeline);
+    wdProcessor->AsynchronousOn();
+    Simulation wdSimulation(wdProcessor);
+    expect(wdSimulation.Step(0) == 1, "co-processing with a working directory failed.");
+    expect(wdPipeline->GetValues().size() == 1 && wdPipeline->GetThreadIds()[0] == mainThreadId,
+      "a time step was co-processed asynchronously with a working directory.");
+    expect(vtksys::SystemTools::ComparePath(
+             wdPipeline->GetWorkingDirectories()[0], workingDirectory),
+      "a time step was co-processed in " << wdPipeline->GetWorkingDirectories()[0]
+                                         << " instead of " << workingDirectory << ".");
+    expect(vtksys::SystemTools::GetCurrentWorkingDirectory() == originalWorkingDirectory,
+      "the working directory was not restored after co-processing.");
+    wdProcessor->Finalize();
+  }
+  vtksys::SystemTools::RemoveADirectory(workingDirectory);
+
+  return EXIT_SUCCESS;
+}
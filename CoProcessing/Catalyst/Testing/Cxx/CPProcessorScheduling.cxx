@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    CPProcessorScheduling.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkCPProcessor holds back pipelines that exceed their time or
+// output budget, resumes them once their share of the budget covers their
+// cost, and never holds back forced outputs.
+#include "vtkCPDataDescription.h"
+#include "vtkCPPipeline.h"
+#include "vtkCPProcessor.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Executes at every time step, taking Milliseconds and outputting Bytes.
+class TestPipeline : public vtkCPPipeline
+{
+public:
+  static TestPipeline* New();
+  vtkTypeMacro(TestPipeline, vtkCPPipeline);
+
+  int RequestDataDescription(vtkCPDataDescription*) override { return 1; }
+
+  int CoProcess(vtkCPDataDescription* dataDescription) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(this->Milliseconds));
+    this->TimeSteps.push_back(dataDescription->GetTimeStep());
+    return 1;
+  }
+
+  vtkTypeInt64 GetLastOutputSize() override { return this->Bytes; }
+
+  bool ExecutedAt(vtkIdType timeStep) const
+  {
+    for (vtkIdType executed : this->TimeSteps)
+    {
+      if (executed == timeStep)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int Milliseconds = 0;
+  vtkTypeInt64 Bytes = -1;
+  std::vector<vtkIdType> TimeSteps;
+};
+vtkStandardNewMacro(TestPipeline);
+
+// Runs time steps [first, last), each taking at least 10 ms of simulation
+// time. Sleeping may take longer, so the tests only rely on lower bounds.
+void Simulate(vtkCPProcessor* processor, vtkIdType first, vtkIdType last, bool force = false)
+{
+  vtkNew<vtkCPDataDescription> dataDescription;
+  for (vtkIdType step = first; step < last; step++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    dataDescription->SetTimeData(static_cast<double>(step), step);
+    dataDescription->SetForceOutput(force);
+    if (processor->RequestDataDescription(dataDescription))
+    {
+      processor->CoProcess(dataDescription);
+    }
+  }
+}
+}
+
+int CPProcessorScheduling(int, char* [])
+{
+  vtkNew<vtkCPProcessor> processor;
+  processor->Initialize();
+
+  // Without a budget, pipelines execute at every time step.
+  vtkNew<TestPipeline> pipeline;
+  pipeline->Milliseconds = 40;
+  processor->AddPipeline(pipeline);
+  Simulate(processor, 0, 5);
+  expect(pipeline->TimeSteps.size() == 5, "a pipeline was held back without a budget.");
+
+  // With half of the simulation time, i.e. about 5 ms per time step, a 40 ms
+  // pipeline executes the first time, to measure it, and is then held back
+  // for about 8 time steps each time it executes.
+  processor->RemoveAllPipelines();
+  pipeline->TimeSteps.clear();
+  processor->AddPipeline(pipeline);
+  processor->SetMaximumTimeFraction(0.5);
+  Simulate(processor, 0, 30);
+  expect(pipeline->ExecutedAt(0), "an unmeasured pipeline was held back.");
+  expect(!pipeline->ExecutedAt(1), "a pipeline over its time budget was not held back.");
+  expect(pipeline->TimeSteps.size() > 1, "a pipeline was not resumed within its time budget.");
+  for (size_t cc = 1; cc < pipeline->TimeSteps.size(); cc++)
+  {
+    expect(pipeline->TimeSteps[cc] - pipeline->TimeSteps[cc - 1] > 1,
+      "a pipeline executed at time steps " << pipeline->TimeSteps[cc - 1] << " and "
+                                           << pipeline->TimeSteps[cc] << " within its budget.");
+  }
+
+  // Forced outputs are never held back.
+  const size_t numberOfExecutions = pipeline->TimeSteps.size();
+  Simulate(processor, 30, 32, true);
+  expect(pipeline->TimeSteps.size() == numberOfExecutions + 2, "a forced output was held back.");
+
+  // The output budget uses the size the pipeline reports instead of the size
+  // of its inputs, which is 0 here. At 20 MB/s, a pipeline outputting 1 MB
+  // gets about 200 kB per time step so it is held back for about 5 time
+  // steps each time it executes.
+  processor->RemoveAllPipelines();
+  processor->SetMaximumTimeFraction(0.0);
+  processor->SetMaximumOutputRate(2e7);
+  vtkNew<TestPipeline> writer;
+  writer->Bytes = 1000000;
+  processor->AddPipeline(writer);
+  Simulate(processor, 0, 30);
+  expect(writer->ExecutedAt(0), "an unmeasured pipeline was held back.");
+  expect(!writer->ExecutedAt(1), "a pipeline over its output budget was not held back.");
+  expect(writer->TimeSteps.size() > 1, "a pipeline was not resumed within its output budget.");
+  for (size_t cc = 1; cc < writer->TimeSteps.size(); cc++)
+  {
+    expect(writer->TimeSteps[cc] - writer->TimeSteps[cc - 1] > 1,
+      "a pipeline executed at time steps " << writer->TimeSteps[cc - 1] << " and "
+                                           << writer->TimeSteps[cc] << " within its budget.");
+  }
+
+  processor->Finalize();
+  return EXIT_SUCCESS;
+}
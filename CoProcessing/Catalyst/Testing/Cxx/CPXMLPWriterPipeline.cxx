@@ -125,6 +125,7 @@ int CPXMLPWriterPipeline(int argc, char* argv[])
   std::string names[6] = { tempDir + "/ImageData_010.pvti", tempDir + "/MultiBlock_010.vtm",
     tempDir + "/PolyData_010.pvts", tempDir + "/RectilinearGrid_010.pvtr",
     tempDir + "/StructuredGrid_010.pvts", tempDir + "/UnstructuredGrid_010.pvtu" };
+  vtkTypeInt64 summarySize = 0;
   for (auto& name : names)
   {
     if (!vtksys::SystemTools::FileExists(name.c_str()))
@@ -132,6 +133,17 @@ int CPXMLPWriterPipeline(int argc, char* argv[])
       vtkGenericWarningMacro("Did not write out " << name);
       return 1;
     }
+    summarySize += static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(name));
+  }
+
+  // the output size also counts the pieces written next to the summary files
+  // and the blocks of the multiblock dataset.
+  if (pipeline->GetLastOutputSize() <= summarySize)
+  {
+    vtkGenericWarningMacro("Wrong output size " << pipeline->GetLastOutputSize()
+                                                << ", the summary files have " << summarySize
+                                                << " bytes");
+    return 1;
   }
 
   return 0;
@@ -18,19 +18,299 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkGenericDataArray.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Invokes the release callback of a registered field buffer when the last
+// array using the buffer goes away.
+struct vtkCPFieldBufferOwner
+{
+  vtkCPFieldBufferOwner(
+    vtkCPInputDataDescription::FieldBufferReleaseCallback release, void* clientData)
+    : Release(release)
+    , ClientData(clientData)
+  {
+  }
+  ~vtkCPFieldBufferOwner()
+  {
+    if (this->Release)
+    {
+      this->Release(this->ClientData);
+    }
+  }
+
+  vtkCPInputDataDescription::FieldBufferReleaseCallback Release;
+  void* ClientData;
+};
+typedef std::shared_ptr<vtkCPFieldBufferOwner> vtkCPFieldBufferOwnerPointer;
+
+// The owners of the buffers wrapped in vtkAOSDataArrayTemplate and
+// vtkSOADataArrayTemplate arrays, released by vtkCPReleaseFieldBuffer() when
+// these arrays free their memory. The free function of these arrays is only
+// given the buffer, which several arrays may wrap, e.g. when the simulation
+// registers the same buffer again at each time step while the pipelines still
+// use the previous array. So each array wrapping a buffer is counted, and the
+// owners of a buffer are only released once the last of them frees it.
+struct vtkCPFieldBufferRegistry
+{
+  struct Entry
+  {
+    int NumberOfArrays = 0;
+    std::vector<vtkCPFieldBufferOwnerPointer> Owners;
+  };
+  std::mutex Mutex;
+  std::map<void*, Entry> Buffers;
+};
+
+vtkCPFieldBufferRegistry& GetFieldBufferRegistry()
+{
+  // never destroyed so that arrays released at exit can still use it.
+  static vtkCPFieldBufferRegistry* registry = new vtkCPFieldBufferRegistry;
+  return *registry;
+}
+
+// To be called for each array wrapping `buffer`.
+void vtkCPRegisterFieldBuffer(void* buffer, const vtkCPFieldBufferOwnerPointer& owner)
+{
+  vtkCPFieldBufferRegistry& registry = GetFieldBufferRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  auto& entry = registry.Buffers[buffer];
+  ++entry.NumberOfArrays;
+  if (std::find(entry.Owners.begin(), entry.Owners.end(), owner) == entry.Owners.end())
+  {
+    entry.Owners.push_back(owner);
+  }
+}
+
+void vtkCPReleaseFieldBuffer(void* buffer)
+{
+  std::vector<vtkCPFieldBufferOwnerPointer> owners;
+  vtkCPFieldBufferRegistry& registry = GetFieldBufferRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto iter = registry.Buffers.find(buffer);
+    if (iter != registry.Buffers.end() && --iter->second.NumberOfArrays == 0)
+    {
+      owners.swap(iter->second.Owners);
+      registry.Buffers.erase(iter);
+    }
+  }
+  // the release callbacks, if any, run here outside of the lock.
+}
+
+//----------------------------------------------------------------------------
+// Read/write view on a simulation buffer where component c of tuple i is at
+// index i * TupleStride + c * ComponentStride. The array cannot grow past
+// the size of the buffer. Instances that do not wrap a buffer, e.g. made by
+// NewInstance() for a deep copy, store their values as an array of structures.
+template <class ValueTypeT>
+class vtkCPStridedDataArray
+  : public vtkGenericDataArray<vtkCPStridedDataArray<ValueTypeT>, ValueTypeT>
+{
+  typedef vtkGenericDataArray<vtkCPStridedDataArray<ValueTypeT>, ValueTypeT> GenericDataArrayType;
+
+public:
+  typedef vtkCPStridedDataArray<ValueTypeT> SelfType;
+  vtkTemplateTypeMacro(SelfType, GenericDataArrayType);
+  typedef typename Superclass::ValueType ValueType;
+
+  static vtkCPStridedDataArray* New() { VTK_STANDARD_NEW_BODY(vtkCPStridedDataArray); }
+
+  void SetBuffer(ValueType* buffer, vtkIdType numberOfTuples, int numberOfComponents,
+    vtkIdType tupleStride, vtkIdType componentStride, const vtkCPFieldBufferOwnerPointer& owner)
+  {
+    std::vector<ValueType>().swap(this->Storage);
+    std::vector<ValueType>().swap(this->AOSCopy);
+    this->Buffer = buffer;
+    this->NumberOfBufferTuples = numberOfTuples;
+    this->TupleStride = tupleStride;
+    this->ComponentStride = componentStride;
+    this->Owner = owner;
+    this->SetNumberOfComponents(numberOfComponents);
+    this->SetNumberOfTuples(numberOfTuples);
+    this->Modified();
+  }
+
+  ValueType GetValue(vtkIdType valueIdx) const
+  {
+    const vtkIdType numComps = this->NumberOfComponents;
+    return this->GetTypedComponent(valueIdx / numComps, static_cast<int>(valueIdx % numComps));
+  }
+
+  void SetValue(vtkIdType valueIdx, ValueType value)
+  {
+    const vtkIdType numComps = this->NumberOfComponents;
+    this->SetTypedComponent(valueIdx / numComps, static_cast<int>(valueIdx % numComps), value);
+  }
+
+  void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      tuple[cc] = this->GetTypedComponent(tupleIdx, cc);
+    }
+  }
+
+  void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple)
+  {
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      this->SetTypedComponent(tupleIdx, cc, tuple[cc]);
+    }
+  }
+
+  ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->Buffer[tupleIdx * this->TupleStride + comp * this->ComponentStride];
+  }
+
+  void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value)
+  {
+    this->Buffer[tupleIdx * this->TupleStride + comp * this->ComponentStride] = value;
+  }
+
+  // Instances with their own storage return it directly. Views on a buffer,
+  // like vtkSOADataArrayTemplate, return a copy of the values in array of
+  // structures order, which is only made again after a call to Modified() or
+  // SetBuffer(). Changes made through the pointer to that copy are not kept.
+  void* GetVoidPointer(vtkIdType valueIdx) override
+  {
+    if (!this->Owner)
+    {
+      return this->Buffer + valueIdx;
+    }
+    const vtkIdType numValues = this->GetNumberOfValues();
+    if (this->AOSCopyTime.GetMTime() < this->GetMTime() ||
+      static_cast<vtkIdType>(this->AOSCopy.size()) != numValues)
+    {
+      this->AOSCopy.resize(static_cast<size_t>(numValues));
+      for (vtkIdType cc = 0; cc < numValues; ++cc)
+      {
+        this->AOSCopy[cc] = this->GetValue(cc);
+      }
+      this->AOSCopyTime.Modified();
+    }
+    return this->AOSCopy.data() + valueIdx;
+  }
+
+  // The buffer is released through its vtkCPFieldBufferOwner.
+  void SetArrayFreeFunction(void (*)(void*)) override {}
+
+protected:
+  vtkCPStridedDataArray()
+    : Buffer(nullptr)
+    , NumberOfBufferTuples(0)
+    , TupleStride(0)
+    , ComponentStride(0)
+  {
+  }
+  ~vtkCPStridedDataArray() override {}
+
+  bool AllocateTuples(vtkIdType numTuples) { return this->ReallocateTuples(numTuples); }
+  bool ReallocateTuples(vtkIdType numTuples)
+  {
+    if (this->Owner)
+    {
+      return numTuples <= this->NumberOfBufferTuples;
+    }
+    this->Storage.resize(static_cast<size_t>(numTuples * this->NumberOfComponents));
+    this->Buffer = this->Storage.data();
+    this->NumberOfBufferTuples = numTuples;
+    this->TupleStride = this->NumberOfComponents;
+    this->ComponentStride = 1;
+    return true;
+  }
+
+private:
+  vtkCPStridedDataArray(const vtkCPStridedDataArray&) = delete;
+  void operator=(const vtkCPStridedDataArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkCPStridedDataArray<ValueTypeT>, ValueTypeT>;
+
+  ValueType* Buffer;
+  vtkIdType NumberOfBufferTuples;
+  vtkIdType TupleStride;
+  vtkIdType ComponentStride;
+  std::vector<ValueType> Storage;
+  std::vector<ValueType> AOSCopy;
+  vtkTimeStamp AOSCopyTime;
+  vtkCPFieldBufferOwnerPointer Owner;
+};
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkDataArray* NewStridedArray(T* buffer, vtkIdType numberOfTuples, int numberOfComponents,
+  vtkIdType tupleStride, vtkIdType componentStride, const vtkCPFieldBufferOwnerPointer& owner)
+{
+  vtkCPStridedDataArray<T>* array = vtkCPStridedDataArray<T>::New();
+  array->SetBuffer(
+    buffer, numberOfTuples, numberOfComponents, tupleStride, componentStride, owner);
+  return array;
+}
+
+//----------------------------------------------------------------------------
+template <class T>
+vtkDataArray* NewSOAArray(T** buffers, vtkIdType numberOfTuples, int numberOfComponents,
+  const vtkCPFieldBufferOwnerPointer& owner)
+{
+  vtkSOADataArrayTemplate<T>* array = vtkSOADataArrayTemplate<T>::New();
+  array->SetNumberOfComponents(numberOfComponents);
+  if (numberOfTuples > 0)
+  {
+    for (int cc = 0; cc < numberOfComponents; ++cc)
+    {
+      vtkCPRegisterFieldBuffer(buffers[cc], owner);
+      array->SetArray(cc, buffers[cc], numberOfTuples, /*updateMaxId=*/true, /*save=*/false,
+        vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+    }
+    array->SetArrayFreeFunction(vtkCPReleaseFieldBuffer);
+  }
+  return array;
+}
+
+//----------------------------------------------------------------------------
+vtkFieldData* GetFieldData(vtkDataObject* grid, int type)
+{
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(grid);
+  switch (type)
+  {
+    case vtkDataObject::POINT:
+      return dataSet ? dataSet->GetPointData() : nullptr;
+    case vtkDataObject::CELL:
+      return dataSet ? dataSet->GetCellData() : nullptr;
+    case vtkDataObject::FIELD:
+      return grid ? grid->GetFieldData() : nullptr;
+    default:
+      return nullptr;
+  }
+}
+}
+
 class vtkCPInputDataDescription::vtkInternals
 {
 public:
   typedef std::vector<std::string> FieldType;
   std::map<int, FieldType> Fields;
+
+  // Arrays wrapping the registered buffers, by field type and name.
+  typedef std::pair<int, std::string> FieldBufferKey;
+  std::map<FieldBufferKey, vtkSmartPointer<vtkDataArray> > FieldBuffers;
 };
 
 vtkStandardNewMacro(vtkCPInputDataDescription);
@@ -161,6 +441,154 @@ bool vtkCPInputDataDescription::GetIfGridIsNecessary()
   return (this->AllFields || this->GetNumberOfFields() > 0 || this->GenerateMesh);
 }
 
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::AddFieldBuffer(const char* fieldName, int type, int dataType,
+  void* buffer, vtkIdType numberOfTuples, int numberOfComponents, vtkIdType tupleStride,
+  vtkIdType componentStride, FieldBufferReleaseCallback release, void* clientData)
+{
+  if (!fieldName || numberOfComponents < 1 || numberOfTuples < 0 ||
+    (!buffer && numberOfTuples > 0))
+  {
+    vtkErrorMacro("Invalid buffer for field " << (fieldName ? fieldName : "(null)"));
+    return;
+  }
+  if (tupleStride == 0)
+  {
+    tupleStride = numberOfComponents;
+  }
+
+  auto owner = std::make_shared<vtkCPFieldBufferOwner>(release, clientData);
+  vtkSmartPointer<vtkDataArray> array;
+  if (tupleStride == numberOfComponents && componentStride == 1)
+  {
+    // array of structures, wrapped in the regular array for that type.
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+    if (array)
+    {
+      array->SetNumberOfComponents(numberOfComponents);
+      if (numberOfTuples > 0)
+      {
+        vtkCPRegisterFieldBuffer(buffer, owner);
+        array->SetVoidArray(buffer, numberOfTuples * numberOfComponents, 0,
+          vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+        array->SetArrayFreeFunction(vtkCPReleaseFieldBuffer);
+      }
+    }
+  }
+  else
+  {
+    switch (dataType)
+    {
+      vtkTemplateMacro(array.TakeReference(NewStridedArray(static_cast<VTK_TT*>(buffer),
+        numberOfTuples, numberOfComponents, tupleStride, componentStride, owner)));
+    }
+  }
+  if (!array)
+  {
+    vtkErrorMacro("Unsupported data type " << dataType << " for field " << fieldName);
+    return;
+  }
+  array->SetName(fieldName);
+  this->Internals->FieldBuffers[std::make_pair(type, std::string(fieldName))] = array;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::AddSOAFieldBuffer(const char* fieldName, int type, int dataType,
+  void** componentBuffers, vtkIdType numberOfTuples, int numberOfComponents,
+  FieldBufferReleaseCallback release, void* clientData)
+{
+  if (!fieldName || numberOfComponents < 1 || numberOfTuples < 0 ||
+    (!componentBuffers && numberOfTuples > 0))
+  {
+    vtkErrorMacro("Invalid buffers for field " << (fieldName ? fieldName : "(null)"));
+    return;
+  }
+
+  auto owner = std::make_shared<vtkCPFieldBufferOwner>(release, clientData);
+  vtkSmartPointer<vtkDataArray> array;
+  switch (dataType)
+  {
+    vtkTemplateMacro(array.TakeReference(NewSOAArray(reinterpret_cast<VTK_TT**>(componentBuffers),
+      numberOfTuples, numberOfComponents, owner)));
+  }
+  if (!array)
+  {
+    vtkErrorMacro("Unsupported data type " << dataType << " for field " << fieldName);
+    return;
+  }
+  array->SetName(fieldName);
+  this->Internals->FieldBuffers[std::make_pair(type, std::string(fieldName))] = array;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::RemoveFieldBuffer(const char* fieldName, int type)
+{
+  if (!fieldName)
+  {
+    return;
+  }
+  auto iter = this->Internals->FieldBuffers.find(std::make_pair(type, std::string(fieldName)));
+  if (iter == this->Internals->FieldBuffers.end())
+  {
+    return;
+  }
+  vtkFieldData* fd = GetFieldData(this->Grid, type);
+  if (fd && fd->GetAbstractArray(fieldName) == iter->second)
+  {
+    fd->RemoveArray(fieldName);
+  }
+  this->Internals->FieldBuffers.erase(iter);
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::RemoveAllFieldBuffers()
+{
+  while (!this->Internals->FieldBuffers.empty())
+  {
+    const auto key = this->Internals->FieldBuffers.begin()->first;
+    this->RemoveFieldBuffer(key.second.c_str(), key.first);
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned int vtkCPInputDataDescription::GetNumberOfFieldBuffers()
+{
+  return static_cast<unsigned int>(this->Internals->FieldBuffers.size());
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray* vtkCPInputDataDescription::GetFieldBufferArray(const char* fieldName, int type)
+{
+  if (!fieldName)
+  {
+    return nullptr;
+  }
+  auto iter = this->Internals->FieldBuffers.find(std::make_pair(type, std::string(fieldName)));
+  return iter != this->Internals->FieldBuffers.end() ? iter->second.GetPointer() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPInputDataDescription::AttachFieldBuffers()
+{
+  if (!this->Grid)
+  {
+    return;
+  }
+  for (auto& iter : this->Internals->FieldBuffers)
+  {
+    vtkFieldData* fd = GetFieldData(this->Grid, iter.first.first);
+    if (!fd)
+    {
+      vtkWarningMacro("Cannot attach the buffer of field " << iter.first.second << " to a "
+                                                           << this->Grid->GetClassName());
+      continue;
+    }
+    // the simulation writes to the buffer directly.
+    iter.second->Modified();
+    fd->AddArray(iter.second);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkCPInputDataDescription::ShallowCopy(vtkCPInputDataDescription* idd)
 {
@@ -173,6 +601,7 @@ void vtkCPInputDataDescription::ShallowCopy(vtkCPInputDataDescription* idd)
   this->SetGrid(idd->Grid);
   memcpy(this->WholeExtent, idd->WholeExtent, 6 * sizeof(int));
   this->Internals->Fields = idd->Internals->Fields;
+  this->Internals->FieldBuffers = idd->Internals->FieldBuffers;
 }
 
 //----------------------------------------------------------------------------
@@ -189,6 +618,7 @@ void vtkCPInputDataDescription::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Grid: (NULL)\n";
   }
+  os << indent << "NumberOfFieldBuffers: " << this->Internals->FieldBuffers.size() << "\n";
   os << indent << "WholeExtent: " << this->WholeExtent[0] << " " << this->WholeExtent[1] << " "
      << this->WholeExtent[2] << " " << this->WholeExtent[3] << " " << this->WholeExtent[4] << " "
      << this->WholeExtent[5] << "\n";
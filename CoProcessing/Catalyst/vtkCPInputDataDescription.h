@@ -15,6 +15,7 @@
 #ifndef vtkCPInputDataDescription_h
 #define vtkCPInputDataDescription_h
 
+class vtkDataArray;
 class vtkDataObject;
 class vtkDataSet;
 class vtkFieldData;
@@ -93,6 +94,62 @@ public:
   vtkSetVector6Macro(WholeExtent, int);
   vtkGetVector6Macro(WholeExtent, int);
 
+  // Description:
+  // Callback invoked with the *clientData* given when registering a field
+  // buffer once Catalyst, including any VTK array wrapping it, no longer
+  // references that buffer. When the same buffer is registered again, e.g.
+  // at each time step, while the arrays of earlier registrations are still
+  // used, the callbacks of all these registrations run once the last of these
+  // arrays is released.
+  typedef void (*FieldBufferReleaseCallback)(void* clientData);
+
+  // Description:
+  // Register a simulation-owned buffer for the field *fieldName* of
+  // association *type* (vtkDataObject::POINT, CELL or FIELD). The buffer
+  // holds *numberOfTuples* tuples of *numberOfComponents* values of
+  // *dataType* (VTK_DOUBLE, VTK_FLOAT, ...), component c of tuple i being at
+  // index i * tupleStride + c * componentStride. The default strides are those
+  // of an array of structures. The buffer is wrapped, without copying it, in a
+  // vtkDataArray that is added to the grid on each call to
+  // vtkCPProcessor::CoProcess(), so the simulation only needs to register it
+  // again if the buffer moves or changes size. Registering a buffer for the
+  // same field replaces the previous one. Unlike the requested fields, buffers
+  // are not cleared by Reset(). Buffers holding each component contiguously
+  // are better registered with AddSOAFieldBuffer(), which VTK reads faster.
+  void AddFieldBuffer(const char* fieldName, int type, int dataType, void* buffer,
+    vtkIdType numberOfTuples, int numberOfComponents, vtkIdType tupleStride = 0,
+    vtkIdType componentStride = 1, FieldBufferReleaseCallback release = nullptr,
+    void* clientData = nullptr);
+
+  // Description:
+  // Same as AddFieldBuffer() for a structure of arrays where each component
+  // is stored in its own buffer, *componentBuffers* being
+  // *numberOfComponents* pointers to *numberOfTuples* values.
+  void AddSOAFieldBuffer(const char* fieldName, int type, int dataType, void** componentBuffers,
+    vtkIdType numberOfTuples, int numberOfComponents, FieldBufferReleaseCallback release = nullptr,
+    void* clientData = nullptr);
+
+  // Description:
+  // Unregister the buffer of a field. Its release callback is invoked once
+  // the grid no longer uses the array wrapping it.
+  void RemoveFieldBuffer(const char* fieldName, int type);
+  void RemoveAllFieldBuffers();
+
+  // Description:
+  // Get the number of registered field buffers.
+  unsigned int GetNumberOfFieldBuffers();
+
+  // Description:
+  // Get the array wrapping the buffer registered for a field, or NULL.
+  vtkDataArray* GetFieldBufferArray(const char* fieldName, int type);
+
+  // Description:
+  // Add the arrays wrapping the registered buffers to the grid and mark them
+  // as modified since the simulation updates the buffers in place. Point and
+  // cell buffers require the grid to be a vtkDataSet. This is called by
+  // vtkCPProcessor::CoProcess().
+  void AttachFieldBuffers();
+
   // Description:
   // Shallow copy.
   void ShallowCopy(vtkCPInputDataDescription*);
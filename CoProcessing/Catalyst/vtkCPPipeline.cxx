@@ -30,6 +30,18 @@ int vtkCPPipeline::Finalize()
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkCPPipeline::GetLastOutputSize()
+{
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCPPipeline::CanCoProcessAsynchronously()
+{
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void vtkCPPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
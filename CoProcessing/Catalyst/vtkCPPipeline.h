@@ -48,6 +48,20 @@ public:
   /// is given. Returns 1 for success and 0 for failure.
   virtual int Finalize();
 
+  /// Return the number of bytes output by the last CoProcess() call, or -1
+  /// when unknown, the default. vtkCPProcessor uses it to keep pipelines
+  /// within an I/O budget, estimating it with the size of the inputs of the
+  /// pipeline when unknown.
+  virtual vtkTypeInt64 GetLastOutputSize();
+
+  /// Return whether CoProcess() may be called from another thread than the
+  /// one of the simulation while RequestDataDescription() is called for a
+  /// later time step. vtkCPProcessor executes all the pipelines synchronously
+  /// when one of them returns false. Returns false by default, since most
+  /// pipelines keep state shared by both calls, e.g. the coprocessor object of
+  /// Python scripts. Subclasses override it once they are checked to be safe.
+  virtual bool CanCoProcessAsynchronously();
+
 protected:
   vtkCPPipeline();
   virtual ~vtkCPPipeline();
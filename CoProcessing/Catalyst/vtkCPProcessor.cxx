@@ -20,7 +20,11 @@
 #include "vtkCPDataDescription.h"
 #include "vtkCPInputDataDescription.h"
 #include "vtkCPPipeline.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
+#include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
@@ -31,7 +35,11 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPassArrays.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSMIntVectorProperty.h"
 #include "vtkSMProxy.h"
 #include "vtkSMProxyManager.h"
@@ -39,14 +47,252 @@
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Returns a copy of grid that stays valid while the simulation goes on. The
+// point coordinates and the data arrays, which simulations update in place
+// or wrap without copying, are deep copied while the rest is shared.
+vtkSmartPointer<vtkDataObject> SnapshotGrid(vtkDataObject* grid)
+{
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(grid->NewInstance());
+  if (vtkCompositeDataSet* composite = vtkCompositeDataSet::SafeDownCast(grid))
+  {
+    vtkCompositeDataSet* compositeSnapshot = vtkCompositeDataSet::SafeDownCast(snapshot);
+    compositeSnapshot->CopyStructure(composite);
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      compositeSnapshot->SetDataSet(iter, SnapshotGrid(iter->GetCurrentDataObject()));
+    }
+    compositeSnapshot->GetFieldData()->DeepCopy(composite->GetFieldData());
+    return snapshot;
+  }
+
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(grid);
+  if (!dataSet)
+  {
+    snapshot->DeepCopy(grid);
+    return snapshot;
+  }
+  vtkDataSet* dataSetSnapshot = vtkDataSet::SafeDownCast(snapshot);
+  dataSetSnapshot->ShallowCopy(dataSet);
+  dataSetSnapshot->GetPointData()->DeepCopy(dataSet->GetPointData());
+  dataSetSnapshot->GetCellData()->DeepCopy(dataSet->GetCellData());
+  dataSetSnapshot->GetFieldData()->DeepCopy(dataSet->GetFieldData());
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataSet);
+  if (pointSet && pointSet->GetPoints())
+  {
+    vtkNew<vtkPoints> points;
+    points->DeepCopy(pointSet->GetPoints());
+    vtkPointSet::SafeDownCast(dataSetSnapshot)->SetPoints(points);
+  }
+  return snapshot;
+}
+
+//----------------------------------------------------------------------------
+// The pipelines to execute for a time step, each with its data description.
+typedef std::vector<std::pair<vtkSmartPointer<vtkCPPipeline>,
+  vtkSmartPointer<vtkCPDataDescription> > >
+  vtkCPProcessorStep;
+}
+
 struct vtkCPProcessorInternals
 {
   typedef std::list<vtkSmartPointer<vtkCPPipeline> > PipelineList;
   typedef PipelineList::iterator PipelineListIterator;
   PipelineList Pipelines;
+
+  // Asynchronous execution. NumberOfPendingSteps counts the steps queued in
+  // PendingSteps and the one being executed by the helper thread.
+  std::thread HelperThread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<vtkCPProcessorStep> PendingSteps;
+  int NumberOfPendingSteps = 0;
+  bool StopHelperThread = false;
+  bool PendingStepFailed = false;
+  bool HelperThreadUnavailable = false;
+  bool SynchronousExecutionWarned = false;
+  vtkSmartPointer<vtkMultiProcessController> SimulationController;
+  vtkSmartPointer<vtkMultiProcessController> HelperController;
+
+  // The global controller is the one of the pipelines while the helper
+  // thread runs, so collective operations made for the simulation use the
+  // controller it had before.
+  vtkMultiProcessController* GetSimulationController() const
+  {
+    return this->SimulationController ? this->SimulationController.GetPointer()
+                                      : vtkMultiProcessController::GetGlobalController();
+  }
+
+  // Adaptive scheduling. Executions are recorded by the helper thread when
+  // executing asynchronously, hence ScheduleMutex.
+  struct PipelineSchedule
+  {
+    double Time = -1.0; // estimated execution time in seconds, -1 until measured.
+    double Bytes = 0.0; // estimated output size in bytes.
+    double TimeCredit = 0.0;
+    double BytesCredit = 0.0;
+    int HeldBackSteps = 0;
+  };
+  std::mutex ScheduleMutex;
+  std::map<vtkCPPipeline*, PipelineSchedule> Schedules;
+  std::vector<int> Eligible; // by pipeline, for DecisionTimeStep.
+  bool HasDecision = false;
+  vtkIdType DecisionTimeStep = 0;
+  double SimulationTime = 0.0; // since the last decision, in seconds.
+  std::chrono::steady_clock::time_point LastExit;
+  bool HasLastExit = false;
+
+  // The time spent between calls to the processor is simulation time.
+  class ProcessorCall
+  {
+  public:
+    ProcessorCall(vtkCPProcessorInternals* internals)
+      : Internals(internals)
+    {
+      if (internals->HasLastExit)
+      {
+        internals->SimulationTime +=
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - internals->LastExit)
+            .count();
+      }
+    }
+    ~ProcessorCall()
+    {
+      this->Internals->LastExit = std::chrono::steady_clock::now();
+      this->Internals->HasLastExit = true;
+    }
+
+  private:
+    vtkCPProcessorInternals* Internals;
+  };
+
+  bool IsEligible(size_t index) const
+  {
+    return index >= this->Eligible.size() || this->Eligible[index] != 0;
+  }
+
+  // Updates the estimated cost of a pipeline after it executed and charges
+  // it to its budget.
+  void RecordExecution(
+    vtkCPPipeline* pipeline, double seconds, vtkCPDataDescription* dataDescription)
+  {
+    vtkTypeInt64 bytes = pipeline->GetLastOutputSize();
+    if (bytes < 0)
+    {
+      bytes = 0;
+      for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+      {
+        if (vtkDataObject* input = dataDescription->GetInputDescription(i)->GetGrid())
+        {
+          bytes += static_cast<vtkTypeInt64>(input->GetActualMemorySize()) * 1024;
+        }
+      }
+    }
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "%s executed in %g s, output %lld bytes",
+      pipeline->GetClassName(), seconds, static_cast<long long>(bytes));
+
+    std::lock_guard<std::mutex> lock(this->ScheduleMutex);
+    PipelineSchedule& schedule = this->Schedules[pipeline];
+    if (schedule.Time < 0)
+    {
+      schedule.Time = seconds;
+      schedule.Bytes = static_cast<double>(bytes);
+      return;
+    }
+    // exponential moving averages, for costs that change with the simulation.
+    schedule.Time = 0.5 * (schedule.Time + seconds);
+    schedule.Bytes = 0.5 * (schedule.Bytes + static_cast<double>(bytes));
+    schedule.TimeCredit -= seconds;
+    schedule.BytesCredit -= static_cast<double>(bytes);
+  }
+
+  // Executes the pipelines of a step. Returns 0 if any of them fails.
+  int ExecuteStep(const vtkCPProcessorStep& step)
+  {
+    int success = 1;
+    for (const auto& job : step)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      if (!job.first->CoProcess(job.second))
+      {
+        success = 0;
+      }
+      const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+      this->RecordExecution(job.first, seconds.count(), job.second);
+    }
+    return success;
+  }
+
+  // Body of the helper thread.
+  void ExecutePendingSteps()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    for (;;)
+    {
+      this->Condition.wait(
+        lock, [this]() { return this->StopHelperThread || !this->PendingSteps.empty(); });
+      if (this->PendingSteps.empty())
+      {
+        return;
+      }
+      vtkCPProcessorStep step = std::move(this->PendingSteps.front());
+      this->PendingSteps.pop_front();
+      lock.unlock();
+      const int success = this->ExecuteStep(step);
+      // release the snapshots before letting the simulation go on.
+      step.clear();
+      lock.lock();
+      this->PendingStepFailed = this->PendingStepFailed || !success;
+      this->NumberOfPendingSteps--;
+      this->Condition.notify_all();
+    }
+  }
+
+  // Queues a step once there are less than maximum pending steps. Returns 0
+  // if an earlier step failed.
+  int QueueStep(vtkCPProcessorStep&& step, int maximum)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [&]() { return this->NumberOfPendingSteps < maximum; });
+    this->PendingSteps.push_back(std::move(step));
+    this->NumberOfPendingSteps++;
+    this->Condition.notify_all();
+    return this->TakeFailure();
+  }
+
+  // Waits for all pending steps. Returns 0 if an earlier step failed.
+  int Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return this->NumberOfPendingSteps == 0; });
+    return this->TakeFailure();
+  }
+
+private:
+  int TakeFailure()
+  {
+    const bool failed = this->PendingStepFailed;
+    this->PendingStepFailed = false;
+    return failed ? 0 : 1;
+  }
 };
 
 vtkStandardNewMacro(vtkCPProcessor);
@@ -57,6 +303,10 @@ vtkCPProcessor::vtkCPProcessor()
   this->Internal = new vtkCPProcessorInternals;
   this->InitializationHelper = nullptr;
   this->WorkingDirectory = nullptr;
+  this->Asynchronous = false;
+  this->MaximumNumberOfPendingSteps = 1;
+  this->MaximumTimeFraction = 0.0;
+  this->MaximumOutputRate = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -64,6 +314,7 @@ vtkCPProcessor::~vtkCPProcessor()
 {
   if (this->Internal)
   {
+    this->StopHelperThread();
     delete this->Internal;
     this->Internal = nullptr;
   }
@@ -120,12 +371,16 @@ vtkCPPipeline* vtkCPProcessor::GetPipeline(int which)
 void vtkCPProcessor::RemovePipeline(vtkCPPipeline* pipeline)
 {
   this->Internal->Pipelines.remove(pipeline);
+  std::lock_guard<std::mutex> lock(this->Internal->ScheduleMutex);
+  this->Internal->Schedules.erase(pipeline);
 }
 
 //----------------------------------------------------------------------------
 void vtkCPProcessor::RemoveAllPipelines()
 {
   this->Internal->Pipelines.clear();
+  std::lock_guard<std::mutex> lock(this->Internal->ScheduleMutex);
+  this->Internal->Schedules.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -144,7 +399,7 @@ int vtkCPProcessor::Initialize(const char* workingDirectory)
   // make sure the directory exists here so that we only do it once
   if (workingDirectory)
   {
-    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    vtkMultiProcessController* controller = this->Internal->GetSimulationController();
     int success = 1;
     if (controller == nullptr || controller->GetLocalProcessId() == 0)
     {
@@ -203,6 +458,8 @@ int vtkCPProcessor::RequestDataDescription(vtkCPDataDescription* dataDescription
     vtkWarningMacro("DataDescription is NULL.");
     return 0;
   }
+  vtkCPProcessorInternals::ProcessorCall call(this->Internal);
+  this->SchedulePipelines(dataDescription);
 
   // first set all inputs to be off and set to on as needed.
   // we don't use vtkCPInputDataDescription::Reset() because
@@ -215,10 +472,12 @@ int vtkCPProcessor::RequestDataDescription(vtkCPDataDescription* dataDescription
 
   dataDescription->ResetInputDescriptions();
   int doCoProcessing = 0;
+  size_t index = 0;
   for (vtkCPProcessorInternals::PipelineListIterator iter = this->Internal->Pipelines.begin();
-       iter != this->Internal->Pipelines.end(); iter++)
+       iter != this->Internal->Pipelines.end(); iter++, index++)
   {
-    if (iter->GetPointer()->RequestDataDescription(dataDescription))
+    if (this->Internal->IsEligible(index) &&
+      iter->GetPointer()->RequestDataDescription(dataDescription))
     {
       doCoProcessing = 1;
     }
@@ -234,6 +493,8 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     vtkWarningMacro("DataDescription is NULL.");
     return 0;
   }
+  vtkCPProcessorInternals::ProcessorCall call(this->Internal);
+  this->SchedulePipelines(dataDescription);
   int success = 1;
   // We need to add in information like channel name and time value here to the
   // field data. The channel name is used to automatically keep track of which
@@ -244,6 +505,9 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
   // files they'll get failures.
   for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
   {
+    // Arrays wrapping the simulation buffers registered with the input
+    // description are added to its grid without copying them.
+    dataDescription->GetInputDescription(i)->AttachFieldBuffers();
     if (vtkDataObject* input = dataDescription->GetInputDescription(i)->GetGrid())
     {
       vtkNew<vtkStringArray> catalystChannel;
@@ -259,34 +523,59 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
     }
   }
 
+  // When executing asynchronously, the pipelines get a snapshot of the inputs
+  // and are executed later by the helper thread.
+  const bool asynchronous = this->Asynchronous && this->StartHelperThread();
+  if (!asynchronous)
+  {
+    this->StopHelperThread();
+  }
+  vtkSmartPointer<vtkCPDataDescription> stepDescription = dataDescription;
+  if (asynchronous)
+  {
+    stepDescription = vtkSmartPointer<vtkCPDataDescription>::New();
+    stepDescription->Copy(dataDescription);
+    for (unsigned int i = 0; i < stepDescription->GetNumberOfInputDescriptions(); i++)
+    {
+      vtkCPInputDataDescription* idd = stepDescription->GetInputDescription(i);
+      if (vtkDataObject* input = idd->GetGrid())
+      {
+        idd->SetGrid(SnapshotGrid(input));
+      }
+    }
+  }
+  vtkCPProcessorStep step;
+
   std::string originalWorkingDirectory;
   if (this->WorkingDirectory)
   {
     originalWorkingDirectory = vtksys::SystemTools::GetCurrentWorkingDirectory();
     vtksys::SystemTools::ChangeDirectory(this->WorkingDirectory);
   }
+  size_t index = 0;
   for (vtkCPProcessorInternals::PipelineListIterator iter = this->Internal->Pipelines.begin();
-       iter != this->Internal->Pipelines.end(); iter++)
+       iter != this->Internal->Pipelines.end(); iter++, index++)
   {
     // Reset dataDescription so that we can check each pipeline again
     // before calling CoProcess to make sure which pipelines should
     // be executing.
-    for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+    for (unsigned int i = 0; i < stepDescription->GetNumberOfInputDescriptions(); i++)
     {
-      dataDescription->GetInputDescription(i)->Reset();
+      stepDescription->GetInputDescription(i)->Reset();
     }
-    if (iter->GetPointer()->RequestDataDescription(dataDescription))
+    if (this->Internal->IsEligible(index) &&
+      iter->GetPointer()->RequestDataDescription(stepDescription))
     {
       // now we need to filter out arrays that are not needed by this pipeline
       // but were requested by other pipelines at this time step
-      vtkSmartPointer<vtkCPDataDescription> dataDescriptionCopy = dataDescription;
+      vtkSmartPointer<vtkCPDataDescription> dataDescriptionCopy = stepDescription;
       if (this->Internal->Pipelines.size() > 1)
       {
         // if there's only one pipeline we don't have to worry about getting
         // more arrays than we requesting arrays
         dataDescriptionCopy = vtkSmartPointer<vtkCPDataDescription>::New();
-        dataDescriptionCopy->Copy(dataDescription);
-        for (unsigned int i = 0; i < dataDescription->GetNumberOfInputDescriptions(); i++)
+        dataDescriptionCopy->Copy(stepDescription);
+        for (unsigned int i = 0; i < stepDescription->GetNumberOfInputDescriptions(); i++)
         {
           vtkCPInputDataDescription* idd = dataDescriptionCopy->GetInputDescription(i);
           if (idd->GetIfGridIsNecessary() == true && idd->GetAllFields() == false)
@@ -307,9 +596,19 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
           }
         }
       }
-      if (!iter->GetPointer()->CoProcess(dataDescriptionCopy))
+      if (asynchronous)
       {
-        success = 0;
+        step.push_back(std::make_pair(*iter, dataDescriptionCopy));
+      }
+      else
+      {
+        const auto start = std::chrono::steady_clock::now();
+        if (!iter->GetPointer()->CoProcess(dataDescriptionCopy))
+        {
+          success = 0;
+        }
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        this->Internal->RecordExecution(*iter, seconds.count(), dataDescriptionCopy);
       }
     }
   }
@@ -317,15 +616,230 @@ int vtkCPProcessor::CoProcess(vtkCPDataDescription* dataDescription)
   {
     vtksys::SystemTools::ChangeDirectory(originalWorkingDirectory);
   }
+  if (asynchronous && !step.empty())
+  {
+    success = this->Internal->QueueStep(std::move(step), this->MaximumNumberOfPendingSteps);
+  }
   // we want to reset everything here to make sure that new information
   // is properly passed in the next time.
   dataDescription->ResetAll();
+  this->Internal->HasDecision = false;
   return success;
 }
 
+//----------------------------------------------------------------------------
+void vtkCPProcessor::SchedulePipelines(vtkCPDataDescription* dataDescription)
+{
+  vtkCPProcessorInternals* internals = this->Internal;
+  if (internals->HasDecision && internals->DecisionTimeStep == dataDescription->GetTimeStep())
+  {
+    return;
+  }
+  internals->HasDecision = true;
+  internals->DecisionTimeStep = dataDescription->GetTimeStep();
+  const double simulationTime = internals->SimulationTime;
+  internals->SimulationTime = 0.0;
+  internals->Eligible.clear();
+  if ((this->MaximumTimeFraction <= 0.0 && this->MaximumOutputRate <= 0.0) ||
+    internals->Pipelines.empty())
+  {
+    return;
+  }
+
+  // Each pipeline accumulates its share of the budget, up to what it needs
+  // to execute, and executes once it has enough.
+  const double share = 1.0 / internals->Pipelines.size();
+  std::vector<vtkCPProcessorInternals::PipelineSchedule> schedules;
+  {
+    std::lock_guard<std::mutex> lock(internals->ScheduleMutex);
+    for (const auto& pipeline : internals->Pipelines)
+    {
+      vtkCPProcessorInternals::PipelineSchedule& schedule = internals->Schedules[pipeline];
+      if (schedule.Time >= 0)
+      {
+        schedule.TimeCredit = std::min(schedule.Time,
+          schedule.TimeCredit + this->MaximumTimeFraction * share * simulationTime);
+        schedule.BytesCredit = std::min(schedule.Bytes,
+          schedule.BytesCredit + this->MaximumOutputRate * share * simulationTime);
+      }
+      schedules.push_back(schedule);
+    }
+  }
+  for (const auto& schedule : schedules)
+  {
+    const bool measured = schedule.Time >= 0;
+    const bool withinTime =
+      this->MaximumTimeFraction <= 0.0 || schedule.TimeCredit >= schedule.Time;
+    const bool withinOutput =
+      this->MaximumOutputRate <= 0.0 || schedule.BytesCredit >= schedule.Bytes;
+    internals->Eligible.push_back(
+      !measured || dataDescription->GetForceOutput() || (withinTime && withinOutput) ? 1 : 0);
+  }
+
+  // Pipelines may be collective so all processes follow process 0.
+  vtkMultiProcessController* controller = internals->GetSimulationController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    controller->Broadcast(
+      internals->Eligible.data(), static_cast<vtkIdType>(internals->Eligible.size()), 0);
+  }
+
+  std::lock_guard<std::mutex> lock(internals->ScheduleMutex);
+  size_t index = 0;
+  for (const auto& pipeline : internals->Pipelines)
+  {
+    vtkCPProcessorInternals::PipelineSchedule& schedule = internals->Schedules[pipeline];
+    if (!internals->Eligible[index])
+    {
+      if (schedule.HeldBackSteps++ == 0)
+      {
+        vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+          "holding back %s (pipeline %d) at time step %lld: %g s and %g bytes per execution "
+          "exceed its budget",
+          pipeline->GetClassName(), static_cast<int>(index),
+          static_cast<long long>(dataDescription->GetTimeStep()), schedule.Time, schedule.Bytes);
+      }
+    }
+    else if (schedule.HeldBackSteps > 0)
+    {
+      vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+        "resuming %s (pipeline %d) at time step %lld after holding it back for %d time steps",
+        pipeline->GetClassName(), static_cast<int>(index),
+        static_cast<long long>(dataDescription->GetTimeStep()), schedule.HeldBackSteps);
+      schedule.HeldBackSteps = 0;
+    }
+    index++;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkCPProcessor::StartHelperThread()
+{
+  vtkCPProcessorInternals* internals = this->Internal;
+  // The working directory is the one of the process, so the helper thread
+  // cannot change it without moving the simulation's files too.
+  if (this->WorkingDirectory)
+  {
+    if (!internals->SynchronousExecutionWarned)
+    {
+      vtkWarningMacro("Asynchronous co-processing is not supported with a working directory, "
+        << this->WorkingDirectory << " here. Pipelines will be executed synchronously.");
+      internals->SynchronousExecutionWarned = true;
+    }
+    return false;
+  }
+  for (const auto& pipeline : internals->Pipelines)
+  {
+    if (!pipeline->CanCoProcessAsynchronously())
+    {
+      if (!internals->SynchronousExecutionWarned)
+      {
+        vtkWarningMacro(<< pipeline->GetClassName()
+                        << " cannot be executed asynchronously. Pipelines will be executed "
+                           "synchronously.");
+        internals->SynchronousExecutionWarned = true;
+      }
+      return false;
+    }
+  }
+  if (internals->HelperThread.joinable())
+  {
+    // Nothing else may change the global controller while the pipelines use
+    // it, see SetAsynchronous().
+    if (internals->HelperController &&
+      vtkMultiProcessController::GetGlobalController() != internals->HelperController)
+    {
+      vtkErrorMacro("The global controller was changed while co-processing asynchronously. "
+                    "Pipelines will be executed synchronously.");
+      internals->HelperThreadUnavailable = true;
+      return false;
+    }
+    return true;
+  }
+  if (internals->HelperThreadUnavailable)
+  {
+    return false;
+  }
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* controller =
+    vtkMPIController::SafeDownCast(vtkMultiProcessController::GetGlobalController());
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE)
+    {
+      vtkWarningMacro("Asynchronous co-processing requires MPI_THREAD_MULTIPLE. "
+                      "Pipelines will be executed synchronously.");
+      internals->HelperThreadUnavailable = true;
+      return false;
+    }
+    // The pipelines get their own communicator so that their collective
+    // operations never get mixed with the ones of the simulation. ParaView
+    // gets its controller from the global one, hence making it global until
+    // the helper thread is stopped.
+    vtkMultiProcessController* helperController =
+      controller->PartitionController(0, controller->GetLocalProcessId());
+    if (!helperController)
+    {
+      vtkWarningMacro("Could not create a communicator for asynchronous co-processing. "
+                      "Pipelines will be executed synchronously.");
+      internals->HelperThreadUnavailable = true;
+      return false;
+    }
+    internals->SimulationController = controller;
+    internals->HelperController.TakeReference(helperController);
+    vtkMultiProcessController::SetGlobalController(helperController);
+  }
+#endif
+
+  internals->StopHelperThread = false;
+  internals->HelperThread = std::thread([internals]() { internals->ExecutePendingSteps(); });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkCPProcessor::StopHelperThread()
+{
+  vtkCPProcessorInternals* internals = this->Internal;
+  if (!internals->HelperThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(internals->Mutex);
+    internals->StopHelperThread = true;
+  }
+  internals->Condition.notify_all();
+  internals->HelperThread.join();
+
+  if (internals->SimulationController)
+  {
+    if (vtkMultiProcessController::GetGlobalController() == internals->HelperController)
+    {
+      vtkMultiProcessController::SetGlobalController(internals->SimulationController);
+    }
+    internals->SimulationController = nullptr;
+    internals->HelperController = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkCPProcessor::WaitForPendingSteps()
+{
+  return this->Internal->Wait();
+}
+
 //----------------------------------------------------------------------------
 int vtkCPProcessor::Finalize()
 {
+  if (!this->WaitForPendingSteps())
+  {
+    vtkWarningMacro("Problems co-processing a time step asynchronously.");
+  }
+  this->StopHelperThread();
+
   if (this->Controller)
   {
     this->Controller->SetGlobalController(nullptr);
@@ -350,4 +864,8 @@ int vtkCPProcessor::Finalize()
 void vtkCPProcessor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Asynchronous: " << this->Asynchronous << "\n";
+  os << indent << "MaximumNumberOfPendingSteps: " << this->MaximumNumberOfPendingSteps << "\n";
+  os << indent << "MaximumTimeFraction: " << this->MaximumTimeFraction << "\n";
+  os << indent << "MaximumOutputRate: " << this->MaximumOutputRate << "\n";
 }
@@ -111,8 +111,62 @@ public:
 
   /// Called after all co-processing is complete giving the Co-Processor
   /// implementation an opportunity to clean up, before it is destroyed.
+  /// Waits for the time steps being co-processed asynchronously first.
   virtual int Finalize();
 
+  /// When on, CoProcess() takes a snapshot of its inputs, hands the pipelines
+  /// that need to execute to a helper thread and returns without waiting for
+  /// them. The point coordinates and the point, cell and field data arrays
+  /// are copied in the snapshot while the rest of the grid, e.g. the cells,
+  /// is shared so the adaptor must build a new grid instead of changing the
+  /// topology of the one given to an earlier time step. When running with
+  /// several MPI processes, MPI must provide MPI_THREAD_MULTIPLE, otherwise
+  /// pipelines are executed synchronously. The pipelines then use a duplicate
+  /// of the global controller's communicator, which is made the global
+  /// controller until Finalize() or a CoProcess() call with Asynchronous off.
+  /// Meanwhile, the simulation must neither use nor change the global
+  /// controller, and only one processor may execute asynchronously; changing
+  /// it is reported as an error and pipelines are then executed
+  /// synchronously. All the pipelines must return true from
+  /// vtkCPPipeline::CanCoProcessAsynchronously(), otherwise they are executed
+  /// synchronously, with a warning. Only vtkCPXMLPWriterPipeline does among
+  /// the pipelines provided by ParaView. The same goes when a *WorkingDirectory*
+  /// is given to Initialize(), since only the simulation thread may change
+  /// the working directory of the process. Off by default.
+  vtkSetMacro(Asynchronous, bool);
+  vtkGetMacro(Asynchronous, bool);
+  vtkBooleanMacro(Asynchronous, bool);
+
+  /// The maximum number of time steps co-processed asynchronously at the
+  /// same time. CoProcess() blocks until an earlier time step is done when
+  /// there are that many, which limits the memory used by the snapshots.
+  /// Default is 1.
+  vtkSetClampMacro(MaximumNumberOfPendingSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingSteps, int);
+
+  /// When positive, pipelines are executed only as often as needed for the
+  /// time spent executing them to stay under this fraction of the simulation
+  /// time, i.e. the time spent outside of this processor. Each pipeline gets
+  /// an equal share of that budget and is skipped at the time steps it would
+  /// execute until the share accumulated since its last execution covers its
+  /// measured execution time. Forced outputs are never skipped. The decisions
+  /// of process 0 are used by all processes and are logged at
+  /// PARAVIEW_LOG_CATALYST_VERBOSITY(). 0, the default, disables it.
+  vtkSetClampMacro(MaximumTimeFraction, double, 0.0, 1.0);
+  vtkGetMacro(MaximumTimeFraction, double);
+
+  /// Same as MaximumTimeFraction for an I/O budget, in bytes output per
+  /// second of simulation time. The output size of a pipeline is given by
+  /// vtkCPPipeline::GetLastOutputSize() or, when unknown, estimated with the
+  /// memory size of its inputs. 0, the default, disables it.
+  vtkSetClampMacro(MaximumOutputRate, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MaximumOutputRate, double);
+
+  /// Wait for all the time steps being co-processed asynchronously. Returns 0
+  /// if any time step failed since the last call to CoProcess() or
+  /// WaitForPendingSteps(), and 1 otherwise.
+  virtual int WaitForPendingSteps();
+
   /// Get the current working directory for outputting Catalyst files.
   /// If not set then Catalyst output files will be relative to the
   /// current working directory. This will not affect where Catalyst
@@ -132,10 +186,26 @@ protected:
   /// set this through the *Initialize()* methods.
   vtkSetStringMacro(WorkingDirectory);
 
+  bool Asynchronous;
+  int MaximumNumberOfPendingSteps;
+  double MaximumTimeFraction;
+  double MaximumOutputRate;
+
 private:
   vtkCPProcessor(const vtkCPProcessor&) = delete;
   void operator=(const vtkCPProcessor&) = delete;
 
+  /// Start the thread executing pipelines asynchronously, if needed. Returns
+  /// false when pipelines cannot be executed asynchronously.
+  bool StartHelperThread();
+
+  /// Wait for the pending time steps and stop the helper thread.
+  void StopHelperThread();
+
+  /// Decide which pipelines may execute at the current time step when
+  /// MaximumTimeFraction or MaximumOutputRate is set.
+  void SchedulePipelines(vtkCPDataDescription* dataDescription);
+
   vtkCPProcessorInternals* Internal;
   vtkObject* InitializationHelper;
   static vtkMultiProcessController* Controller;
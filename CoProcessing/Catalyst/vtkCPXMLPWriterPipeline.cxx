@@ -31,6 +31,9 @@
 #include <vtkSmartPointer.h>
 #include <vtkUnstructuredGrid.h>
 
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
 #include <algorithm>
 #include <sstream>
 #include <string>
@@ -116,6 +119,100 @@ const char* GetWriterFileNameExtension(vtkDataObject* grid)
   vtkGenericWarningMacro("Unknown dataset type " << name);
   return nullptr;
 }
+
+// Returns the extension of the piece files written next to the summary file,
+// or nullptr when they are all written in a subdirectory.
+const char* GetPieceFileNameExtension(vtkDataObject* grid)
+{
+  std::string name = grid->GetClassName();
+  if (name == "vtkImageData")
+  {
+    return "vti";
+  }
+  else if (name == "vtkRectilinearGrid")
+  {
+    return "vtr";
+  }
+  else if (name == "vtkStructuredGrid")
+  {
+    return "vts";
+  }
+  else if (name == "vtkPolyData")
+  {
+    return "vtp";
+  }
+  else if (name == "vtkUnstructuredGrid")
+  {
+    return "vtu";
+  }
+  return nullptr;
+}
+
+// Returns the number of bytes of the files written for fileName by all the
+// processes. Each process only looks for its own piece, named
+// <base>_<rank>.<pieceExtension>, next to the summary file or in the <base>
+// subdirectory, and process 0 also counts the summary file. Composite
+// datasets, whose pieces are only written in the <base> subdirectory with
+// pieceExtension being nullptr, are counted by process 0 once all the
+// processes are done writing.
+vtkTypeInt64 GetWrittenSize(const std::string& fileName, const char* pieceExtension)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  const int numberOfProcesses = controller ? controller->GetNumberOfProcesses() : 1;
+
+  std::string path = vtksys::SystemTools::GetFilenamePath(fileName);
+  if (path.empty())
+  {
+    path = ".";
+  }
+  const std::string base = vtksys::SystemTools::GetFilenameWithoutLastExtension(
+    vtksys::SystemTools::GetFilenameName(fileName));
+  const std::string subdirectory = path + "/" + base;
+
+  vtkTypeInt64 size = 0;
+  if (pieceExtension)
+  {
+    std::ostringstream piece;
+    piece << base << "_" << rank << "." << pieceExtension;
+    for (const std::string& name : { path + "/" + piece.str(), subdirectory + "/" + piece.str() })
+    {
+      if (vtksys::SystemTools::FileExists(name, /*isFile=*/true))
+      {
+        size += static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(name));
+      }
+    }
+  }
+  else if (numberOfProcesses > 1)
+  {
+    controller->Barrier();
+  }
+
+  if (rank == 0)
+  {
+    size += static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(fileName));
+    vtksys::Directory directory;
+    if (!pieceExtension && directory.Load(subdirectory))
+    {
+      for (unsigned long i = 0; i < directory.GetNumberOfFiles(); i++)
+      {
+        const std::string name = subdirectory + "/" + directory.GetFile(i);
+        if (!vtksys::SystemTools::FileIsDirectory(name))
+        {
+          size += static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(name));
+        }
+      }
+    }
+  }
+
+  if (numberOfProcesses > 1)
+  {
+    vtkTypeInt64 total = 0;
+    controller->AllReduce(&size, &total, 1, vtkCommunicator::SUM_OP);
+    size = total;
+  }
+  return size;
+}
 } // end anonymous namespace
 
 vtkStandardNewMacro(vtkCPXMLPWriterPipeline);
@@ -125,6 +222,7 @@ vtkCPXMLPWriterPipeline::vtkCPXMLPWriterPipeline()
 {
   this->OutputFrequency = 1;
   this->PaddingAmount = 0;
+  this->LastOutputSize = -1;
 }
 
 //----------------------------------------------------------------------------
@@ -163,6 +261,7 @@ int vtkCPXMLPWriterPipeline::CoProcess(vtkCPDataDescription* dataDescription)
     return 0;
   }
 
+  this->LastOutputSize = 0;
   if (this->RequestDataDescription(dataDescription) == 0)
   {
     return 1;
@@ -221,6 +320,7 @@ int vtkCPXMLPWriterPipeline::CoProcess(vtkCPDataDescription* dataDescription)
         writer->UpdatePropertyInformation();
         writer->UpdateVTKObjects();
         writer->UpdatePipeline();
+        this->LastOutputSize += GetWrittenSize(o.str(), GetPieceFileNameExtension(grid));
       }
     }
   }
@@ -228,12 +328,25 @@ int vtkCPXMLPWriterPipeline::CoProcess(vtkCPDataDescription* dataDescription)
   return retVal;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkCPXMLPWriterPipeline::GetLastOutputSize()
+{
+  return this->LastOutputSize;
+}
+
+//----------------------------------------------------------------------------
+bool vtkCPXMLPWriterPipeline::CanCoProcessAsynchronously()
+{
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkCPXMLPWriterPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "OutputFrequency: " << this->OutputFrequency << "\n";
   os << indent << "PaddingAmount: " << this->PaddingAmount << "\n";
+  os << indent << "LastOutputSize: " << this->LastOutputSize << "\n";
   if (this->Path.empty())
   {
     os << indent << "Path: (empty)\n";
@@ -36,6 +36,18 @@ public:
 
   int CoProcess(vtkCPDataDescription* dataDescription) override;
 
+  /// Return the number of bytes of the files written by all the processes in
+  /// the last CoProcess() call, i.e. the summary files and the pieces, or -1
+  /// before the first call. Each process only checks the size of its own
+  /// pieces.
+  vtkTypeInt64 GetLastOutputSize() override;
+
+  /// Returns true: RequestDataDescription() only reads OutputFrequency and
+  /// changes the data description it is given, which vtkCPProcessor copies
+  /// for each time step, so it can run while CoProcess() writes an earlier
+  /// time step. The output settings must not be changed meanwhile.
+  bool CanCoProcessAsynchronously() override;
+
   /// Set the output frequency for this pipeline. The default is 1.
   vtkSetClampMacro(OutputFrequency, int, 1, VTK_INT_MAX);
   vtkGetMacro(OutputFrequency, int);
@@ -60,5 +72,6 @@ private:
   int OutputFrequency;
   int PaddingAmount;
   std::string Path;
+  vtkTypeInt64 LastOutputSize;
 };
 #endif
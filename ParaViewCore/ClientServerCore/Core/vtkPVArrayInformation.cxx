@@ -15,20 +15,29 @@
 #include "vtkPVArrayInformation.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayAccessor.h"
 #include "vtkInformation.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationInformationVectorKey.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <set>
 #include <sstream>
@@ -45,6 +54,159 @@ struct vtkPVArrayInformationInformationKey
 };
 
 typedef std::vector<vtkPVArrayInformationInformationKey> vtkInternalInformationKeysBase;
+
+// Arrays with fewer values are handled by vtkDataArray::GetRange directly.
+const vtkIdType PARALLEL_RANGE_THRESHOLD = 1 << 17;
+
+//----------------------------------------------------------------------------
+// Computes the range of each component, of the squared magnitude and the
+// finite versions of these in a single pass over the array. The results are
+// stored as min/max pairs: components first, then the magnitude, then the
+// same again for the finite ranges.
+class vtkPVArrayRangeWorker
+{
+public:
+  std::vector<double> Ranges;
+
+  template <typename ArrayT>
+  class Functor
+  {
+  public:
+    ArrayT* Array;
+    int NumberOfComponents;
+    vtkSMPThreadLocal<std::vector<double> > LocalRanges;
+
+    void Initialize()
+    {
+      std::vector<double>& ranges = this->LocalRanges.Local();
+      ranges.resize(4 * (this->NumberOfComponents + 1));
+      for (size_t cc = 0; cc < ranges.size(); cc += 2)
+      {
+        ranges[cc] = VTK_DOUBLE_MAX;
+        ranges[cc + 1] = VTK_DOUBLE_MIN;
+      }
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      vtkDataArrayAccessor<ArrayT> accessor(this->Array);
+      const int numComps = this->NumberOfComponents;
+      double* ranges = &this->LocalRanges.Local()[0];
+      double* finiteRanges = ranges + 2 * (numComps + 1);
+      for (vtkIdType tuple = begin; tuple < end; ++tuple)
+      {
+        double squaredSum = 0.0;
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          const double value = static_cast<double>(accessor.Get(tuple, comp));
+          squaredSum += value * value;
+          if (vtkMath::IsNan(value))
+          {
+            continue;
+          }
+          ranges[2 * comp] = std::min(ranges[2 * comp], value);
+          ranges[2 * comp + 1] = std::max(ranges[2 * comp + 1], value);
+          if (!vtkMath::IsInf(value))
+          {
+            finiteRanges[2 * comp] = std::min(finiteRanges[2 * comp], value);
+            finiteRanges[2 * comp + 1] = std::max(finiteRanges[2 * comp + 1], value);
+          }
+        }
+        if (!vtkMath::IsNan(squaredSum))
+        {
+          ranges[2 * numComps] = std::min(ranges[2 * numComps], squaredSum);
+          ranges[2 * numComps + 1] = std::max(ranges[2 * numComps + 1], squaredSum);
+          if (!vtkMath::IsInf(squaredSum))
+          {
+            finiteRanges[2 * numComps] = std::min(finiteRanges[2 * numComps], squaredSum);
+            finiteRanges[2 * numComps + 1] = std::max(finiteRanges[2 * numComps + 1], squaredSum);
+          }
+        }
+      }
+    }
+
+    void Reduce() {}
+  };
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    Functor<ArrayT> functor;
+    functor.Array = array;
+    functor.NumberOfComponents = array->GetNumberOfComponents();
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+
+    this->Ranges.clear();
+    for (auto iter = functor.LocalRanges.begin(); iter != functor.LocalRanges.end(); ++iter)
+    {
+      const std::vector<double>& local = *iter;
+      if (this->Ranges.empty())
+      {
+        this->Ranges = local;
+        continue;
+      }
+      for (size_t cc = 0; cc < local.size(); cc += 2)
+      {
+        this->Ranges[cc] = std::min(this->Ranges[cc], local[cc]);
+        this->Ranges[cc + 1] = std::max(this->Ranges[cc + 1], local[cc + 1]);
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+bool vtkPVArrayHasCachedRanges(vtkDataArray* array)
+{
+  if (!array->HasInformation())
+  {
+    return false;
+  }
+  vtkInformation* info = array->GetInformation();
+  if (info->GetMTime() < array->GetMTime())
+  {
+    return false;
+  }
+  if (array->GetNumberOfComponents() > 1 &&
+    (!info->Has(vtkDataArray::L2_NORM_RANGE()) || !info->Has(vtkDataArray::L2_NORM_FINITE_RANGE())))
+  {
+    return false;
+  }
+  return info->Has(vtkAbstractArray::PER_COMPONENT()) &&
+    info->Has(vtkAbstractArray::PER_FINITE_COMPONENT());
+}
+
+//----------------------------------------------------------------------------
+// Stores ranges computed by vtkPVArrayRangeWorker in the array information
+// using the keys vtkDataArray::GetRange/GetFiniteRange look for.
+void vtkPVArrayCacheRanges(vtkDataArray* array, const std::vector<double>& ranges)
+{
+  const int numComps = array->GetNumberOfComponents();
+  vtkInformation* info = array->GetInformation();
+  for (int finite = 0; finite < 2; ++finite)
+  {
+    const double* values = &ranges[finite * 2 * (numComps + 1)];
+    if (numComps > 1)
+    {
+      double magnitude[2] = { std::sqrt(values[2 * numComps]),
+        std::sqrt(values[2 * numComps + 1]) };
+      info->Set(finite ? vtkDataArray::L2_NORM_FINITE_RANGE() : vtkDataArray::L2_NORM_RANGE(),
+        magnitude, 2);
+    }
+
+    // Use FastDelete() as vtkDataArray does, since this may be called from
+    // several threads and must not trigger the garbage collector.
+    vtkInformationVector* perComponent = vtkInformationVector::New();
+    perComponent->SetNumberOfInformationObjects(numComps);
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      perComponent->GetInformationObject(comp)->Set(
+        vtkDataArray::COMPONENT_RANGE(), values + 2 * comp, 2);
+    }
+    info->Set(finite ? vtkAbstractArray::PER_FINITE_COMPONENT() : vtkAbstractArray::PER_COMPONENT(),
+      perComponent);
+    perComponent->FastDelete();
+  }
+}
 }
 
 class vtkPVArrayInformation::vtkInternalComponentNames : public vtkInternalComponentNameBase
@@ -635,38 +797,7 @@ void vtkPVArrayInformation::CopyFromObject(vtkObject* obj)
 
   if (vtkDataArray* const data_array = vtkDataArray::SafeDownCast(obj))
   {
-    double range[2];
-    double* ptr;
-    int idx;
-
-    ptr = this->Ranges;
-    if (this->NumberOfComponents > 1)
-    {
-      // First store range of vector magnitude.
-      data_array->GetRange(range, -1);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
-    for (idx = 0; idx < this->NumberOfComponents; ++idx)
-    {
-      data_array->GetRange(range, idx);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
-    ptr = this->FiniteRanges;
-    if (this->NumberOfComponents > 1)
-    {
-      // First store range of vector magnitude.
-      data_array->GetFiniteRange(range, -1);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
-    for (idx = 0; idx < this->NumberOfComponents; ++idx)
-    {
-      data_array->GetFiniteRange(range, idx);
-      *ptr++ = range[0];
-      *ptr++ = range[1];
-    }
+    vtkPVArrayInformation::ComputeRanges(data_array, this->Ranges, this->FiniteRanges);
   }
 
   if (this->InformationKeys)
@@ -691,6 +822,65 @@ void vtkPVArrayInformation::CopyFromObject(vtkObject* obj)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVArrayInformation::ComputeRanges(
+  vtkDataArray* array, double* ranges, double* finiteRanges)
+{
+  if (array->GetNumberOfValues() >= PARALLEL_RANGE_THRESHOLD &&
+    !vtkPVArrayHasCachedRanges(array))
+  {
+    vtkPVArrayRangeWorker worker;
+    if (vtkArrayDispatch::Dispatch::Execute(array, worker) && !worker.Ranges.empty())
+    {
+      vtkPVArrayCacheRanges(array, worker.Ranges);
+    }
+  }
+
+  // Get the ranges through vtkDataArray so that cached values are used.
+  const int numComps = array->GetNumberOfComponents();
+  double range[2];
+  double* ptr = ranges;
+  if (numComps > 1)
+  {
+    // First store range of vector magnitude.
+    array->GetRange(range, -1);
+    if (ptr)
+    {
+      *ptr++ = range[0];
+      *ptr++ = range[1];
+    }
+  }
+  for (int idx = 0; idx < numComps; ++idx)
+  {
+    array->GetRange(range, idx);
+    if (ptr)
+    {
+      *ptr++ = range[0];
+      *ptr++ = range[1];
+    }
+  }
+  ptr = finiteRanges;
+  if (numComps > 1)
+  {
+    // First store range of vector magnitude.
+    array->GetFiniteRange(range, -1);
+    if (ptr)
+    {
+      *ptr++ = range[0];
+      *ptr++ = range[1];
+    }
+  }
+  for (int idx = 0; idx < numComps; ++idx)
+  {
+    array->GetFiniteRange(range, idx);
+    if (ptr)
+    {
+      *ptr++ = range[0];
+      *ptr++ = range[1];
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVArrayInformation::AddInformation(vtkPVInformation* info)
 {
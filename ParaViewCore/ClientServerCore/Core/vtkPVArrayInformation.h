@@ -31,6 +31,7 @@
 #include "vtkPVInformation.h"
 class vtkAbstractArray;
 class vtkClientServerStream;
+class vtkDataArray;
 class vtkStdString;
 class vtkStringArray;
 
@@ -124,6 +125,19 @@ public:
    */
   void GetDataTypeRange(double range[2]);
 
+  /**
+   * Computes the ranges of the array, as returned by vtkDataArray::GetRange
+   * and vtkDataArray::GetFiniteRange, and stores them in `ranges` and
+   * `finiteRanges` (which may be nullptr) using the layout of
+   * GetComponentRange: the range of the vector magnitude comes first when the
+   * array has more than one component. Ranges cached on the array are reused.
+   * Otherwise, for large arrays, all ranges are computed in a single pass
+   * using vtkSMPTools and cached on the array for later calls.
+   *
+   * This may be called concurrently for distinct arrays.
+   */
+  static void ComputeRanges(vtkDataArray* array, double* ranges, double* finiteRanges);
+
   /**
    * Returns 1 if the array can be combined.
    * It must have the same name and number of components.
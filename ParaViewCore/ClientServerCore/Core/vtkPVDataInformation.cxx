@@ -45,15 +45,23 @@
 #include "vtkPVInformationKeys.h"
 #include "vtkPVInstantiator.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
 #include "vtkUniformGrid.h"
+#include "vtkWeakPointer.h"
+
+#include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -62,6 +70,190 @@ vtkStandardNewMacro(vtkPVDataInformation);
 
 std::map<std::string, std::string> helpers;
 
+namespace
+{
+// Set while gathering information for a data object whose array ranges have
+// already been computed, so that the nested calls made for its blocks do not
+// collect the arrays again.
+thread_local bool vtkPVDataInformationRangesComputed = false;
+
+//----------------------------------------------------------------------------
+// Information gathered for datasets, reused as long as the dataset is not
+// modified so that gathering information again after an update only visits
+// the blocks that changed. Entries are keyed by the dataset and are dropped
+// once the dataset has been deleted.
+class vtkPVDataInformationCache
+{
+public:
+  static vtkPVDataInformationCache* GetInstance()
+  {
+    static vtkPVDataInformationCache instance;
+    return &instance;
+  }
+
+  bool GetEnabled() const { return this->Enabled; }
+
+  vtkSmartPointer<vtkPVDataInformation> Find(vtkDataObject* dobj)
+  {
+    if (!this->Enabled)
+    {
+      return nullptr;
+    }
+    const vtkMTimeType mtime = dobj->GetMTime();
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Entries.find(dobj);
+    if (iter != this->Entries.end() && iter->second.DataObject.GetPointer() == dobj &&
+      iter->second.MTime == mtime)
+    {
+      return iter->second.Information;
+    }
+    return nullptr;
+  }
+
+  void Store(vtkDataObject* dobj, vtkPVDataInformation* info)
+  {
+    vtkSmartPointer<vtkPVDataInformation> copy = vtkSmartPointer<vtkPVDataInformation>::New();
+    copy->DeepCopy(info);
+    const vtkMTimeType mtime = dobj->GetMTime();
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    Entry& entry = this->Entries[dobj];
+    entry.DataObject = dobj;
+    entry.MTime = mtime;
+    entry.Information = copy;
+    if (this->Entries.size() > this->PruneSize)
+    {
+      for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+      {
+        iter = iter->second.DataObject ? std::next(iter) : this->Entries.erase(iter);
+      }
+      this->PruneSize = std::max<size_t>(1024, 2 * this->Entries.size());
+    }
+  }
+
+private:
+  vtkPVDataInformationCache()
+    : Enabled(vtksys::SystemTools::GetEnv("PV_DISABLE_INCREMENTAL_GATHER") == nullptr)
+    , PruneSize(1024)
+  {
+  }
+
+  struct Entry
+  {
+    vtkWeakPointer<vtkDataObject> DataObject;
+    vtkMTimeType MTime;
+    vtkSmartPointer<vtkPVDataInformation> Information;
+  };
+  std::map<vtkDataObject*, Entry> Entries;
+  std::mutex Mutex;
+  bool Enabled;
+  size_t PruneSize;
+};
+
+//----------------------------------------------------------------------------
+// Computes the ranges of distinct arrays in parallel. Arrays shared by several
+// blocks are only processed once, since computing the ranges of an array
+// updates its information object.
+class vtkPVDataInformationRangesFunctor
+{
+public:
+  // Arrays with the points they hold the coordinates of, if any.
+  std::map<vtkDataArray*, vtkPoints*> Arrays;
+  std::vector<std::pair<vtkDataArray*, vtkPoints*> > Tasks;
+
+  void AddFieldData(vtkFieldData* fd)
+  {
+    for (int cc = 0, max = (fd ? fd->GetNumberOfArrays() : 0); cc < max; ++cc)
+    {
+      if (vtkDataArray* array = fd->GetArray(cc))
+      {
+        this->Arrays.insert(std::make_pair(array, static_cast<vtkPoints*>(nullptr)));
+      }
+    }
+  }
+
+  void AddDataObject(vtkDataObject* dobj)
+  {
+    if (!dobj || vtkPVDataInformationCache::GetInstance()->Find(dobj))
+    {
+      // unchanged since it was last gathered.
+      return;
+    }
+    this->AddFieldData(dobj->GetFieldData());
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj))
+    {
+      this->AddFieldData(ds->GetPointData());
+      this->AddFieldData(ds->GetCellData());
+    }
+    vtkPointSet* ps = vtkPointSet::SafeDownCast(dobj);
+    if (ps && ps->GetPoints() && ps->GetPoints()->GetData())
+    {
+      this->Arrays[ps->GetPoints()->GetData()] = ps->GetPoints();
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkPVArrayInformation::ComputeRanges(this->Tasks[cc].first, nullptr, nullptr);
+      if (vtkPoints* points = this->Tasks[cc].second)
+      {
+        points->GetBounds();
+      }
+    }
+  }
+
+  void Execute(vtkDataObject* dobj)
+  {
+    if (vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      this->AddFieldData(cds->GetFieldData());
+      vtkCompositeDataIterator* iter = cds->NewIterator();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->AddDataObject(iter->GetCurrentDataObject());
+      }
+      iter->Delete();
+    }
+    else
+    {
+      this->AddDataObject(dobj);
+    }
+    this->Tasks.assign(this->Arrays.begin(), this->Arrays.end());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Tasks.size()), 1, *this);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Computes the array ranges of the outermost data object gathered on this
+// thread.
+class vtkPVDataInformationRangesScope
+{
+public:
+  vtkPVDataInformationRangesScope(vtkDataObject* dobj)
+    : Outermost(!vtkPVDataInformationRangesComputed)
+  {
+    if (this->Outermost)
+    {
+      vtkPVDataInformationRangesFunctor functor;
+      functor.Execute(dobj);
+      vtkPVDataInformationRangesComputed = true;
+    }
+  }
+  ~vtkPVDataInformationRangesScope()
+  {
+    if (this->Outermost)
+    {
+      vtkPVDataInformationRangesComputed = false;
+    }
+  }
+
+private:
+  bool Outermost;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPVDataInformation::vtkPVDataInformation()
 {
@@ -802,6 +994,26 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  // Compute the array ranges of all blocks in parallel up front. Gathering
+  // the information then only reads the ranges cached on the arrays.
+  vtkPVDataInformationRangesScope rangesScope(dobj);
+
+  // Datasets that have not been modified since they were last gathered reuse
+  // the information gathered then. Only the time meta-data, which comes from
+  // the pipeline, is collected again.
+  vtkPVDataInformationCache* cache = vtkPVDataInformationCache::GetInstance();
+  const bool cacheable = cache->GetEnabled() && vtkDataSet::SafeDownCast(dobj) != nullptr &&
+    vtkHyperTreeGrid::SafeDownCast(dobj) == nullptr;
+  if (cacheable)
+  {
+    if (vtkSmartPointer<vtkPVDataInformation> cached = cache->Find(dobj))
+    {
+      this->DeepCopy(cached);
+      this->CopyCommonMetaData(dobj, info);
+      return;
+    }
+  }
+
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj);
   if (cds)
   {
@@ -822,6 +1034,10 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
   if (ds)
   {
     this->CopyFromDataSet(ds);
+    if (cacheable)
+    {
+      cache->Store(dobj, this);
+    }
     this->CopyCommonMetaData(dobj, info);
     return;
   }
@@ -22,6 +22,12 @@
  * has a PV in the class name because it should never be moved into
  * VTK.
  *
+ * The information gathered for a dataset is kept until the dataset is
+ * modified or deleted. Gathering information again for an unmodified dataset,
+ * or for a composite dataset in which only some of the blocks changed, reuses
+ * it instead of visiting the arrays again. Set the environment variable
+ * PV_DISABLE_INCREMENTAL_GATHER to disable this.
+ *
  * @warning
  * Get polygons only works for poly data and it does not work propelry for the
  * triangle strips.
@@ -29,6 +29,7 @@
 #include "vtkOutputWindow.h"
 #include "vtkPSystemTools.h"
 #include "vtkPVConfig.h"
+#include "vtkPVLogger.h"
 #include "vtkPVOptions.h"
 #include "vtkPolyData.h"
 #include "vtkSessionIterator.h"
@@ -93,6 +94,26 @@ private:
   ~vtkPVGenericOutputWindow() override {}
 };
 vtkStandardNewMacro(vtkPVGenericOutputWindow);
+
+// Name of the process type, used to tell apart the traces of the processes.
+const char* vtkGetProcessTypeName(vtkProcessModule::ProcessTypes type)
+{
+  switch (type)
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return "client";
+    case vtkProcessModule::PROCESS_SERVER:
+      return "server";
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      return "dataserver";
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return "renderserver";
+    case vtkProcessModule::PROCESS_BATCH:
+      return "batch";
+    default:
+      return "invalid";
+  }
+}
 }
 
 //----------------------------------------------------------------------------
@@ -191,6 +212,8 @@ bool vtkProcessModule::Initialize(ProcessTypes type, int& argc, char**& argv)
 #endif
   vtkProcessModule::GlobalController->BroadcastTriggerRMIOn();
   vtkMultiProcessController::SetGlobalController(vtkProcessModule::GlobalController);
+  vtkPVLogger::SetTraceProcessId(vtkProcessModule::GlobalController->GetLocalProcessId());
+  vtkPVLogger::SetTraceProcessName(vtkGetProcessTypeName(type));
 
   // Hack to support -display parameter.  vtkPVOptions requires parameters to be
   // specified as -option=value, but it is generally expected that X window
@@ -302,6 +325,25 @@ bool vtkProcessModule::Finalize()
   // destroy the process-module.
   vtkProcessModule::Singleton = NULL;
 
+  // write the performance trace requested using PARAVIEW_TRACE_FILE, one
+  // file per process type and rank, since the client and the server may share
+  // the same environment.
+  if (const char* traceFileName = vtkPVLogger::GetTraceFileName())
+  {
+    std::string fname = traceFileName;
+    std::ostringstream str;
+    str << vtksys::SystemTools::GetFilenameWithoutLastExtension(fname) << "."
+        << vtkGetProcessTypeName(vtkProcessModule::ProcessType);
+    if (vtkProcessModule::GlobalController->GetNumberOfProcesses() > 1)
+    {
+      str << "." << vtkProcessModule::GlobalController->GetLocalProcessId();
+    }
+    str << vtksys::SystemTools::GetFilenameLastExtension(fname);
+    std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+    fname = path.empty() ? str.str() : path + "/" + str.str();
+    vtkPVLogger::WriteTrace(fname.c_str());
+  }
+
   // We don't really need to call SetGlobalController(NULL) since
   // it's really stored with a weak pointer.  We set it to null anyways
   // in case it gets changed later to reference counting the pointer
@@ -338,6 +380,7 @@ void vtkProcessModule::UpdateProcessType(ProcessTypes newType, bool dontKnowWhat
       "UpdateProcessType from " << vtkProcessModule::ProcessType << " to " << newType);
   }
   vtkProcessModule::ProcessType = newType;
+  vtkPVLogger::SetTraceProcessName(vtkGetProcessTypeName(newType));
 }
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,874 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSharedMemoryDataTransport.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSharedMemoryDataTransport.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED 1
+#endif
+
+namespace
+{
+// Tag used during negotiation. Data transfers use the caller's tag.
+const int SHARED_MEMORY_NEGOTIATION_TAG = 99989;
+
+// Arrays smaller than this go through the socket with the structure of the
+// data object: a segment per array would cost more than copying them.
+const vtkTypeUInt64 SHARED_MEMORY_MINIMUM_ARRAY_SIZE = 65536;
+
+// A segment holding the values of a single array, mapped privately by each
+// process wrapping an array around it. Name is only set in the process that
+// created the segment, which removes it once its array releases the mapping.
+struct vtkSharedMapping
+{
+  void* Address = nullptr;
+  size_t Length = 0;
+  std::string Name;
+  vtkMTimeType MTime = 0;
+};
+
+class vtkSharedMemoryRegistry
+{
+public:
+  std::mutex Mutex;
+  std::vector<vtkWeakPointer<vtkMultiProcessController> > Controllers;
+  // Mapping each array wrapping shared memory refers to, by address.
+  std::map<void*, vtkSharedMapping> Arrays;
+
+  static vtkSharedMemoryRegistry& GetInstance()
+  {
+    static vtkSharedMemoryRegistry instance;
+    return instance;
+  }
+};
+
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+
+//----------------------------------------------------------------------------
+std::string vtkNewSegmentName()
+{
+  // Keep the name short: macOS limits shared memory names to 31 characters.
+  static std::mutex mutex;
+  static unsigned int counter = 0;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::random_device rd;
+  char name[32];
+  snprintf(name, sizeof(name), "/pv%x.%x.%x", static_cast<unsigned int>(getpid()), counter++,
+    static_cast<unsigned int>(rd() & 0xffffff));
+  return name;
+}
+
+//----------------------------------------------------------------------------
+// Creates a segment holding a copy of `length` bytes at `data` and maps it
+// privately. Returns nullptr on failure.
+void* vtkCreateSegment(const std::string& name, const void* data, size_t length)
+{
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd == -1)
+  {
+    return nullptr;
+  }
+  // mmap does not accept empty mappings.
+  const size_t mapLength = length > 0 ? length : 1;
+  void* address = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(mapLength)) == 0)
+  {
+    void* shared = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (shared != MAP_FAILED)
+    {
+      memcpy(shared, data, length);
+      munmap(shared, mapLength);
+      // Later changes made by this process must not reach the processes the
+      // segment has been sent to, hence the private mapping.
+      address = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+  }
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    shm_unlink(name.c_str());
+    return nullptr;
+  }
+  return address;
+}
+
+//----------------------------------------------------------------------------
+// Maps an existing segment. The mapping is private so that the receiver may
+// modify the arrays without affecting the sender.
+void* vtkOpenSegment(const std::string& name, size_t length)
+{
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd == -1)
+  {
+    return nullptr;
+  }
+  const size_t mapLength = length > 0 ? length : 1;
+  void* address = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  return address == MAP_FAILED ? nullptr : address;
+}
+
+//----------------------------------------------------------------------------
+void vtkCloseSegment(void* address, size_t length)
+{
+  munmap(address, length > 0 ? length : 1);
+}
+
+//----------------------------------------------------------------------------
+// Free function installed on arrays wrapping a shared mapping.
+void vtkReleaseSharedArray(void* ptr)
+{
+  vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+  vtkSharedMapping mapping;
+  {
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto iter = registry.Arrays.find(ptr);
+    if (iter == registry.Arrays.end())
+    {
+      return;
+    }
+    mapping = iter->second;
+    registry.Arrays.erase(iter);
+  }
+  vtkCloseSegment(mapping.Address, mapping.Length);
+  if (!mapping.Name.empty())
+  {
+    shm_unlink(mapping.Name.c_str());
+  }
+}
+
+//----------------------------------------------------------------------------
+// Makes `array` wrap a mapping that `mapping` describes.
+void vtkWrapSharedArray(vtkDataArray* array, vtkIdType numValues, const vtkSharedMapping& mapping)
+{
+  // Register before wrapping: releasing the previous values of the array may
+  // lock the registry.
+  {
+    vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Arrays[mapping.Address] = mapping;
+  }
+  array->SetVoidArray(mapping.Address, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(vtkReleaseSharedArray);
+}
+
+//----------------------------------------------------------------------------
+// Returns the name of a segment holding the values of `array`. The values of
+// the array are moved to a new segment the first time, and the segment is
+// reused as long as the array is not modified. Returns an empty string on
+// failure.
+std::string vtkShareArray(vtkDataArray* array)
+{
+  void* ptr = array->GetVoidPointer(0);
+  const size_t length = static_cast<size_t>(array->GetDataSize()) * array->GetDataTypeSize();
+  {
+    vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto iter = registry.Arrays.find(ptr);
+    if (iter != registry.Arrays.end() && !iter->second.Name.empty() &&
+      iter->second.Length == length && iter->second.MTime >= array->GetMTime())
+    {
+      return iter->second.Name;
+    }
+  }
+
+  vtkSharedMapping mapping;
+  mapping.Name = vtkNewSegmentName();
+  mapping.Length = length;
+  mapping.Address = vtkCreateSegment(mapping.Name, ptr, length);
+  if (mapping.Address == nullptr)
+  {
+    return std::string();
+  }
+  // The array now uses the segment and its own buffer is released, so the
+  // values are only held once.
+  vtkWrapSharedArray(array, array->GetDataSize(), mapping);
+  {
+    vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Arrays[mapping.Address].MTime = array->GetMTime();
+  }
+  return mapping.Name;
+}
+
+#endif
+
+//============================================================================
+// Records the structure of a data object into a stream. Small arrays are
+// written in the stream, while the others are only referred to by their
+// index in Arrays, the arrays to share.
+class vtkSharedMemoryEncoder
+{
+public:
+  vtkMultiProcessStream Stream;
+  std::vector<vtkDataArray*> Arrays;
+
+  bool EncodeArray(vtkAbstractArray* aa)
+  {
+    if (aa == nullptr)
+    {
+      this->Stream << 0;
+      return true;
+    }
+    vtkDataArray* array = vtkDataArray::SafeDownCast(aa);
+    if (array == nullptr || !array->HasStandardMemoryLayout() ||
+      array->GetDataType() == VTK_BIT)
+    {
+      return false;
+    }
+
+    const vtkTypeUInt64 length =
+      static_cast<vtkTypeUInt64>(array->GetDataSize()) * array->GetDataTypeSize();
+    const bool shared = length >= SHARED_MEMORY_MINIMUM_ARRAY_SIZE;
+    this->Stream << (shared ? 2 : 1) << array->GetDataType() << (array->GetName() ? 1 : 0)
+                 << std::string(array->GetName() ? array->GetName() : "")
+                 << array->GetNumberOfComponents()
+                 << static_cast<vtkTypeInt64>(array->GetNumberOfTuples());
+    if (shared)
+    {
+      this->Stream << static_cast<int>(this->Arrays.size());
+      this->Arrays.push_back(array);
+    }
+    else if (length > 0)
+    {
+      this->Stream.Push(
+        static_cast<unsigned char*>(array->GetVoidPointer(0)), static_cast<unsigned int>(length));
+    }
+    return true;
+  }
+
+  bool EncodeFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    const int count = fd ? fd->GetNumberOfArrays() : 0;
+    this->Stream << count;
+    for (int cc = 0; cc < count; ++cc)
+    {
+      this->Stream << (dsa ? dsa->IsArrayAnAttribute(cc) : -1);
+      if (!this->EncodeArray(fd->GetAbstractArray(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool EncodeCells(vtkCellArray* cells)
+  {
+    this->Stream << static_cast<vtkTypeInt64>(cells ? cells->GetNumberOfCells() : 0);
+    return this->EncodeArray(cells ? cells->GetData() : nullptr);
+  }
+
+  bool EncodeDataSet(vtkDataSet* ds)
+  {
+    return this->EncodeFieldData(ds->GetFieldData()) &&
+      this->EncodeFieldData(ds->GetPointData()) && this->EncodeFieldData(ds->GetCellData());
+  }
+
+  bool EncodeDataObject(vtkDataObject* dobj)
+  {
+    if (dobj == nullptr)
+    {
+      this->Stream << -1;
+      return true;
+    }
+
+    const int type = dobj->GetDataObjectType();
+    this->Stream << type;
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(dobj);
+        return this->EncodeDataSet(pd) &&
+          this->EncodeArray(pd->GetPoints() ? pd->GetPoints()->GetData() : nullptr) &&
+          this->EncodeCells(pd->GetVerts()) && this->EncodeCells(pd->GetLines()) &&
+          this->EncodeCells(pd->GetPolys()) && this->EncodeCells(pd->GetStrips());
+      }
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dobj);
+        if (ug->GetFaces() != nullptr)
+        {
+          // polyhedral cells are not supported.
+          return false;
+        }
+        return this->EncodeDataSet(ug) &&
+          this->EncodeArray(ug->GetPoints() ? ug->GetPoints()->GetData() : nullptr) &&
+          this->EncodeCells(ug->GetCells()) && this->EncodeArray(ug->GetCellTypesArray()) &&
+          this->EncodeArray(ug->GetCellLocationsArray());
+      }
+
+      case VTK_IMAGE_DATA:
+      {
+        vtkImageData* id = vtkImageData::SafeDownCast(dobj);
+        const int* ext = id->GetExtent();
+        const double* origin = id->GetOrigin();
+        const double* spacing = id->GetSpacing();
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          this->Stream << ext[cc];
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          this->Stream << origin[cc] << spacing[cc];
+        }
+        return this->EncodeDataSet(id);
+      }
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(dobj);
+        vtkMultiPieceDataSet* mp = vtkMultiPieceDataSet::SafeDownCast(dobj);
+        const unsigned int count = mb ? mb->GetNumberOfBlocks() : mp->GetNumberOfPieces();
+        this->Stream << count;
+        for (unsigned int cc = 0; cc < count; ++cc)
+        {
+          vtkInformation* metadata = mb ? (mb->HasMetaData(cc) ? mb->GetMetaData(cc) : nullptr)
+                                        : (mp->HasMetaData(cc) ? mp->GetMetaData(cc) : nullptr);
+          const char* name = (metadata && metadata->Has(vtkCompositeDataSet::NAME()))
+            ? metadata->Get(vtkCompositeDataSet::NAME())
+            : nullptr;
+          this->Stream << (name ? 1 : 0) << std::string(name ? name : "");
+          if (!this->EncodeDataObject(mb ? mb->GetBlock(cc) : mp->GetPieceAsDataObject(cc)))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      default:
+        return false;
+    }
+  }
+};
+
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+
+//============================================================================
+// Rebuilds a data object from the stream, wrapping the shared arrays around
+// the mapped segments. Mappings that end up wrapped are cleared.
+class vtkSharedMemoryDecoder
+{
+public:
+  vtkMultiProcessStream* Stream;
+  std::vector<vtkSharedMapping>* Mappings;
+
+  vtkSmartPointer<vtkDataArray> DecodeArray()
+  {
+    int kind;
+    (*this->Stream) >> kind;
+    if (kind == 0)
+    {
+      return nullptr;
+    }
+
+    int type, hasName, numComps;
+    std::string name;
+    vtkTypeInt64 numTuples;
+    (*this->Stream) >> type >> hasName >> name >> numComps >> numTuples;
+
+    vtkSmartPointer<vtkDataArray> array;
+    array.TakeReference(vtkDataArray::CreateDataArray(type));
+    if (hasName)
+    {
+      array->SetName(name.c_str());
+    }
+    array->SetNumberOfComponents(numComps);
+    const vtkIdType numValues = static_cast<vtkIdType>(numTuples) * numComps;
+    if (kind == 2)
+    {
+      int index;
+      (*this->Stream) >> index;
+      vtkSharedMapping& mapping = (*this->Mappings)[index];
+      vtkWrapSharedArray(array, numValues, mapping);
+      mapping.Address = nullptr;
+      return array;
+    }
+
+    array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+    if (numValues > 0)
+    {
+      unsigned char* values = nullptr;
+      unsigned int length = 0;
+      this->Stream->Pop(values, length);
+      memcpy(array->GetVoidPointer(0), values, length);
+      delete[] values;
+    }
+    return array;
+  }
+
+  void DecodeFieldData(vtkFieldData* fd)
+  {
+    vtkDataSetAttributes* dsa = vtkDataSetAttributes::SafeDownCast(fd);
+    int count;
+    (*this->Stream) >> count;
+    for (int cc = 0; cc < count; ++cc)
+    {
+      int attributeType;
+      (*this->Stream) >> attributeType;
+      vtkSmartPointer<vtkDataArray> array = this->DecodeArray();
+      const int idx = fd->AddArray(array);
+      if (dsa && attributeType >= 0)
+      {
+        dsa->SetActiveAttribute(idx, attributeType);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkCellArray> DecodeCells()
+  {
+    vtkTypeInt64 numCells;
+    (*this->Stream) >> numCells;
+    vtkSmartPointer<vtkDataArray> data = this->DecodeArray();
+    vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(data);
+    if (ids == nullptr)
+    {
+      return nullptr;
+    }
+    auto cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetCells(static_cast<vtkIdType>(numCells), ids);
+    return cells;
+  }
+
+  void DecodeDataSet(vtkDataSet* ds)
+  {
+    this->DecodeFieldData(ds->GetFieldData());
+    this->DecodeFieldData(ds->GetPointData());
+    this->DecodeFieldData(ds->GetCellData());
+  }
+
+  vtkSmartPointer<vtkPoints> DecodePoints()
+  {
+    vtkSmartPointer<vtkDataArray> data = this->DecodeArray();
+    if (data == nullptr)
+    {
+      return nullptr;
+    }
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(data);
+    return points;
+  }
+
+  vtkSmartPointer<vtkDataObject> DecodeDataObject()
+  {
+    int type;
+    (*this->Stream) >> type;
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        auto pd = vtkSmartPointer<vtkPolyData>::New();
+        this->DecodeDataSet(pd);
+        pd->SetPoints(this->DecodePoints());
+        pd->SetVerts(this->DecodeCells());
+        pd->SetLines(this->DecodeCells());
+        pd->SetPolys(this->DecodeCells());
+        pd->SetStrips(this->DecodeCells());
+        return pd.GetPointer();
+      }
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        auto ug = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        this->DecodeDataSet(ug);
+        ug->SetPoints(this->DecodePoints());
+        vtkSmartPointer<vtkCellArray> cells = this->DecodeCells();
+        vtkSmartPointer<vtkDataArray> types = this->DecodeArray();
+        vtkSmartPointer<vtkDataArray> locations = this->DecodeArray();
+        if (cells && types && locations)
+        {
+          ug->SetCells(vtkUnsignedCharArray::SafeDownCast(types),
+            vtkIdTypeArray::SafeDownCast(locations), cells);
+        }
+        return ug.GetPointer();
+      }
+
+      case VTK_IMAGE_DATA:
+      {
+        auto id = vtkSmartPointer<vtkImageData>::New();
+        int ext[6];
+        double origin[3], spacing[3];
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          (*this->Stream) >> ext[cc];
+        }
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          (*this->Stream) >> origin[cc] >> spacing[cc];
+        }
+        id->SetExtent(ext);
+        id->SetOrigin(origin);
+        id->SetSpacing(spacing);
+        this->DecodeDataSet(id);
+        return id.GetPointer();
+      }
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkSmartPointer<vtkMultiBlockDataSet> mb;
+        vtkSmartPointer<vtkMultiPieceDataSet> mp;
+        if (type == VTK_MULTIBLOCK_DATA_SET)
+        {
+          mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+        }
+        else
+        {
+          mp = vtkSmartPointer<vtkMultiPieceDataSet>::New();
+        }
+        unsigned int count;
+        (*this->Stream) >> count;
+        if (mb)
+        {
+          mb->SetNumberOfBlocks(count);
+        }
+        else
+        {
+          mp->SetNumberOfPieces(count);
+        }
+        for (unsigned int cc = 0; cc < count; ++cc)
+        {
+          int hasName;
+          std::string name;
+          (*this->Stream) >> hasName >> name;
+          vtkSmartPointer<vtkDataObject> child = this->DecodeDataObject();
+          if (mb)
+          {
+            mb->SetBlock(cc, child);
+          }
+          else
+          {
+            mp->SetPiece(cc, child);
+          }
+          if (hasName)
+          {
+            vtkInformation* metadata = mb ? mb->GetMetaData(cc) : mp->GetMetaData(cc);
+            metadata->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        if (mb)
+        {
+          return mb.GetPointer();
+        }
+        return mp.GetPointer();
+      }
+
+      default:
+        return nullptr;
+    }
+  }
+};
+
+#endif
+}
+
+vtkStandardNewMacro(vtkSharedMemoryDataTransport);
+//----------------------------------------------------------------------------
+vtkSharedMemoryDataTransport::vtkSharedMemoryDataTransport()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSharedMemoryDataTransport::~vtkSharedMemoryDataTransport()
+{
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemoryDataTransport::IsAvailable()
+{
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+  return vtksys::SystemTools::GetEnv("PV_DISABLE_SHARED_MEMORY_TRANSPORT") == nullptr;
+#else
+  return false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemoryDataTransport::Negotiate(
+  vtkMultiProcessController* controller, bool create_probe)
+{
+  if (controller == nullptr)
+  {
+    return false;
+  }
+
+  int result = 0;
+  if (create_probe)
+  {
+    // Create a probe segment holding a random value and let the other process
+    // confirm it can read it. This fails if the processes run on different
+    // hosts (or in different containers).
+    std::string name;
+    vtkTypeUInt64 nonce = 0;
+    bool created = false;
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+    if (vtkSharedMemoryDataTransport::IsAvailable())
+    {
+      std::random_device rd;
+      nonce = (static_cast<vtkTypeUInt64>(rd()) << 32) | rd();
+      name = vtkNewSegmentName();
+      if (void* address = vtkCreateSegment(name, &nonce, sizeof(nonce)))
+      {
+        vtkCloseSegment(address, sizeof(nonce));
+        created = true;
+      }
+    }
+#endif
+    vtkMultiProcessStream stream;
+    stream << (created ? 1 : 0) << name << nonce;
+    controller->Send(stream, 1, SHARED_MEMORY_NEGOTIATION_TAG);
+    controller->Receive(&result, 1, 1, SHARED_MEMORY_NEGOTIATION_TAG);
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+    if (created)
+    {
+      shm_unlink(name.c_str());
+    }
+#endif
+  }
+  else
+  {
+    vtkMultiProcessStream stream;
+    controller->Receive(stream, 1, SHARED_MEMORY_NEGOTIATION_TAG);
+    int created;
+    std::string name;
+    vtkTypeUInt64 nonce;
+    stream >> created >> name >> nonce;
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+    if (created && vtkSharedMemoryDataTransport::IsAvailable())
+    {
+      if (void* address = vtkOpenSegment(name, sizeof(nonce)))
+      {
+        vtkTypeUInt64 value;
+        memcpy(&value, address, sizeof(value));
+        vtkCloseSegment(address, sizeof(nonce));
+        result = (value == nonce) ? 1 : 0;
+      }
+    }
+#endif
+    controller->Send(&result, 1, 1, SHARED_MEMORY_NEGOTIATION_TAG);
+  }
+
+  if (result)
+  {
+    vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    registry.Controllers.push_back(controller);
+  }
+  return result != 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemoryDataTransport::IsEnabled(vtkMultiProcessController* controller)
+{
+  if (controller == nullptr)
+  {
+    return false;
+  }
+  vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  bool found = false;
+  for (auto iter = registry.Controllers.begin(); iter != registry.Controllers.end();)
+  {
+    if (iter->GetPointer() == nullptr)
+    {
+      // the controller has been deleted.
+      iter = registry.Controllers.erase(iter);
+      continue;
+    }
+    found = found || (iter->GetPointer() == controller);
+    ++iter;
+  }
+  return found;
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedMemoryDataTransport::Disable(vtkMultiProcessController* controller)
+{
+  vtkSharedMemoryRegistry& registry = vtkSharedMemoryRegistry::GetInstance();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (auto iter = registry.Controllers.begin(); iter != registry.Controllers.end();)
+  {
+    if (iter->GetPointer() == nullptr || iter->GetPointer() == controller)
+    {
+      iter = registry.Controllers.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemoryDataTransport::Send(
+  vtkDataObject* data, vtkMultiProcessController* controller, int remoteId, int tag)
+{
+  vtkSharedMemoryEncoder encoder;
+  bool valid = data != nullptr && encoder.EncodeDataObject(data);
+
+  std::vector<std::string> names;
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+  for (size_t cc = 0; valid && cc < encoder.Arrays.size(); ++cc)
+  {
+    names.push_back(vtkShareArray(encoder.Arrays[cc]));
+    valid = !names.back().empty();
+  }
+#else
+  valid = false;
+#endif
+
+  vtkMultiProcessStream header;
+  header << (valid ? 1 : 0);
+  if (valid)
+  {
+    header << static_cast<int>(names.size());
+    for (size_t cc = 0; cc < names.size(); ++cc)
+    {
+      vtkDataArray* array = encoder.Arrays[cc];
+      header << names[cc]
+             << static_cast<vtkTypeUInt64>(array->GetDataSize()) * array->GetDataTypeSize();
+    }
+  }
+  controller->Send(header, remoteId, tag);
+  if (!valid)
+  {
+    return false;
+  }
+  controller->Send(encoder.Stream, remoteId, tag);
+
+  // The receiver reports whether it could map the segments. The segments
+  // remain until the arrays of both processes are released.
+  int ack = 0;
+  controller->Receive(&ack, 1, remoteId, tag);
+  return ack != 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSharedMemoryDataTransport::Receive(
+  vtkMultiProcessController* controller, int remoteId, int tag, vtkDataObject*& data)
+{
+  data = nullptr;
+
+  vtkMultiProcessStream header;
+  controller->Receive(header, remoteId, tag);
+  int valid;
+  header >> valid;
+  if (!valid)
+  {
+    return false;
+  }
+  int count;
+  header >> count;
+  std::vector<std::string> names(count);
+  std::vector<vtkTypeUInt64> lengths(count);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    header >> names[cc] >> lengths[cc];
+  }
+
+  vtkMultiProcessStream stream;
+  controller->Receive(stream, remoteId, tag);
+
+  vtkSmartPointer<vtkDataObject> result;
+#if defined(PARAVIEW_SHARED_MEMORY_TRANSPORT_SUPPORTED)
+  std::vector<vtkSharedMapping> mappings(count);
+  bool mapped = vtkSharedMemoryDataTransport::IsAvailable();
+  for (int cc = 0; mapped && cc < count; ++cc)
+  {
+    mappings[cc].Length = static_cast<size_t>(lengths[cc]);
+    mappings[cc].Address = vtkOpenSegment(names[cc], mappings[cc].Length);
+    if (mappings[cc].Address == nullptr)
+    {
+      vtkGenericWarningMacro("Failed to map shared memory segment '"
+        << names[cc] << "'. Falling back to the socket.");
+      mapped = false;
+    }
+  }
+
+  if (mapped)
+  {
+    vtkSharedMemoryDecoder decoder;
+    decoder.Stream = &stream;
+    decoder.Mappings = &mappings;
+    result = decoder.DecodeDataObject();
+  }
+
+  // Mappings wrapped by an array are released with it.
+  for (const vtkSharedMapping& mapping : mappings)
+  {
+    if (mapping.Address != nullptr)
+    {
+      vtkCloseSegment(mapping.Address, mapping.Length);
+    }
+  }
+#endif
+
+  // Let the sender fall back to the socket when the data could not be
+  // decoded from shared memory.
+  int ack = result ? 1 : 0;
+  controller->Send(&ack, 1, remoteId, tag);
+  if (!result)
+  {
+    return false;
+  }
+  result->Register(nullptr);
+  data = result;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSharedMemoryDataTransport::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Available: " << vtkSharedMemoryDataTransport::IsAvailable() << endl;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkSharedMemoryDataTransport.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSharedMemoryDataTransport
+ * @brief   moves data objects between processes on the same host using
+ * POSIX shared memory.
+ *
+ * vtkSharedMemoryDataTransport provides a side channel for socket connections
+ * between processes running on the same host, e.g. a client connected to a
+ * pvserver on the same workstation. Instead of serializing data objects into
+ * the socket, the values of each large data array are moved to a shared
+ * memory segment of their own and only a small description of the data
+ * object (the structure, array names, types and segment names) goes through
+ * the socket. Small arrays are sent along with the description.
+ *
+ * The sending array is made to use the segment in place of its own buffer,
+ * which is released, so the values are only held once. Sending the array
+ * again reuses the segment as long as the array has not been modified. The
+ * receiving process maps the segment and wraps its array directly around the
+ * mapped memory, without copying or parsing it. Both processes map segments
+ * copy-on-write: modifying an array never affects the other process. A
+ * segment is removed once the sending array releases it, and its memory is
+ * reclaimed once the receiving array releases it too. Segments of a process
+ * that is killed before releasing its arrays are left behind in /dev/shm.
+ *
+ * Whether the channel can be used for a connection is negotiated by
+ * vtkTCPNetworkAccessManager when the connection is established (see
+ * Negotiate()): one side creates a small probe segment and the other side
+ * checks that it can read it. This guarantees both processes share the same
+ * shared memory namespace. Set the environment variable
+ * PV_DISABLE_SHARED_MEMORY_TRANSPORT to disable the channel.
+ *
+ * Only vtkPolyData, vtkUnstructuredGrid (without polyhedra), vtkImageData and
+ * vtkMultiBlockDataSet / vtkMultiPieceDataSet of these, with vtkDataArray
+ * attributes using the standard memory layout, are supported. For anything
+ * else Send() returns false after notifying the receiver, and both sides are
+ * expected to fall back to the regular transfer.
+ *
+ * The channel is only available on POSIX platforms.
+*/
+
+#ifndef vtkSharedMemoryDataTransport_h
+#define vtkSharedMemoryDataTransport_h
+
+#include "vtkObject.h"
+#include "vtkPVClientServerCoreCoreModule.h" //needed for exports
+
+class vtkDataObject;
+class vtkMultiProcessController;
+
+class VTKPVCLIENTSERVERCORECORE_EXPORT vtkSharedMemoryDataTransport : public vtkObject
+{
+public:
+  static vtkSharedMemoryDataTransport* New();
+  vtkTypeMacro(vtkSharedMemoryDataTransport, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns true if shared memory transport is supported on this platform and
+   * has not been disabled using the PV_DISABLE_SHARED_MEMORY_TRANSPORT
+   * environment variable.
+   */
+  static bool IsAvailable();
+
+  /**
+   * Negotiates the use of the shared memory channel for the connection
+   * represented by the controller. Must be called on both processes, with
+   * `create_probe` set to true on exactly one of them. Returns true if the
+   * channel has been enabled for the controller.
+   */
+  static bool Negotiate(vtkMultiProcessController* controller, bool create_probe);
+
+  //@{
+  /**
+   * Returns whether the shared memory channel has been negotiated for the
+   * controller. Disable() may be used to stop using it, but must be called on
+   * both sides of the connection.
+   */
+  static bool IsEnabled(vtkMultiProcessController* controller);
+  static void Disable(vtkMultiProcessController* controller);
+  //@}
+
+  /**
+   * Sends the data object through shared memory. The receiving process must
+   * call Receive() with the same tag. Returns false if the data object could
+   * not be sent this way (including when `data` is nullptr, or when the
+   * receiver could not map the segments), in which case the receiver falls
+   * back too and the caller must send the data using the regular path.
+   */
+  static bool Send(
+    vtkDataObject* data, vtkMultiProcessController* controller, int remoteId, int tag);
+
+  /**
+   * Receives a data object sent with Send(). Returns false if the sender fell
+   * back to the regular path, in which case the caller must receive the data
+   * using the regular path. This includes the case where a shared memory
+   * segment could not be mapped: the sender is then told to fall back too.
+   * Otherwise `data` is set to a new data object that the caller must
+   * release.
+   */
+  static bool Receive(
+    vtkMultiProcessController* controller, int remoteId, int tag, vtkDataObject*& data);
+
+protected:
+  vtkSharedMemoryDataTransport();
+  ~vtkSharedMemoryDataTransport() override;
+
+private:
+  vtkSharedMemoryDataTransport(const vtkSharedMemoryDataTransport&) = delete;
+  void operator=(const vtkSharedMemoryDataTransport&) = delete;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "vtkCommand.h"
 #include "vtkObjectFactory.h"
 #include "vtkServerSocket.h"
+#include "vtkSharedMemoryDataTransport.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
@@ -419,6 +420,9 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(
     this->PrintHandshakeError(errorcode, false);
     return NULL;
   }
+  // check if data can be exchanged through shared memory i.e. both processes
+  // are on the same host.
+  vtkSharedMemoryDataTransport::Negotiate(controller, false);
   this->Internals->Controllers.push_back(controller);
   return controller;
 }
@@ -498,6 +502,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(
 
   if (controller)
   {
+    vtkSharedMemoryDataTransport::Negotiate(controller, true);
     this->Internals->Controllers.push_back(controller);
   }
 
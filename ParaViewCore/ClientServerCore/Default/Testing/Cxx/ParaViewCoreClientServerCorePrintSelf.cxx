@@ -74,6 +74,7 @@
 #include "vtkSelectionDeliveryFilter.h"
 #include "vtkSelectionRepresentation.h"
 #include "vtkSession.h"
+#include "vtkSharedMemoryDataTransport.h"
 #include "vtkSpreadSheetRepresentation.h"
 #include "vtkSpreadSheetView.h"
 #include "vtkTCPNetworkAccessManager.h"
@@ -169,6 +170,7 @@ int ParaViewCoreClientServerCorePrintSelf(int, char* [])
   PRINT_SELF(vtkSelectionDeliveryFilter);
   PRINT_SELF(vtkSelectionRepresentation);
   PRINT_SELF(vtkSession);
+  PRINT_SELF(vtkSharedMemoryDataTransport);
   // PRINT_SELF(vtkSessionIterator); Requires process module to have been created.
   PRINT_SELF(vtkSpreadSheetRepresentation);
   // PRINT_SELF(vtkSpreadSheetView);
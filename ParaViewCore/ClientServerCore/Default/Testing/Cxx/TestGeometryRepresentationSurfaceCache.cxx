@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestGeometryRepresentationSurfaceCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkGeometryRepresentation reuses the surfaces it extracted when
+// going back to a time step already shown, only when CacheSurfaces is on.
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkGeometryRepresentation.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector>
+
+namespace
+{
+// A sphere with two time steps.
+class TimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSource* New();
+  vtkTypeMacro(TimeSource, vtkPolyDataAlgorithm);
+
+protected:
+  TimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+    override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[2] = { 0.0, 1.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 2);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeSteps, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+    override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetRadius(1.0 + time);
+    sphere->Update();
+    vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+    output->ShallowCopy(sphere->GetOutput());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSource);
+
+// Gives access to the geometry filter of the representation.
+class TestRepresentation : public vtkGeometryRepresentation
+{
+public:
+  static TestRepresentation* New();
+  vtkTypeMacro(TestRepresentation, vtkGeometryRepresentation);
+  vtkAlgorithm* GetGeometryFilter() { return this->GeometryFilter; }
+};
+vtkStandardNewMacro(TestRepresentation);
+
+void CountExecutions(vtkObject*, unsigned long, void* clientdata, void*)
+{
+  ++*reinterpret_cast<int*>(clientdata);
+}
+
+// Shows the time steps in `times` and returns the number of times the surface
+// was extracted.
+int CountExtractions(bool cacheSurfaces, const std::vector<double>& times)
+{
+  vtkNew<TimeSource> source;
+  vtkNew<TestRepresentation> repr;
+  repr->SetCacheSurfaces(cacheSurfaces);
+  repr->SetInputConnection(source->GetOutputPort());
+
+  int count = 0;
+  vtkNew<vtkCallbackCommand> observer;
+  observer->SetCallback(CountExecutions);
+  observer->SetClientData(&count);
+  repr->GetGeometryFilter()->AddObserver(vtkCommand::EndEvent, observer.Get());
+
+  for (double time : times)
+  {
+    repr->SetUpdateTime(time);
+    repr->Update();
+  }
+  return count;
+}
+}
+
+int TestGeometryRepresentationSurfaceCache(int, char* [])
+{
+  vtkNew<vtkGeometryRepresentation> repr;
+  if (repr->GetCacheSurfaces())
+  {
+    cerr << "ERROR: CacheSurfaces should be off by default." << endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<double> times = { 0.0, 1.0, 0.0, 1.0 };
+  int count = CountExtractions(false, times);
+  if (count != 4)
+  {
+    cerr << "ERROR: surface extracted " << count << " times without cache, expected 4." << endl;
+    return EXIT_FAILURE;
+  }
+
+  count = CountExtractions(true, times);
+  if (count != 2)
+  {
+    cerr << "ERROR: surface extracted " << count << " times with cache, expected 2." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestIncrementalDataInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that gathering information again after some of the blocks of a
+// composite dataset changed reports the changes, while the information for the
+// unchanged blocks is reused.
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVCompositeDataInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetSphere(double value)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("scalars");
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  array->FillComponent(0, value);
+  pd->GetPointData()->AddArray(array.Get());
+  return pd;
+}
+
+bool CheckRange(vtkPVDataInformation* info, const char* name, double min, double max)
+{
+  vtkPVArrayInformation* ainfo = info->GetArrayInformation(name, vtkDataObject::POINT);
+  if (ainfo == nullptr)
+  {
+    cerr << "ERROR: failed to find `" << name << "`." << endl;
+    return false;
+  }
+  double* range = ainfo->GetComponentRange(0);
+  if (range[0] != min || range[1] != max)
+  {
+    cerr << "ERROR: `" << name << "` has range [" << range[0] << ", " << range[1]
+         << "], expected [" << min << ", " << max << "]." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestIncrementalDataInformation(int, char* [])
+{
+  vtkSmartPointer<vtkPolyData> block0 = GetSphere(1.0);
+  vtkSmartPointer<vtkPolyData> block1 = GetSphere(2.0);
+
+  vtkNew<vtkMultiBlockDataSet> data;
+  data->SetBlock(0, block0);
+  data->SetBlock(1, block1);
+
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(data.Get());
+  if (!CheckRange(info.Get(), "scalars", 1.0, 2.0))
+  {
+    return EXIT_FAILURE;
+  }
+  const vtkIdType numberOfPoints = info->GetNumberOfPoints();
+
+  // gathering unchanged data again gives the same information.
+  vtkNew<vtkPVDataInformation> info2;
+  info2->CopyFromObject(data.Get());
+  if (!CheckRange(info2.Get(), "scalars", 1.0, 2.0) ||
+    info2->GetNumberOfPoints() != numberOfPoints)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // modify an array in place in one block and add an array to the other.
+  vtkDoubleArray* scalars =
+    vtkDoubleArray::SafeDownCast(block1->GetPointData()->GetArray("scalars"));
+  scalars->SetValue(0, 10.0);
+  scalars->Modified();
+
+  vtkNew<vtkDoubleArray> other;
+  other->SetName("other");
+  other->SetNumberOfTuples(block0->GetNumberOfPoints());
+  other->FillComponent(0, 5.0);
+  block0->GetPointData()->AddArray(other.Get());
+
+  vtkNew<vtkPVDataInformation> info3;
+  info3->CopyFromObject(data.Get());
+  if (!CheckRange(info3.Get(), "scalars", 1.0, 10.0) || !CheckRange(info3.Get(), "other", 5.0, 5.0))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkPVDataInformation* b1info = info3->GetCompositeDataInformation()->GetDataInformation(1);
+  if (b1info == nullptr || b1info->GetArrayInformation("other", vtkDataObject::POINT) != nullptr)
+  {
+    cerr << "ERROR: block 1 should not have `other`." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // replacing a block is picked up as well.
+  data->SetBlock(1, GetSphere(-3.0));
+  vtkNew<vtkPVDataInformation> info4;
+  info4->CopyFromObject(data.Get());
+  if (!CheckRange(info4.Get(), "scalars", -3.0, 1.0))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
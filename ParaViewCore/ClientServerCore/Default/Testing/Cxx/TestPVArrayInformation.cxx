@@ -18,6 +18,9 @@
 #include "vtkPVArrayInformation.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
+#include <cmath>
+
 vtkSmartPointer<vtkFloatArray> GetPolyData()
 {
   vtkIdType numPts = 101;
@@ -31,8 +34,91 @@ vtkSmartPointer<vtkFloatArray> GetPolyData()
   return array;
 }
 
+// Ranges of arrays large enough to be computed in parallel, including
+// non-finite values, must match the ranges computed serially.
+bool TestLargeArray()
+{
+  const vtkIdType numTuples = 300000;
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(numTuples);
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      array->SetTypedComponent(cc, comp, static_cast<float>((cc % 1000) * (comp + 1) - 500));
+    }
+  }
+  array->SetTypedComponent(10, 0, static_cast<float>(vtkMath::Inf()));
+  array->SetTypedComponent(20, 1, static_cast<float>(vtkMath::Nan()));
+
+  // expected ranges: magnitude first, then each component.
+  double expected[8], expectedFinite[8];
+  for (int cc = 0; cc < 8; cc += 2)
+  {
+    expected[cc] = expectedFinite[cc] = VTK_DOUBLE_MAX;
+    expected[cc + 1] = expectedFinite[cc + 1] = VTK_DOUBLE_MIN;
+  }
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    double squaredSum = 0.0;
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      const double value = array->GetTypedComponent(cc, comp);
+      squaredSum += value * value;
+      if (!vtkMath::IsNan(value))
+      {
+        expected[2 * comp + 2] = std::min(expected[2 * comp + 2], value);
+        expected[2 * comp + 3] = std::max(expected[2 * comp + 3], value);
+      }
+      if (vtkMath::IsFinite(value))
+      {
+        expectedFinite[2 * comp + 2] = std::min(expectedFinite[2 * comp + 2], value);
+        expectedFinite[2 * comp + 3] = std::max(expectedFinite[2 * comp + 3], value);
+      }
+    }
+    if (!vtkMath::IsNan(squaredSum))
+    {
+      expected[0] = std::min(expected[0], std::sqrt(squaredSum));
+      expected[1] = std::max(expected[1], std::sqrt(squaredSum));
+    }
+    if (vtkMath::IsFinite(squaredSum))
+    {
+      expectedFinite[0] = std::min(expectedFinite[0], std::sqrt(squaredSum));
+      expectedFinite[1] = std::max(expectedFinite[1], std::sqrt(squaredSum));
+    }
+  }
+
+  // Run twice: the second pass reuses the ranges cached on the array.
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    vtkNew<vtkPVArrayInformation> info;
+    info->CopyFromObject(array.Get());
+    for (int comp = -1; comp < 3; ++comp)
+    {
+      const double* range = info->GetComponentRange(comp);
+      const double* finiteRange = info->GetComponentFiniteRange(comp);
+      const double* ref = expected + 2 * (comp + 1);
+      const double* finiteRef = expectedFinite + 2 * (comp + 1);
+      if (range[0] != ref[0] || range[1] != ref[1] || finiteRange[0] != finiteRef[0] ||
+        finiteRange[1] != finiteRef[1])
+      {
+        cerr << "ERROR: incorrect range for component " << comp << " of large array: [" << range[0]
+             << ", " << range[1] << "], finite [" << finiteRange[0] << ", " << finiteRange[1]
+             << "]" << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 int TestPVArrayInformation(int, char* [])
 {
+  if (!TestLargeArray())
+  {
+    return EXIT_FAILURE;
+  }
 
   vtkSmartPointer<vtkFloatArray> array = GetPolyData();
 
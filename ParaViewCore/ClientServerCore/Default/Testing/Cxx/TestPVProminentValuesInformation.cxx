@@ -0,0 +1,200 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVProminentValuesInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the values found by vtkPVProminentValuesInformation and that they
+// survive a CopyToStream/CopyFromStream round trip.
+#include "vtkAbstractArray.h"
+#include "vtkClientServerStream.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSmartPointer.h"
+#include "vtkVariant.h"
+
+#include <cstring>
+#include <set>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const vtkIdType NumberOfTuples = 10000;
+
+void SetParameters(vtkPVProminentValuesInformation* info, int numComps, bool force)
+{
+  info->SetFieldAssociation("vtkDataObject::FIELD_ASSOCIATION_POINTS");
+  info->SetFieldName("Values");
+  info->SetNumberOfComponents(numComps);
+  info->SetFraction(0.1);
+  info->SetUncertainty(0.);
+  info->SetForce(force);
+}
+
+// Returns the prominent values of a component, or of the tuples for -1, with
+// the components of each tuple flattened.
+std::set<std::vector<int> > GetValues(vtkPVProminentValuesInformation* info, int component)
+{
+  std::set<std::vector<int> > result;
+  vtkSmartPointer<vtkAbstractArray> values;
+  values.TakeReference(info->GetProminentComponentValues(component));
+  if (!values)
+  {
+    return result;
+  }
+  const int numComps = values->GetNumberOfComponents();
+  for (vtkIdType tuple = 0; tuple < values->GetNumberOfTuples(); ++tuple)
+  {
+    std::vector<int> value(numComps);
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      value[cc] = values->GetVariantValue(tuple * numComps + cc).ToInt();
+    }
+    result.insert(value);
+  }
+  return result;
+}
+
+// A two-component array whose tuples are (k, 10k) for k in [0, 5).
+bool TestDiscrete(vtkPVProminentValuesInformation* info)
+{
+  vtkNew<vtkIntArray> array;
+  array->SetName("Values");
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    const int k = static_cast<int>(cc % 5);
+    array->SetTypedComponent(cc, 0, k);
+    array->SetTypedComponent(cc, 1, 10 * k);
+  }
+  SetParameters(info, 2, false);
+  info->CopyDistinctValuesFromObject(array.GetPointer());
+  expect(info->GetValid(), "discrete values should be valid.");
+
+  std::set<std::vector<int> > first, second, tuples;
+  for (int k = 0; k < 5; ++k)
+  {
+    first.insert(std::vector<int>(1, k));
+    second.insert(std::vector<int>(1, 10 * k));
+    tuples.insert(std::vector<int>{ k, 10 * k });
+  }
+  expect(GetValues(info, 0) == first, "wrong values for component 0.");
+  expect(GetValues(info, 1) == second, "wrong values for component 1.");
+  expect(GetValues(info, -1) == tuples, "wrong tuples.");
+  return true;
+}
+
+// Without Force, an array with more distinct values than MAX_DISCRETE_VALUES
+// has no prominent values.
+bool TestContinuous()
+{
+  vtkNew<vtkIntArray> array;
+  array->SetName("Values");
+  array->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    array->SetValue(cc, static_cast<int>(cc));
+  }
+  vtkNew<vtkPVProminentValuesInformation> info;
+  SetParameters(info.GetPointer(), 1, false);
+  info->CopyDistinctValuesFromObject(array.GetPointer());
+  expect(!info->GetValid(), "continuous values should not be valid.");
+  expect(GetValues(info.GetPointer(), 0).empty(), "continuous values should not be kept.");
+  return true;
+}
+
+// With Force, values making up more than Fraction of the array are found
+// among many values that appear once.
+bool TestForce()
+{
+  vtkNew<vtkIntArray> array;
+  array->SetName("Values");
+  array->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    int value = static_cast<int>(1000 + cc);
+    if (cc % 2 == 0)
+    {
+      value = 0;
+    }
+    else if (cc % 10 < 6)
+    {
+      value = 1;
+    }
+    array->SetValue(cc, value);
+  }
+  vtkNew<vtkPVProminentValuesInformation> info;
+  SetParameters(info.GetPointer(), 1, true);
+  info->CopyDistinctValuesFromObject(array.GetPointer());
+  expect(info->GetValid(), "forced values should be valid.");
+
+  std::set<std::vector<int> > expected;
+  expected.insert(std::vector<int>(1, 0));
+  expected.insert(std::vector<int>(1, 1));
+  expect(GetValues(info.GetPointer(), 0) == expected, "wrong forced values.");
+  return true;
+}
+
+bool TestStream(vtkPVProminentValuesInformation* info)
+{
+  vtkClientServerStream css;
+  info->CopyToStream(&css);
+  vtkNew<vtkPVProminentValuesInformation> other;
+  other->CopyFromStream(&css);
+
+  expect(strcmp(other->GetFieldAssociation(), info->GetFieldAssociation()) == 0,
+    "field association not streamed.");
+  expect(strcmp(other->GetFieldName(), info->GetFieldName()) == 0, "field name not streamed.");
+  expect(other->GetNumberOfComponents() == info->GetNumberOfComponents(),
+    "number of components not streamed.");
+  expect(other->GetFraction() == info->GetFraction(), "fraction not streamed.");
+  expect(other->GetUncertainty() == info->GetUncertainty(), "uncertainty not streamed.");
+  expect(other->GetForce() == info->GetForce(), "force flag not streamed.");
+  expect(other->GetValid() == info->GetValid(), "valid flag not streamed.");
+  for (int component = -1; component < info->GetNumberOfComponents(); ++component)
+  {
+    expect(GetValues(other.GetPointer(), component) == GetValues(info, component),
+      "values of component " << component << " not streamed.");
+  }
+
+  // The counts are not exposed; streaming the copy back must give the same
+  // message.
+  vtkClientServerStream css2;
+  other->CopyToStream(&css2);
+  const unsigned char* data;
+  const unsigned char* data2;
+  size_t length, length2;
+  css.GetData(&data, &length);
+  css2.GetData(&data2, &length2);
+  expect(length == length2 && memcmp(data, data2, length) == 0, "round trip changed the message.");
+  return true;
+}
+}
+
+int TestPVProminentValuesInformation(int, char* [])
+{
+  vtkNew<vtkPVProminentValuesInformation> info;
+  if (!TestDiscrete(info.GetPointer()) || !TestStream(info.GetPointer()) || !TestContinuous() ||
+    !TestForce())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
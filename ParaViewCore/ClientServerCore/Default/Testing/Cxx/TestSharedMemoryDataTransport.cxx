@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSharedMemoryDataTransport.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkSharedMemoryDataTransport round-trips data objects between
+// two socket controllers connected through localhost, that neither side sees
+// the changes made by the other, that modified arrays are sent again, and
+// that both sides fall back when the data is not supported or the receiver
+// cannot map the segments.
+#include "vtkCellArray.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkServerSocket.h"
+#include "vtkSharedMemoryDataTransport.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <thread>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int TAG = 4242;
+const vtkIdType NUMBER_OF_POINTS = 100000;
+
+// Runs the sending side on another thread while the receiving side runs on
+// this one, since both block until the other side answers.
+template <typename SendFunction, typename ReceiveFunction>
+void Exchange(SendFunction send, ReceiveFunction receive)
+{
+  std::thread thread(send);
+  receive();
+  thread.join();
+}
+
+// Sends `data` through shared memory and returns what was received, or
+// nullptr if either side fell back.
+vtkSmartPointer<vtkDataObject> RoundTrip(
+  vtkDataObject* data, vtkMultiProcessController* sender, vtkMultiProcessController* receiver)
+{
+  bool sent = false;
+  bool received = false;
+  vtkDataObject* result = nullptr;
+  Exchange([&]() { sent = vtkSharedMemoryDataTransport::Send(data, sender, 1, TAG); },
+    [&]() { received = vtkSharedMemoryDataTransport::Receive(receiver, 1, TAG, result); });
+  vtkSmartPointer<vtkDataObject> output;
+  output.TakeReference(result);
+  return (sent && received) ? output : nullptr;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> CreateData()
+{
+  // Large enough arrays to go through shared memory, plus a small one that
+  // goes through the socket.
+  auto polydata = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NUMBER_OF_POINTS);
+  vtkNew<vtkDoubleArray> large;
+  large->SetName("large");
+  large->SetNumberOfTuples(NUMBER_OF_POINTS);
+  for (vtkIdType cc = 0; cc < NUMBER_OF_POINTS; ++cc)
+  {
+    points->SetPoint(cc, cc, 2 * cc, 3 * cc);
+    large->SetValue(cc, 0.5 * cc);
+  }
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType cc = 0; cc + 2 < NUMBER_OF_POINTS; cc += 3)
+  {
+    vtkIdType ids[3] = { cc, cc + 1, cc + 2 };
+    polys->InsertNextCell(3, ids);
+  }
+  vtkNew<vtkIntArray> small;
+  small->SetName("small");
+  small->SetNumberOfTuples(4);
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    small->SetValue(cc, cc * cc);
+  }
+  polydata->SetPoints(points);
+  polydata->SetPolys(polys);
+  polydata->GetPointData()->SetScalars(large);
+  polydata->GetFieldData()->AddArray(small);
+
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0, 63, 0, 63, 0, 63);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 0.25, 2);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetValue(cc, static_cast<float>(cc % 1000));
+  }
+  image->GetPointData()->SetScalars(scalars);
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> gridPoints;
+  gridPoints->InsertNextPoint(0, 0, 0);
+  gridPoints->InsertNextPoint(1, 0, 0);
+  gridPoints->InsertNextPoint(0, 1, 0);
+  gridPoints->InsertNextPoint(0, 0, 1);
+  grid->SetPoints(gridPoints);
+  vtkIdType tetra[4] = { 0, 1, 2, 3 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+
+  auto data = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  data->SetBlock(0, polydata);
+  data->SetBlock(1, image);
+  data->SetBlock(2, grid);
+  data->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "image");
+  return data;
+}
+
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  return a && b && a->GetDataType() == b->GetDataType() &&
+    a->GetNumberOfTuples() == b->GetNumberOfTuples() &&
+    a->GetNumberOfComponents() == b->GetNumberOfComponents() &&
+    memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+      static_cast<size_t>(a->GetDataSize()) * a->GetDataTypeSize()) == 0;
+}
+
+// Compares the received data with the expected one, array by array.
+int Compare(vtkMultiBlockDataSet* expected, vtkDataObject* output)
+{
+  vtkMultiBlockDataSet* received = vtkMultiBlockDataSet::SafeDownCast(output);
+  expect(received && received->GetNumberOfBlocks() == 3, "expected a multiblock of 3 blocks.");
+
+  vtkPolyData* pd0 = vtkPolyData::SafeDownCast(expected->GetBlock(0));
+  vtkPolyData* pd1 = vtkPolyData::SafeDownCast(received->GetBlock(0));
+  expect(pd1 != nullptr, "block 0 is not a vtkPolyData.");
+  expect(SameValues(pd0->GetPoints()->GetData(), pd1->GetPoints()->GetData()),
+    "the points of the polydata differ.");
+  expect(pd1->GetNumberOfPolys() == pd0->GetNumberOfPolys() &&
+      SameValues(pd0->GetPolys()->GetData(), pd1->GetPolys()->GetData()),
+    "the polygons of the polydata differ.");
+  expect(SameValues(pd0->GetPointData()->GetArray("large"), pd1->GetPointData()->GetScalars()),
+    "the point scalars of the polydata differ.");
+  vtkFieldData* fd0 = pd0->GetFieldData();
+  vtkFieldData* fd1 = pd1->GetFieldData();
+  expect(SameValues(fd0->GetArray("small"), fd1->GetArray("small")),
+    "the field data of the polydata differs.");
+
+  vtkImageData* id0 = vtkImageData::SafeDownCast(expected->GetBlock(1));
+  vtkImageData* id1 = vtkImageData::SafeDownCast(received->GetBlock(1));
+  expect(id1 != nullptr, "block 1 is not a vtkImageData.");
+  int ext[6];
+  id1->GetExtent(ext);
+  expect(ext[1] == 63 && ext[3] == 63 && ext[5] == 63, "the extent of the image differs.");
+  expect(id1->GetOrigin()[2] == 3 && id1->GetSpacing()[1] == 0.25,
+    "the geometry of the image differs.");
+  expect(SameValues(id0->GetPointData()->GetScalars(), id1->GetPointData()->GetScalars()),
+    "the scalars of the image differ.");
+  expect(received->HasMetaData(1u) &&
+      strcmp(received->GetMetaData(1u)->Get(vtkCompositeDataSet::NAME()), "image") == 0,
+    "the name of block 1 was lost.");
+
+  vtkUnstructuredGrid* ug1 = vtkUnstructuredGrid::SafeDownCast(received->GetBlock(2));
+  expect(ug1 != nullptr && ug1->GetNumberOfPoints() == 4 && ug1->GetNumberOfCells() == 1 &&
+      ug1->GetCellType(0) == VTK_TETRA,
+    "the unstructured grid differs.");
+  return EXIT_SUCCESS;
+}
+
+vtkDataArray* GetLarge(vtkDataObject* data)
+{
+  vtkDataObject* block = vtkMultiBlockDataSet::SafeDownCast(data)->GetBlock(0);
+  return vtkPolyData::SafeDownCast(block)->GetPointData()->GetArray("large");
+}
+
+vtkDataArray* GetImageScalars(vtkDataObject* data)
+{
+  vtkDataObject* block = vtkMultiBlockDataSet::SafeDownCast(data)->GetBlock(1);
+  return vtkImageData::SafeDownCast(block)->GetPointData()->GetScalars();
+}
+}
+
+int TestSharedMemoryDataTransport(int, char* [])
+{
+  vtkNew<vtkServerSocket> server;
+  expect(server->CreateServer(0) == 0, "failed to create a server socket.");
+  const int port = server->GetServerPort();
+  vtkNew<vtkSocketController> sender;
+  vtkNew<vtkSocketController> receiver;
+  int connected = 0;
+  int accepted = 0;
+  Exchange(
+    [&]() {
+      accepted = vtkSocketCommunicator::SafeDownCast(sender->GetCommunicator())
+                   ->WaitForConnection(server, 10000);
+    },
+    [&]() {
+      connected = vtkSocketCommunicator::SafeDownCast(receiver->GetCommunicator())
+                    ->ConnectTo("localhost", port);
+    });
+  expect(accepted && connected, "failed to connect through localhost.");
+
+  bool negotiated[2] = { false, false };
+  Exchange([&]() { negotiated[0] = vtkSharedMemoryDataTransport::Negotiate(sender, true); },
+    [&]() { negotiated[1] = vtkSharedMemoryDataTransport::Negotiate(receiver, false); });
+  expect(negotiated[0] == negotiated[1], "both sides did not agree on the negotiation.");
+  if (!vtkSharedMemoryDataTransport::IsAvailable())
+  {
+    expect(!negotiated[0], "the transport was enabled on an unsupported platform.");
+    return EXIT_SUCCESS;
+  }
+  expect(negotiated[0] && vtkSharedMemoryDataTransport::IsEnabled(sender) &&
+      vtkSharedMemoryDataTransport::IsEnabled(receiver),
+    "the transport was not enabled between processes on the same host.");
+
+  vtkSmartPointer<vtkMultiBlockDataSet> data = CreateData();
+  vtkNew<vtkMultiBlockDataSet> expected;
+  expected->DeepCopy(data);
+
+  vtkSmartPointer<vtkDataObject> output = RoundTrip(data, sender, receiver);
+  expect(output != nullptr, "the data was not sent through shared memory.");
+  if (Compare(expected, output) != EXIT_SUCCESS || Compare(expected, data) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Changes made by one side do not reach the other one.
+  vtkDataArray* sent = GetLarge(data);
+  vtkDataArray* received = GetLarge(output);
+  received->SetComponent(0, 0, -1.0);
+  expect(sent->GetComponent(0, 0) == 0.0, "the receiver modified the values of the sender.");
+  sent->SetComponent(1, 0, -2.0);
+  sent->Modified();
+  expect(received->GetComponent(1, 0) == 0.5, "the sender modified the values of the receiver.");
+
+  // Unmodified arrays keep their segment, while modified ones are sent again.
+  void* image = GetImageScalars(data)->GetVoidPointer(0);
+  output = RoundTrip(data, sender, receiver);
+  expect(output != nullptr, "the data was not sent again through shared memory.");
+  expect(
+    GetImageScalars(data)->GetVoidPointer(0) == image, "an unmodified array was copied again.");
+  expect(GetLarge(output)->GetComponent(1, 0) == -2.0, "a modified array was not sent again.");
+  expect(GetLarge(output)->GetComponent(0, 0) == 0.0, "the values sent again are wrong.");
+
+  // Unsupported data objects fall back to the regular path on both sides.
+  vtkNew<vtkStructuredGrid> structured;
+  expect(RoundTrip(structured, sender, receiver) == nullptr,
+    "a vtkStructuredGrid was sent through shared memory.");
+
+  // So does a receiver that cannot map the segments.
+  vtksys::SystemTools::PutEnv("PV_DISABLE_SHARED_MEMORY_TRANSPORT=1");
+  output = RoundTrip(data, sender, receiver);
+  vtksys::SystemTools::UnPutEnv("PV_DISABLE_SHARED_MEMORY_TRANSPORT");
+  expect(output == nullptr, "a receiver that could not map the segments reported success.");
+  vtkDataObject* fallback = nullptr;
+  Exchange([&]() { sender->Send(data, 1, TAG); },
+    [&]() { fallback = receiver->ReceiveDataObject(1, TAG); });
+  output.TakeReference(fallback);
+  expect(output != nullptr, "the socket was left in a bad state by the fallback.");
+  expect(
+    GetLarge(output)->GetComponent(1, 0) == -2.0, "the data sent after the fallback is wrong.");
+
+  sender->CloseConnection();
+  receiver->CloseConnection();
+  return EXIT_SUCCESS;
+}
@@ -235,6 +235,9 @@ int vtkChartRepresentation::RequestData(
       vtkNew<vtkPVMergeTablesMultiBlock> algo;
       reductionFilter->SetPostGatherHelper(algo.GetPointer());
       reductionFilter->SetController(pm->GetGlobalController());
+      // merging tables is associative: reduce along a binary tree so that the
+      // root does not receive the tables of all processes at once.
+      reductionFilter->SetTreeFanIn(2);
       reductionFilter->SetInputData(data);
       reductionFilter->Update();
 
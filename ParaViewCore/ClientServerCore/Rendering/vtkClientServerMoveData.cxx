@@ -29,6 +29,7 @@
 #include "vtkProcessModule.h"
 #include "vtkSelection.h"
 #include "vtkSelectionSerializer.h"
+#include "vtkSharedMemoryDataTransport.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -210,6 +211,14 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
+  // When the client runs on the same host, avoid serializing the data through
+  // the socket.
+  if (vtkSharedMemoryDataTransport::IsEnabled(controller) &&
+    vtkSharedMemoryDataTransport::Send(
+      input, controller, 1, vtkClientServerMoveData::TRANSMIT_SHARED_MEMORY))
+  {
+    return 1;
+  }
   return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
 }
 
@@ -237,7 +246,9 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
     delete[] xml;
     data = sel;
   }
-  else
+  else if (!vtkSharedMemoryDataTransport::IsEnabled(controller) ||
+    !vtkSharedMemoryDataTransport::Receive(
+      controller, 1, vtkClientServerMoveData::TRANSMIT_SHARED_MEMORY, data))
   {
     data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
   }
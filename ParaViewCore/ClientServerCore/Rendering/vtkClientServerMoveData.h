@@ -120,7 +120,8 @@ protected:
 
   enum Tags
   {
-    TRANSMIT_DATA_OBJECT = 23483
+    TRANSMIT_DATA_OBJECT = 23483,
+    TRANSMIT_SHARED_MEMORY = 23484
   };
 
   int OutputDataType;
@@ -17,11 +17,15 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkBoundingBox.h"
+#include "vtkCacheSizeKeeper.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCommand.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkCompositePolyDataMapper2.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -40,6 +44,8 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVUpdateSuppressor.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
@@ -49,6 +55,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #if VTK_MODULE_ENABLE_VTK_RenderingOSPRay
 #include "vtkOSPRayActorNode.h"
@@ -57,10 +64,334 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <atomic>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+//*****************************************************************************
+// Keeps the outputs of the geometry filter for each input time step. Entries
+// are valid for a given state of the upstream pipeline and of the geometry
+// filter, and are reported to the vtkCacheSizeKeeper.
+class vtkGeometryRepresentation::vtkSurfaceCache
+{
+public:
+  struct KeyType
+  {
+    vtkMTimeType PipelineMTime;
+    vtkMTimeType FilterMTime;
+    bool HasTime;
+    double Time;
+  };
+
+  ~vtkSurfaceCache() { this->Clear(); }
+
+  vtkDataObject* Find(const KeyType& key)
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end(); ++iter)
+    {
+      if (this->IsSameState(iter->Key, key) && iter->Key.HasTime == key.HasTime &&
+        (!key.HasTime || iter->Key.Time == key.Time))
+      {
+        // most recently used first.
+        this->Entries.splice(this->Entries.begin(), this->Entries, iter);
+        return this->Entries.front().Surface;
+      }
+    }
+    return nullptr;
+  }
+
+  void Insert(const KeyType& key, vtkDataObject* surface)
+  {
+    // surfaces extracted from an older state cannot be used anymore.
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      auto current = iter++;
+      if (!this->IsSameState(current->Key, key))
+      {
+        this->Erase(current);
+      }
+    }
+
+    vtkCacheSizeKeeper* keeper = vtkCacheSizeKeeper::GetInstance();
+    const unsigned long size = surface->GetActualMemorySize();
+    while (!this->Entries.empty() &&
+      (keeper->GetCacheFull() || keeper->GetCacheSize() + size > keeper->GetCacheLimit()))
+    {
+      this->Erase(std::prev(this->Entries.end()));
+    }
+    if (keeper->GetCacheFull() || keeper->GetCacheSize() + size > keeper->GetCacheLimit())
+    {
+      return;
+    }
+
+    vtkSmartPointer<vtkDataObject> clone;
+    clone.TakeReference(surface->NewInstance());
+    clone->ShallowCopy(surface);
+    this->Entries.push_front(EntryType{ key, clone, size });
+    keeper->AddCacheSize(size);
+  }
+
+  void Clear()
+  {
+    while (!this->Entries.empty())
+    {
+      this->Erase(this->Entries.begin());
+    }
+  }
+
+private:
+  struct EntryType
+  {
+    KeyType Key;
+    vtkSmartPointer<vtkDataObject> Surface;
+    unsigned long Size;
+  };
+
+  bool IsSameState(const KeyType& a, const KeyType& b) const
+  {
+    return a.PipelineMTime == b.PipelineMTime && a.FilterMTime == b.FilterMTime;
+  }
+
+  void Erase(std::list<EntryType>::iterator iter)
+  {
+    vtkCacheSizeKeeper::GetInstance()->FreeCacheSize(iter->Size);
+    this->Entries.erase(iter);
+  }
+
+  std::list<EntryType> Entries;
+};
+
+//*****************************************************************************
+// Builds the LOD geometry progressively. A very coarse LOD is built right
+// away, then finer ones are built on a background thread up to the requested
+// resolution, each one replacing the previous one once complete. The builder
+// works on shallow copies of the leaves of the input so that the pipeline can
+// keep executing meanwhile.
+class vtkGeometryRepresentation::vtkLODBuilder
+{
+public:
+  vtkLODBuilder()
+    : InputMTime(0)
+    , Factor(-1.0)
+    , Abort(false)
+    , Running(false)
+    , Current(nullptr)
+  {
+  }
+
+  ~vtkLODBuilder() { this->Cancel(); }
+
+  // Returns the finest LOD of `input` ready for `factor`, starting to build
+  // it if needed. `pending` is set when a finer LOD is still being built.
+  vtkDataObject* GetLOD(vtkDataObject* input, double factor, bool& pending)
+  {
+    if (input != this->Input.GetPointer() || input->GetMTime() != this->InputMTime ||
+      factor != this->Factor)
+    {
+      this->Start(input, factor);
+    }
+
+    bool running;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (!this->Completed.empty())
+      {
+        this->LOD = this->Assemble(this->Completed);
+        this->Completed.clear();
+      }
+      running = this->Running;
+    }
+    if (!running && this->Thread.joinable())
+    {
+      this->Thread.join();
+      this->Leaves.clear();
+    }
+    pending = running;
+    return this->LOD;
+  }
+
+  void Cancel()
+  {
+    if (this->Thread.joinable())
+    {
+      this->Abort = true;
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        if (this->Current)
+        {
+          this->Current->SetAbortExecute(1);
+        }
+      }
+      this->Thread.join();
+    }
+    this->Abort = false;
+    this->Running = false;
+    this->Completed.clear();
+    this->Leaves.clear();
+  }
+
+private:
+  typedef std::vector<vtkSmartPointer<vtkPolyData> > LevelType;
+
+  void Start(vtkDataObject* input, double factor)
+  {
+    this->Cancel();
+    this->Input = input;
+    this->InputMTime = input->GetMTime();
+    this->Factor = factor;
+    this->Structure = nullptr;
+
+    vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(input);
+    if (cd)
+    {
+      this->Structure.TakeReference(cd->NewInstance());
+      this->Structure->CopyStructure(cd);
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      iter->SkipEmptyNodesOff();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->Leaves.push_back(this->CopyLeaf(iter->GetCurrentDataObject()));
+      }
+    }
+    else
+    {
+      this->Leaves.push_back(this->CopyLeaf(input));
+    }
+
+    // the coarsest LOD is cheap enough to be built right away.
+    this->LOD = this->Assemble(this->Decimate(0.0));
+
+    std::vector<double> factors;
+    if (factor >= 0.4)
+    {
+      factors.push_back(0.5 * factor);
+    }
+    if (factor > 0.0)
+    {
+      factors.push_back(factor);
+    }
+    if (!factors.empty())
+    {
+      this->Running = true;
+      this->Thread = std::thread(&vtkLODBuilder::Run, this, factors);
+    }
+    else
+    {
+      this->Leaves.clear();
+    }
+  }
+
+  vtkSmartPointer<vtkPolyData> CopyLeaf(vtkDataObject* leaf)
+  {
+    vtkPolyData* pd = vtkPolyData::SafeDownCast(leaf);
+    if (pd == nullptr)
+    {
+      return nullptr;
+    }
+    // the copy builds its own cells and has its own points, so that nothing
+    // shared with the pipeline is modified from the background thread, e.g.
+    // the cached bounds of the points. The attribute arrays are only read.
+    vtkNew<vtkPolyData> copy;
+    copy->ShallowCopy(pd);
+    copy->DeleteCells();
+    if (pd->GetPoints())
+    {
+      vtkNew<vtkPoints> points;
+      points->DeepCopy(pd->GetPoints());
+      copy->SetPoints(points.GetPointer());
+    }
+    return copy.GetPointer();
+  }
+
+  LevelType Decimate(double factor)
+  {
+    LevelType level(this->Leaves.size());
+    for (size_t cc = 0; cc < this->Leaves.size() && !this->Abort; ++cc)
+    {
+      if (!this->Leaves[cc])
+      {
+        continue;
+      }
+      vtkNew<vtkGeometryRepresentation_detail::DecimationFilterType> decimator;
+      decimator->SetLODFactor(factor);
+      decimator->SetInputData(this->Leaves[cc]);
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Current = decimator.GetPointer();
+      }
+      decimator->Update();
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Current = nullptr;
+      }
+      level[cc] = vtkPolyData::SafeDownCast(decimator->GetOutputDataObject(0));
+    }
+    return level;
+  }
+
+  void Run(std::vector<double> factors)
+  {
+    for (double factor : factors)
+    {
+      LevelType level = this->Decimate(factor);
+      if (this->Abort)
+      {
+        break;
+      }
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Completed = level;
+    }
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Running = false;
+  }
+
+  vtkSmartPointer<vtkDataObject> Assemble(const LevelType& level)
+  {
+    if (!this->Structure)
+    {
+      return level.empty() ? nullptr : level[0].GetPointer();
+    }
+    vtkSmartPointer<vtkCompositeDataSet> lod;
+    lod.TakeReference(this->Structure->NewInstance());
+    lod->CopyStructure(this->Structure);
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(lod->NewIterator());
+    iter->SkipEmptyNodesOff();
+    size_t cc = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal() && cc < level.size();
+         iter->GoToNextItem(), ++cc)
+    {
+      if (level[cc])
+      {
+        lod->SetDataSet(iter, level[cc]);
+      }
+    }
+    return lod;
+  }
+
+  // the input the LOD is built for.
+  vtkWeakPointer<vtkDataObject> Input;
+  vtkMTimeType InputMTime;
+  double Factor;
+  vtkSmartPointer<vtkCompositeDataSet> Structure;
+  LevelType Leaves;
+  vtkSmartPointer<vtkDataObject> LOD;
+
+  // state shared with the background thread.
+  std::thread Thread;
+  std::mutex Mutex;
+  std::atomic<bool> Abort;
+  bool Running;
+  vtkAlgorithm* Current;
+  LevelType Completed;
+};
+
 //*****************************************************************************
 // This is used to convert a vtkPolyData to a vtkMultiBlockDataSet. If input is
 // vtkMultiBlockDataSet, then this is simply a pass-through filter. This makes
@@ -202,11 +533,19 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
 
   this->UseShaderReplacements = false;
   this->ShaderReplacementsString = "";
+
+  this->CacheSurfaces = false;
+  this->SurfaceCache = new vtkSurfaceCache();
+
+  this->ProgressiveLOD = false;
+  this->LODBuilder = new vtkLODBuilder();
 }
 
 //----------------------------------------------------------------------------
 vtkGeometryRepresentation::~vtkGeometryRepresentation()
 {
+  delete this->LODBuilder;
+  delete this->SurfaceCache;
   this->CacheKeeper->Delete();
   this->GeometryFilter->Delete();
   this->MultiBlockMaker->Delete();
@@ -362,19 +701,39 @@ int vtkGeometryRepresentation::ProcessViewRequest(
         // new geometry.
         this->LODOutlineFilter->Modified();
 
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+        if (this->ProgressiveLOD)
         {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
+          // Provide the finest LOD built so far and let the view know if a
+          // finer one is on its way.
+          const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+            ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+            : 0.5;
+          this->CacheKeeper->Update();
+          bool pending = false;
+          vtkDataObject* lod =
+            this->LODBuilder->GetLOD(this->CacheKeeper->GetOutputDataObject(0), factor, pending);
+          if (pending)
+          {
+            outInfo->Set(vtkPVRenderView::LOD_REFINEMENT_PENDING(), 1);
+          }
+          vtkPVRenderView::SetPieceLOD(inInfo, this, lod);
+        }
+        else
+        {
+          if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+          {
+            // We handle this number differently depending on decimator
+            // implementation.
+            const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
+            this->Decimator->SetLODFactor(factor);
+          }
+
+          this->Decimator->Update();
+
+          // Pass along the LOD geometry to the view so that it can deliver it to
+          // the rendering node as and when needed.
+          vtkPVRenderView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
         }
-
-        this->Decimator->Update();
-
-        // Pass along the LOD geometry to the view so that it can deliver it to
-        // the rendering node as and when needed.
-        vtkPVRenderView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
       }
     }
   }
@@ -470,8 +829,66 @@ int vtkGeometryRepresentation::RequestData(
     vtkNew<vtkMultiBlockDataSet> placeholder;
     this->GeometryFilter->SetInputDataObject(0, placeholder.GetPointer());
   }
+
+  // Reuse the surface extracted earlier for the same input, if any.
+  vtkSurfaceCache::KeyType surfaceKey = { 0, 0, false, 0.0 };
+  bool cacheSurface = false;
+  // when the cache keeper provides the data, the geometry filter does not
+  // execute.
+  if (this->CacheSurfaces && !this->GetUsingCacheForUpdate() &&
+    inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkDataObject* input = vtkDataObject::GetData(inInfo);
+    vtkAlgorithmOutput* inputPort = this->GetInputConnection(0, 0);
+    vtkDemandDrivenPipeline* inputExecutive = inputPort
+      ? vtkDemandDrivenPipeline::SafeDownCast(inputPort->GetProducer()->GetExecutive())
+      : nullptr;
+    if (input && inputExecutive)
+    {
+      surfaceKey.PipelineMTime = inputExecutive->GetPipelineMTime();
+      surfaceKey.FilterMTime = this->GeometryFilter->GetMTime();
+      surfaceKey.HasTime = input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()) != 0;
+      surfaceKey.Time =
+        surfaceKey.HasTime ? input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) : 0.0;
+      cacheSurface = true;
+    }
+  }
+  vtkDataObject* cachedSurface = cacheSurface ? this->SurfaceCache->Find(surfaceKey) : nullptr;
+
+  // vtkPVGeometryFilter communicates between processes, so the cached
+  // surfaces can only be used if all processes have theirs.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (this->CacheSurfaces && controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int found = cachedSurface ? 1 : 0;
+    int allFound = 0;
+    controller->AllReduce(&found, &allFound, 1, vtkCommunicator::MIN_OP);
+    if (!allFound)
+    {
+      cachedSurface = nullptr;
+    }
+  }
+  if (cachedSurface)
+  {
+    this->MultiBlockMaker->SetInputDataObject(0, cachedSurface);
+  }
+  else
+  {
+    this->MultiBlockMaker->SetInputConnection(this->GeometryFilter->GetOutputPort());
+  }
+  if (!this->CacheSurfaces)
+  {
+    this->SurfaceCache->Clear();
+  }
+
   this->CacheKeeper->Update();
 
+  if (cacheSurface && !cachedSurface)
+  {
+    this->SurfaceCache->Insert(surfaceKey, this->GeometryFilter->GetOutputDataObject(0));
+  }
+
   // HACK: To overcome issue with PolyDataMapper (OpenGL2). It doesn't recreate
   // VBO/IBOs when using data from cache. I suspect it's because the blocks in
   // the MB dataset have older MTime.
@@ -701,6 +1118,8 @@ void vtkGeometryRepresentation::SetVisibility(bool val)
 void vtkGeometryRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheSurfaces: " << this->CacheSurfaces << endl;
+  os << indent << "ProgressiveLOD: " << this->ProgressiveLOD << endl;
 }
 
 //****************************************************************************
@@ -47,7 +47,7 @@ class vtkTexture;
 
 namespace vtkGeometryRepresentation_detail
 {
-// This is defined to either vtkQuadricClustering or vtkmLevelOfDetail in the
+// This is defined to either vtkPVQuadricClustering or vtkmLevelOfDetail in the
 // implementation file:
 class DecimationFilterType;
 }
@@ -295,6 +295,38 @@ public:
    */
   virtual void SetShaderReplacements(const char*);
 
+  //@{
+  /**
+   * When on, the surfaces extracted from the input are kept for each input
+   * time step, so that they are reused instead of being extracted again when
+   * the representation is updated without changes to the input or to the
+   * geometry filter, e.g. after changing rendering properties, or when going
+   * back to a time step already shown. Only the surfaces for the current state
+   * of the upstream pipeline are kept, and their total size is bounded by the
+   * vtkCacheSizeKeeper limit, which is shared with the animation cache. In
+   * parallel, the cached surfaces are used only if all processes have theirs.
+   * Off by default.
+   */
+  vtkSetMacro(CacheSurfaces, bool);
+  vtkGetMacro(CacheSurfaces, bool);
+  vtkBooleanMacro(CacheSurfaces, bool);
+  //@}
+
+  //@{
+  /**
+   * When on, the LOD geometry is built progressively: a very coarse LOD is
+   * provided right after the data changes, while finer ones up to the LOD
+   * resolution requested by the view are built on a background thread. The
+   * view uses the finest LOD built so far for interactive renders, and
+   * renders again while finer ones are pending. When off (default), the LOD
+   * is built at the requested resolution before it is provided, so that
+   * interactive renders look the same as in earlier versions.
+   */
+  vtkSetMacro(ProgressiveLOD, bool);
+  vtkGetMacro(ProgressiveLOD, bool);
+  vtkBooleanMacro(ProgressiveLOD, bool);
+  //@}
+
 protected:
   vtkGeometryRepresentation();
   ~vtkGeometryRepresentation() override;
@@ -417,6 +449,14 @@ protected:
   std::unordered_map<unsigned int, double> BlockOpacities;
   std::unordered_map<unsigned int, std::array<double, 3> > BlockColors;
 
+  bool CacheSurfaces;
+  class vtkSurfaceCache;
+  vtkSurfaceCache* SurfaceCache;
+
+  bool ProgressiveLOD;
+  class vtkLODBuilder;
+  vtkLODBuilder* LODBuilder;
+
 private:
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
@@ -14,7 +14,7 @@
 =========================================================================*/
 
 // We'll use the VTKm decimation filter if TBB is enabled, otherwise we'll
-// fallback to vtkQuadricClustering, since vtkmLevelOfDetail is slow on the
+// fallback to vtkPVQuadricClustering, since vtkmLevelOfDetail is slow on the
 // serial backend.
 #ifndef __VTK_WRAP__
 #if VTK_MODULE_ENABLE_VTK_vtkm
@@ -47,19 +47,18 @@ public:
 vtkStandardNewMacro(DecimationFilterType)
 }
 #else // VTKM_ENABLE_TBB
-#include "vtkQuadricClustering.h"
+#include "vtkPVQuadricClustering.h"
 namespace vtkGeometryRepresentation_detail
 {
-class DecimationFilterType : public vtkQuadricClustering
+class DecimationFilterType : public vtkPVQuadricClustering
 {
 public:
   static DecimationFilterType* New();
-  vtkTypeMacro(DecimationFilterType, vtkQuadricClustering)
+  vtkTypeMacro(DecimationFilterType, vtkPVQuadricClustering)
 
-    // This version gets slower as the grid increases, while the VTKM version
-    // scales with number of points. This means we can get away with a much finer
-    // grid with the VTKM filter, so we'll just reduce the mesh quality a bit
-    // here.
+    // vtkPVQuadricClustering only stores the occupied bins, but finer grids
+    // still produce larger LOD geometries to deliver and render, so we keep the
+    // grid size used with vtkQuadricClustering.
     void SetLODFactor(double factor)
   {
     factor = vtkMath::ClampValue(factor, 0., 1.);
@@ -71,13 +70,6 @@ public:
     int divs = static_cast<int>(150 * factor) + 10;
     this->SetNumberOfDivisions(divs, divs, divs);
   }
-
-  DecimationFilterType()
-  {
-    this->SetUseInputPoints(1);
-    this->SetCopyCellData(1);
-    this->SetUseInternalTriangles(0);
-  }
 };
 vtkStandardNewMacro(DecimationFilterType)
 }
@@ -42,6 +42,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
+#include "vtkSharedMemoryDataTransport.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
@@ -928,6 +929,13 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
   {
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
+    if (vtkSharedMemoryDataTransport::IsEnabled(this->ClientDataServerSocketController) &&
+      vtkSharedMemoryDataTransport::Send(output, this->ClientDataServerSocketController, 1, 23493))
+    {
+      // client is on the same host and received the data through shared memory.
+      vtkTimerLog::MarkEndEvent("Dataserver sending to client");
+      return;
+    }
     this->ClearBuffer();
     this->MarshalDataToBuffer(output);
     this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
@@ -952,6 +960,18 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
 
+  vtkDataObject* shared = nullptr;
+  if (vtkSharedMemoryDataTransport::IsEnabled(this->ClientDataServerSocketController) &&
+    vtkSharedMemoryDataTransport::Receive(this->ClientDataServerSocketController, 1, 23493, shared))
+  {
+    std::vector<vtkSmartPointer<vtkDataObject> > pieces;
+    unsetGlobalIdsAttribute(shared);
+    pieces.push_back(shared);
+    shared->Delete();
+    vtkMPIMoveDataMerge(pieces, output);
+    return;
+  }
+
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
   this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
@@ -15,11 +15,13 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkPVConfig.h"
+#include "vtkSMPTools.h"
 #include "vtkSquirtCompressor.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
@@ -27,9 +29,18 @@
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
 #include <assert.h>
 #include <sstream>
 
+namespace
+{
+// Minimum number of image rows per band when the number of bands is chosen
+// automatically. Smaller bands hurt the compression ratio more than they help
+// the compression time.
+const int MIN_ROWS_PER_BAND = 64;
+}
+
 vtkStandardNewMacro(vtkPVClientServerSynchronizedRenderers);
 vtkCxxSetObjectMacro(vtkPVClientServerSynchronizedRenderers, Compressor, vtkImageCompressor);
 //----------------------------------------------------------------------------
@@ -37,6 +48,7 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(NULL)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , NumberOfCompressionBands(0)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -65,6 +77,8 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
     {
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
+      // header[0] is the number of bands the server compressed the image in.
+      this->Compressor->SetNumberOfBands(header[0]);
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
@@ -103,8 +117,21 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
 
   vtkRawImage& rawImage = this->CaptureRenderedImage();
 
+  int numBands = 1;
+  if (this->Compressor && rawImage.IsValid())
+  {
+    numBands = this->NumberOfCompressionBands;
+    if (numBands == 0)
+    {
+      numBands = std::min(vtkSMPTools::GetEstimatedNumberOfThreads(),
+        rawImage.GetHeight() / MIN_ROWS_PER_BAND);
+    }
+    numBands = std::max(1, std::min(numBands, 256));
+    this->Compressor->SetNumberOfBands(numBands);
+  }
+
   int header[4];
-  header[0] = rawImage.IsValid() ? 1 : 0;
+  header[0] = rawImage.IsValid() ? numBands : 0;
   header[1] = rawImage.GetWidth();
   header[2] = rawImage.GetHeight();
   header[3] = rawImage.IsValid() ? rawImage.GetRawPtr()->GetNumberOfComponents() : 0;
@@ -190,6 +217,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkDeltaImageCompressor")
+    {
+      comp = vtkDeltaImageCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
@@ -231,6 +262,26 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SetRenderer(vtkRenderer* ren)
+{
+  if (this->Renderer != ren)
+  {
+    // the previous frame belongs to a different view.
+    this->ResetCompressor();
+  }
+  this->Superclass::SetRenderer(ren);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::ResetCompressor()
+{
+  if (vtkDeltaImageCompressor* delta = vtkDeltaImageCompressor::SafeDownCast(this->Compressor))
+  {
+    delta->Reset();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::PushImageToScreen()
 {
@@ -255,4 +306,5 @@ void vtkPVClientServerSynchronizedRenderers::PushImageToScreen()
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfCompressionBands: " << this->NumberOfCompressionBands << endl;
 }
@@ -28,6 +28,7 @@
 #include "vtkSynchronizedRenderers.h"
 
 class vtkImageCompressor;
+class vtkRenderer;
 class vtkUnsignedCharArray;
 
 class VTKPVCLIENTSERVERCORERENDERING_EXPORT vtkPVClientServerSynchronizedRenderers
@@ -52,6 +53,19 @@ public:
   vtkSetMacro(NVPipeSupport, bool);
   vtkGetMacro(NVPipeSupport, bool);
 
+  //@{
+  /**
+   * Set the number of horizontal bands the image is split into so that it can
+   * be compressed on multiple threads (see vtkImageCompressor::SetNumberOfBands).
+   * 0 (default) picks the number of bands based on the number of threads
+   * available to vtkSMPTools and the image height. 1 disables band-parallel
+   * compression. This only needs to be set on the rendering server, the number
+   * of bands used is sent to the client along with every image.
+   */
+  vtkSetClampMacro(NumberOfCompressionBands, int, 0, 256);
+  vtkGetMacro(NumberOfCompressionBands, int);
+  //@}
+
   /**
    * Set and configure a compressor from it's own configuration stream. This
    * is used by ParaView to configure the compressor from application wide
@@ -59,6 +73,19 @@ public:
    */
   virtual void ConfigureCompressor(const char* stream);
 
+  /**
+   * Discard any state the compressor keeps between frames so that the next
+   * image is sent in full. This is only relevant for vtkDeltaImageCompressor,
+   * which otherwise only sends the tiles that changed since the previous
+   * frame. Resolution changes are already handled by the compressor itself.
+   */
+  void ResetCompressor();
+
+  /**
+   * Overridden to reset the compressor when the renderer changes.
+   */
+  void SetRenderer(vtkRenderer*) override;
+
 protected:
   vtkPVClientServerSynchronizedRenderers();
   ~vtkPVClientServerSynchronizedRenderers() override;
@@ -88,6 +115,7 @@ protected:
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  int NumberOfCompressionBands;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
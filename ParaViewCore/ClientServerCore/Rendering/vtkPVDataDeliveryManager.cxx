@@ -739,6 +739,7 @@ void vtkPVDataDeliveryManager::Deliver(int use_lod, unsigned int size, unsigned
 
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "%s data migration",
     (use_lod ? "low-resolution" : "full resolution"));
+  PARAVIEW_TRACE_SCOPE("data-movement", use_lod ? "deliver lod" : "deliver");
   const int mode = this->GetViewDataDistributionMode(use_lod != 0);
 
   for (unsigned int cc = 0; cc < size; cc += 2)
@@ -757,6 +758,7 @@ void vtkPVDataDeliveryManager::Deliver(int use_lod, unsigned int size, unsigned
 
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s",
       this->GetRepresentation(id)->GetLogName().c_str());
+    PARAVIEW_TRACE_SCOPE("data-movement", "move data");
     item->Deliver(mode);
   }
 }
@@ -764,6 +766,7 @@ void vtkPVDataDeliveryManager::Deliver(int use_lod, unsigned int size, unsigned
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::RedistributeDataForOrderedCompositing(bool use_lod)
 {
+  PARAVIEW_TRACE_SCOPE("data-movement", "redistribute for ordered compositing");
   const int mode = this->GetViewDataDistributionMode(use_lod);
   if (this->RenderView->GetUpdateTimeStamp() > this->RedistributionTimeStamp)
   {
@@ -947,6 +950,7 @@ void vtkPVDataDeliveryManager::DeliverStreamedPieces(unsigned int size, unsigned
   // currently available. This is similar to Deliver(...) except that this deals
   // with only delivering pieces for streaming.
   assert(size % 2 == 0);
+  PARAVIEW_TRACE_SCOPE("data-movement", "deliver streamed pieces");
 
   const int mode = this->GetViewDataDistributionMode(/*use_lod*/ false);
   for (unsigned int cc = 0; cc < size; cc += 2)
@@ -39,6 +39,9 @@
 static const char* BIN_EXTENTS = "bin_extents";
 static const char* BIN_VALUES = "bin_values";
 
+// Number of values of each array of the input binned by early results.
+static const vtkIdType EARLY_RESULT_SAMPLE_SIZE = 1 << 20;
+
 namespace
 {
 template <class T>
@@ -60,6 +63,9 @@ vtkPVHistogramChartRepresentation::vtkPVHistogramChartRepresentation()
   this->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_ROWS);
   this->SetHistogramColor(0, 0, 255);
   this->AttributeType = vtkDataObject::POINT;
+  this->EarlyResult = false;
+  this->RefinementPending = false;
+  this->RefineRequested = false;
 }
 
 //----------------------------------------------------------------------------
@@ -75,6 +81,31 @@ vtkPVHistogramChartRepresentation::~vtkPVHistogramChartRepresentation()
 void vtkPVHistogramChartRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "EarlyResult: " << this->EarlyResult << endl;
+  os << indent << "RefinementPending: " << this->RefinementPending << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHistogramChartRepresentation::SetEarlyResult(bool val)
+{
+  if (this->EarlyResult != val)
+  {
+    this->EarlyResult = val;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHistogramChartRepresentation::RefineResult()
+{
+  if (this->RefinementPending)
+  {
+    // Not pending anymore, even if the next update is skipped (e.g. when the
+    // view is not rendered).
+    this->RefinementPending = false;
+    this->RefineRequested = true;
+    this->MarkModified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -197,8 +228,12 @@ vtkDataObject* vtkPVHistogramChartRepresentation::TransformInputData(
   this->ExtractHistogram->SetInputArrayToProcess(
     0, 0, 0, this->AttributeType, this->ArrayName.c_str());
   this->ExtractHistogram->CalculateAveragesOff();
+  this->ExtractHistogram->SetSampleSize(
+    this->EarlyResult && !this->RefineRequested ? EARLY_RESULT_SAMPLE_SIZE : 0);
   this->ExtractHistogram->SetInputData(data);
   this->ExtractHistogram->Update();
+  this->RefinementPending = this->ExtractHistogram->GetOutputIsEstimate();
+  this->RefineRequested = false;
 
   return this->ExtractHistogram->GetOutputDataObject(0);
 }
@@ -85,6 +85,28 @@ public:
   bool GetUseCustomBinRanges();
   //@}
 
+  //@{
+  /**
+   * When set to true, the histogram of large inputs is first estimated from a
+   * sample of the values, which is quick to compute. RefinementPending is then
+   * true until RefineResult() is called, after which the next update computes
+   * the exact histogram. By default, set to false.
+   */
+  void SetEarlyResult(bool);
+  vtkGetMacro(EarlyResult, bool);
+  //@}
+
+  /**
+   * Returns true when the current histogram is an estimate that has not been
+   * refined yet.
+   */
+  vtkGetMacro(RefinementPending, bool);
+
+  /**
+   * Requests the exact histogram, when the current one is an estimate.
+   */
+  void RefineResult();
+
   /**
    * Sets the color for the histograms.
    */
@@ -145,6 +167,9 @@ private:
 
   std::string ArrayName;
   int AttributeType;
+  bool EarlyResult;
+  bool RefinementPending;
+  bool RefineRequested;
 };
 
 #endif
@@ -28,28 +28,366 @@
 #include "vtkInformation.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
+#include "vtkMath.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <map>
-#include <set>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #define VTK_MAX_CATEGORICAL_VALS (32)
 
 namespace
 {
-typedef std::map<int, std::set<std::vector<vtkVariant> > > vtkInternalDistinctValuesBase;
+// Prominent values of a component (or of the tuples, for component -1) with
+// their estimated number of occurrences.
+typedef std::map<std::vector<vtkVariant>, vtkIdType> vtkProminentValueCounts;
+typedef std::map<int, vtkProminentValueCounts> vtkInternalDistinctValuesBase;
+
+//----------------------------------------------------------------------------
+// Values are counted with Misra-Gries summaries: a summary of capacity k
+// keeps at most k values and contains every value that makes up more than
+// 1/(k+1) of the counted values. Summaries are merged by adding the counts and
+// pruning back to k values, which keeps that guarantee.
+//
+// When Force is off, the capacity is the maximum number of discrete values and
+// the summary overflowing means that the array is not discrete. Otherwise,
+// the capacity is 2/Fraction: all values making up more than Fraction of the
+// array are found, with a count of at least half their number of occurrences.
+size_t vtkProminentValuesCapacity(bool force, double fraction, unsigned int maxDiscreteValues)
+{
+  if (!force)
+  {
+    return maxDiscreteValues;
+  }
+  if (fraction <= 0.)
+  {
+    return std::numeric_limits<size_t>::max();
+  }
+  return static_cast<size_t>(std::ceil(2. / fraction));
+}
+
+// Returns the number of tuples to sample so that a value making up at least
+// `fraction` of the tuples is found with a probability of at least
+// 1 - `uncertainty`, or numTuples to count every tuple.
+vtkIdType vtkProminentValuesSampleSize(vtkIdType numTuples, double fraction, double uncertainty)
+{
+  if (fraction <= 0. || fraction >= 1. || uncertainty <= 0. || uncertainty >= 1.)
+  {
+    return numTuples;
+  }
+  const double size = std::ceil(std::log(uncertainty) / std::log(1. - fraction));
+  return size < numTuples ? static_cast<vtkIdType>(size) : numTuples;
+}
+
+inline vtkIdType& vtkProminentValuesCount(vtkIdType& count)
+{
+  return count;
+}
+
+template <typename EntryType>
+inline vtkIdType& vtkProminentValuesCount(EntryType& entry)
+{
+  return entry.Count;
+}
+
+// Prunes a summary to `capacity` values by subtracting the count of the
+// (capacity+1)-th most frequent value from all counts. Returns true if values
+// were dropped.
+template <typename SummaryType>
+bool vtkPruneProminentValues(SummaryType& summary, size_t capacity)
+{
+  if (summary.size() <= capacity)
+  {
+    return false;
+  }
+  std::vector<vtkIdType> counts;
+  counts.reserve(summary.size());
+  for (typename SummaryType::iterator iter = summary.begin(); iter != summary.end(); ++iter)
+  {
+    counts.push_back(vtkProminentValuesCount(iter->second));
+  }
+  std::nth_element(counts.begin(), counts.begin() + capacity, counts.end(),
+    std::greater<vtkIdType>());
+  const vtkIdType threshold = counts[capacity];
+  for (typename SummaryType::iterator iter = summary.begin(); iter != summary.end();)
+  {
+    vtkIdType& count = vtkProminentValuesCount(iter->second);
+    if (count <= threshold)
+    {
+      iter = summary.erase(iter);
+    }
+    else
+    {
+      count -= threshold;
+      ++iter;
+    }
+  }
+  return true;
+}
+
+// Keys of the component values, or tuples, of a vtkDataArray. Values are
+// compared by their bits, with a single NaN and a single zero.
+inline vtkTypeUInt64 vtkProminentValueKey(double value)
+{
+  if (vtkMath::IsNan(value))
+  {
+    value = vtkMath::Nan();
+  }
+  value += 0.; // -0 is 0.
+  vtkTypeUInt64 key;
+  memcpy(&key, &value, sizeof(key));
+  return key;
+}
+
+struct vtkProminentValueKeyHash
+{
+  size_t operator()(vtkTypeUInt64 key) const
+  {
+    key = (key ^ (key >> 33)) * 0xff51afd7ed558ccdULL;
+    return static_cast<size_t>(key ^ (key >> 33));
+  }
+  size_t operator()(const std::vector<vtkTypeUInt64>& key) const
+  {
+    size_t hash = 0;
+    for (size_t cc = 0; cc < key.size(); ++cc)
+    {
+      hash = hash * 31 + (*this)(key[cc]);
+    }
+    return hash;
+  }
+};
+
+// Builds the summary of a component (or the tuples) of an array using one
+// summary per thread. When sampling, one tuple is picked pseudo-randomly in
+// each window of Stride tuples.
+template <typename KeyType>
+class vtkProminentValuesCounter
+{
+public:
+  struct EntryType
+  {
+    vtkIdType Count;
+    vtkIdType Tuple; // first tuple with the value.
+  };
+  typedef std::unordered_map<KeyType, EntryType, vtkProminentValueKeyHash> SummaryType;
+
+  vtkProminentValuesCounter(
+    vtkDataArray* array, int component, vtkIdType stride, size_t capacity, bool stopOnOverflow)
+    : Array(array)
+    , Component(component)
+    , NumberOfTuples(array->GetNumberOfTuples())
+    , Stride(stride)
+    , Capacity(capacity)
+    , StopOnOverflow(stopOnOverflow)
+  {
+    this->Overflow = false;
+  }
+
+  void Initialize() { this->LocalSummary.Local().clear(); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    SummaryType& summary = this->LocalSummary.Local();
+    KeyType key;
+    for (vtkIdType sample = begin; sample < end; ++sample)
+    {
+      const vtkIdType tuple = this->GetTuple(sample);
+      this->GetKey(tuple, key);
+      typename SummaryType::iterator iter = summary.find(key);
+      if (iter != summary.end())
+      {
+        ++iter->second.Count;
+      }
+      else if (summary.size() < this->Capacity)
+      {
+        EntryType entry = { 1, tuple };
+        summary.insert(std::make_pair(key, entry));
+      }
+      else
+      {
+        // Counting the new value and decrementing all the counts drops it.
+        this->Overflow = true;
+        if (this->StopOnOverflow)
+        {
+          return;
+        }
+        for (iter = summary.begin(); iter != summary.end();)
+        {
+          iter = (--iter->second.Count == 0) ? summary.erase(iter) : ++iter;
+        }
+      }
+      if ((sample - begin) % 1024 == 0 && this->StopOnOverflow && this->Overflow)
+      {
+        return;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    typedef typename vtkSMPThreadLocal<SummaryType>::iterator IteratorType;
+    for (IteratorType iter = this->LocalSummary.begin(); iter != this->LocalSummary.end(); ++iter)
+    {
+      for (typename SummaryType::iterator eit = iter->begin(); eit != iter->end(); ++eit)
+      {
+        typename SummaryType::iterator entry = this->Summary.find(eit->first);
+        if (entry == this->Summary.end())
+        {
+          this->Summary.insert(*eit);
+        }
+        else
+        {
+          entry->second.Count += eit->second.Count;
+          entry->second.Tuple = std::min(entry->second.Tuple, eit->second.Tuple);
+        }
+      }
+    }
+    if (vtkPruneProminentValues(this->Summary, this->Capacity))
+    {
+      this->Overflow = true;
+    }
+  }
+
+  SummaryType Summary;
+  std::atomic<bool> Overflow;
+
+private:
+  vtkIdType GetTuple(vtkIdType sample) const
+  {
+    if (this->Stride == 1)
+    {
+      return sample;
+    }
+    vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(sample);
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    const vtkIdType tuple = sample * this->Stride + static_cast<vtkIdType>(hash % this->Stride);
+    return std::min(tuple, this->NumberOfTuples - 1);
+  }
+
+  void GetKey(vtkIdType tuple, vtkTypeUInt64& key) const
+  {
+    key = vtkProminentValueKey(this->Array->GetComponent(tuple, this->Component));
+  }
+
+  void GetKey(vtkIdType tuple, std::vector<vtkTypeUInt64>& key) const
+  {
+    const int numComps = this->Array->GetNumberOfComponents();
+    key.resize(numComps);
+    for (int cc = 0; cc < numComps; ++cc)
+    {
+      key[cc] = vtkProminentValueKey(this->Array->GetComponent(tuple, cc));
+    }
+  }
+
+  vtkDataArray* Array;
+  int Component;
+  vtkIdType NumberOfTuples;
+  vtkIdType Stride;
+  size_t Capacity;
+  bool StopOnOverflow;
+  vtkSMPThreadLocal<SummaryType> LocalSummary;
+};
+
+// Fills `values` with the prominent values of a component of a vtkDataArray.
+// Returns false if the values could not be determined.
+template <typename KeyType>
+bool vtkCountProminentValues(vtkDataArray* array, int component, double fraction,
+  double uncertainty, bool force, vtkProminentValueCounts& values)
+{
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  const vtkIdType numSamples = vtkProminentValuesSampleSize(numTuples, fraction, uncertainty);
+  if (numSamples <= 0)
+  {
+    return false;
+  }
+  const vtkIdType stride = (numTuples + numSamples - 1) / numSamples;
+  const size_t capacity =
+    vtkProminentValuesCapacity(force, fraction, array->GetMaxDiscreteValues());
+
+  vtkProminentValuesCounter<KeyType> counter(array, component, stride, capacity, !force);
+  vtkSMPTools::For(0, (numTuples + stride - 1) / stride, counter);
+  if (!force && counter.Overflow)
+  {
+    return false;
+  }
+
+  // Sampled counts are scaled to the number of tuples so that merging the
+  // summaries of arrays of different sizes weighs them correctly. When all
+  // tuples were counted but the summary overflowed, it also holds infrequent
+  // values, which are dropped.
+  const double scale = static_cast<double>(numTuples) / ((numTuples + stride - 1) / stride);
+  const double minCount = (stride == 1 && counter.Overflow) ? 0.5 * fraction * numTuples : 0.;
+  const int numComps = array->GetNumberOfComponents();
+  const int tupleSize = component < 0 ? numComps : 1;
+  std::vector<vtkVariant> tuple(tupleSize);
+  typedef typename vtkProminentValuesCounter<KeyType>::SummaryType SummaryType;
+  for (typename SummaryType::iterator iter = counter.Summary.begin();
+       iter != counter.Summary.end(); ++iter)
+  {
+    if (iter->second.Count < minCount)
+    {
+      continue;
+    }
+    // Values keep the type of the array.
+    const vtkIdType first = iter->second.Tuple * numComps;
+    for (int i = 0; i < tupleSize; ++i)
+    {
+      tuple[i] = array->GetVariantValue(first + (component < 0 ? i : component));
+    }
+    const vtkIdType count = static_cast<vtkIdType>(std::floor(iter->second.Count * scale + 0.5));
+    values[tuple] += std::max<vtkIdType>(count, 1);
+  }
+  return !values.empty();
+}
+
+// Fills `values` with the distinct values of a component of any array using
+// vtkAbstractArray::GetProminentComponentValues(). This is used for arrays
+// that are not vtkDataArray, e.g. vtkStringArray.
+bool vtkCopyProminentValues(
+  vtkAbstractArray* array, int component, bool force, vtkProminentValueCounts& values)
+{
+  const int tupleSize = component < 0 ? array->GetNumberOfComponents() : 1;
+  std::vector<vtkVariant> tuple(tupleSize);
+  vtkNew<vtkVariantArray> cvalues;
+  unsigned int maxDiscreteValues = array->GetMaxDiscreteValues();
+  if (force)
+  {
+    array->SetMaxDiscreteValues(VTK_UNSIGNED_INT_MAX);
+  }
+  array->GetProminentComponentValues(component, cvalues.GetPointer(), 0., 0.);
+  array->SetMaxDiscreteValues(maxDiscreteValues);
+  vtkIdType nt = cvalues->GetNumberOfTuples();
+  for (vtkIdType t = 0; t < nt; ++t)
+  {
+    for (int i = 0; i < tupleSize; ++i)
+    {
+      tuple[i] = cvalues->GetValue(i + t * tupleSize);
+    }
+    values[tuple] += 1;
+  }
+  return nt > 0;
+}
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -128,11 +466,12 @@ void vtkPVProminentValuesInformation::PrintSelf(ostream& os, vtkIndent indent)
            eit != cit->second.end(); ++eit)
       {
         os << i3;
-        for (std::vector<vtkVariant>::const_iterator vit = eit->begin(); vit != eit->end(); ++vit)
+        for (std::vector<vtkVariant>::const_iterator vit = eit->first.begin();
+             vit != eit->first.end(); ++vit)
         {
           os << " " << vit->ToString();
         }
-        os << endl;
+        os << " (" << eit->second << ")" << endl;
       }
     }
   }
@@ -353,41 +692,32 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
     this->DistinctValues = new vtkInternalDistinctValues;
   }
   int nc = this->GetNumberOfComponents();
-  vtkNew<vtkVariantArray> cvalues;
-  std::vector<vtkVariant> tuple;
-  // bool tooManyValues;
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
   for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
   {
-    int tupleSize = c < 0 ? nc : 1;
-    tuple.resize(tupleSize);
-    std::set<std::vector<vtkVariant> >& compDistincts((*this->DistinctValues)[c]);
-    cvalues->Initialize();
-    unsigned int maxDiscreteValues = array->GetMaxDiscreteValues();
-    if (this->Force)
+    vtkProminentValueCounts& compDistincts((*this->DistinctValues)[c]);
+    bool found;
+    if (c >= array->GetNumberOfComponents() || (c < 0 && array->GetNumberOfComponents() != nc))
     {
-      array->SetMaxDiscreteValues(VTK_UNSIGNED_INT_MAX);
+      found = false;
     }
-    array->GetProminentComponentValues(c, cvalues.GetPointer(), 0., 0.);
-    array->SetMaxDiscreteValues(maxDiscreteValues);
-    vtkIdType nt = cvalues->GetNumberOfTuples();
-    if (nt > 0)
+    else if (dataArray && c < 0)
+    {
+      found = vtkCountProminentValues<std::vector<vtkTypeUInt64> >(
+        dataArray, c, this->Fraction, this->Uncertainty, this->Force, compDistincts);
+    }
+    else if (dataArray)
+    {
+      found = vtkCountProminentValues<vtkTypeUInt64>(
+        dataArray, c, this->Fraction, this->Uncertainty, this->Force, compDistincts);
+    }
+    else
+    {
+      found = vtkCopyProminentValues(array, c, this->Force, compDistincts);
+    }
+
+    if (found)
     {
-      for (vtkIdType t = 0; t < nt; ++t)
-      {
-        for (int i = 0; i < tupleSize; ++i)
-        {
-          tuple[i] = cvalues->GetValue(i + t * tupleSize);
-        }
-        compDistincts.insert(tuple);
-        /*
-        if (compDistincts.insert(tuple).second)
-          {
-          if ((tooManyValues =
-            compDistincts.size() > vtkAbstractArray::MAX_DISCRETE_VALUES))
-            break;
-          }
-          */
-      }
       this->Valid = true;
     }
     else
@@ -395,6 +725,7 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
       // if there is no tuples provided, it means we were unable
       // to determine the prominent values and this information
       // is invalid
+      compDistincts.clear();
       this->Valid = false;
     }
   }
@@ -454,10 +785,11 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
       for (eit = cit->second.begin(); eit != cit->second.end(); ++eit)
       {
         std::vector<vtkVariant>::const_iterator vit;
-        for (vit = eit->begin(); vit != eit->end(); ++vit)
+        for (vit = eit->first.begin(); vit != eit->first.end(); ++vit)
         {
           *css << *vit;
         }
+        *css << static_cast<long long>(eit->second);
       }
     }
   }
@@ -562,14 +894,22 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
       {
         for (int k = 0; k < tupleSize; ++k)
         {
-          if (!css->GetArgument(0, pos, &tuple[k]))
+          if (!css->GetArgument(0, pos++, &tuple[k]))
           {
             vtkErrorMacro("Error decoding the " << k << "-th entry of the " << j
                                                 << "-th unique tuple for component " << i);
             return;
           }
         }
-        (*this->DistinctValues)[component].insert(tuple);
+        long long count;
+        if (!css->GetArgument(0, pos++, &count))
+        {
+          vtkErrorMacro("Error decoding the count of the " << j
+                                                           << "-th unique tuple for component "
+                                                           << i);
+          return;
+        }
+        (*this->DistinctValues)[component][tuple] = static_cast<vtkIdType>(count);
       }
     }
   }
@@ -611,30 +951,24 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     return;
   }
 
-  for (int i = 0; i <= this->NumberOfComponents; ++i)
+  const size_t capacity =
+    vtkProminentValuesCapacity(this->Force, this->Fraction, vtkAbstractArray::MAX_DISCRETE_VALUES);
+  vtkInternalDistinctValues::iterator bit; // iterator over components of info.
+  for (bit = info->DistinctValues->begin(); bit != info->DistinctValues->end(); ++bit)
   {
-    vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(i);
-    vtkInternalDistinctValues::mapped_type::iterator
-      eit; // iterator over entries of component [ab]it->second.
-    bool tooManyValues = false;
-    if (bit != info->DistinctValues->end())
-    { // Add info's values to our list of unique keys
-      for (eit = bit->second.begin(); eit != bit->second.end(); ++eit)
-      {
-        if ((*this->DistinctValues)[i].insert(*eit).second &&
-          ((*this->DistinctValues)[i].size() > vtkAbstractArray::MAX_DISCRETE_VALUES &&
-              !this->Force))
-        {
-          tooManyValues = true;
-          break;
-        }
-      }
+    // Add info's values and counts to ours
+    vtkProminentValueCounts& values = (*this->DistinctValues)[bit->first];
+    vtkProminentValueCounts::const_iterator eit;
+    for (eit = bit->second.begin(); eit != bit->second.end(); ++eit)
+    {
+      values[eit->first] += eit->second;
     }
 
-    // If the union of values is too large, delete the list of values
-    if (tooManyValues)
+    // If the union of values is too large, delete the list of values, unless
+    // forced, in which case only the most frequent values are kept.
+    if (vtkPruneProminentValues(values, capacity) && !this->Force)
     {
-      this->DistinctValues->erase(i);
+      this->DistinctValues->erase(bit->first);
       this->Valid = false;
     }
   }
@@ -666,7 +1000,7 @@ vtkAbstractArray* vtkPVProminentValuesInformation::GetProminentComponentValues(i
   {
     for (int i = 0; i < nc; ++i)
     {
-      va->InsertNextValue((*eit)[i]);
+      va->InsertNextValue(eit->first[i]);
     }
   }
   return va;
@@ -26,7 +26,12 @@
  * given confidence that dictates the number of samples required), then
  * the prominent values are also made available.
  *
- * This class uses vtkAbstractArray::GetProminentComponentValues().
+ * Values of vtkDataArray instances are counted in parallel with vtkSMPTools
+ * into Misra-Gries summaries, one per thread, which are merged together and
+ * then across blocks and processes in AddInformation(). When Uncertainty is
+ * not zero, only as many tuples as needed to find the values making up at
+ * least Fraction of the array with that uncertainty are sampled.
+ * Other arrays use vtkAbstractArray::GetProminentComponentValues().
 */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -89,6 +94,9 @@ public:
 
    * Setting this to one indicates that an array must have every value be
    * identical in order to have any considered prominent.
+   * When Force is set and the array has more distinct values than can be
+   * kept, i.e. about 2/Fraction, only the values making up more than Fraction
+   * of the array are guaranteed to be found.
    */
   vtkSetClampMacro(Fraction, double, 0., 1.);
   vtkGetMacro(Fraction, double);
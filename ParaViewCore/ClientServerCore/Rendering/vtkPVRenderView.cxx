@@ -311,6 +311,7 @@ void vtkUpdateTrackballZoomManipulators(
 vtkStandardNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_REFINEMENT_PENDING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
@@ -388,6 +389,7 @@ vtkPVRenderView::vtkPVRenderView()
   this->NonDistributedRenderingRequired = false;
   this->DistributedRenderingRequiredLOD = false;
   this->NonDistributedRenderingRequiredLOD = false;
+  this->LODRefinementPending = false;
   this->ParallelProjection = 0;
   this->Culler = vtkSmartPointer<vtkPVRendererCuller>::New();
   this->ForceDataDistributionMode = -1;
@@ -1209,6 +1211,7 @@ void vtkPVRenderView::SynchronizeForCollaboration()
 void vtkPVRenderView::Update()
 {
   vtkVLogScopeFunction(PARAVIEW_LOG_RENDERING_VERBOSITY());
+  PARAVIEW_TRACE_SCOPE("rendering", "update");
 
   vtkTimerLog::MarkStartEvent("RenderView::Update");
 
@@ -1307,6 +1310,7 @@ void vtkPVRenderView::CopyViewUpdateOptions(vtkPVRenderView* otherView)
 void vtkPVRenderView::UpdateLOD()
 {
   vtkVLogScopeFunction(PARAVIEW_LOG_RENDERING_VERBOSITY());
+  PARAVIEW_TRACE_SCOPE("rendering", "update lod");
 
   vtkTimerLog::MarkStartEvent("RenderView::UpdateLOD");
 
@@ -1325,6 +1329,20 @@ void vtkPVRenderView::UpdateLOD()
   this->CallProcessViewRequest(
     vtkPVView::REQUEST_UPDATE_LOD(), this->RequestInformation, this->ReplyInformationVector);
 
+  // Check if any representation is still building a finer LOD.
+  vtkIdType refinement_pending = 0;
+  int num_reprs = this->ReplyInformationVector->GetNumberOfInformationObjects();
+  for (int cc = 0; cc < num_reprs; cc++)
+  {
+    vtkInformation* info = this->ReplyInformationVector->GetInformationObject(cc);
+    if (info->Has(LOD_REFINEMENT_PENDING()) && (info->Get(LOD_REFINEMENT_PENDING()) != 0))
+    {
+      refinement_pending = 1;
+    }
+  }
+  this->SynchronizedWindows->Reduce(refinement_pending, vtkPVSynchronizedRenderWindows::MAX_OP);
+  this->LODRefinementPending = (refinement_pending != 0);
+
   double local_size = this->GetDeliveryManager()->GetVisibleDataSize(true) / 1024.0;
   this->SynchronizedWindows->SynchronizeSize(local_size);
   // cout << "LOD Geometry size: " << local_size << endl;
@@ -1347,6 +1365,7 @@ void vtkPVRenderView::UpdateLOD()
 void vtkPVRenderView::StillRender()
 {
   vtkVLogScopeFunction(PARAVIEW_LOG_RENDERING_VERBOSITY());
+  PARAVIEW_TRACE_SCOPE("rendering", "still render");
 
   vtkTimerLog::MarkStartEvent("Still Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(0.002);
@@ -1362,6 +1381,7 @@ void vtkPVRenderView::StillRender()
 void vtkPVRenderView::InteractiveRender()
 {
   vtkVLogScopeFunction(PARAVIEW_LOG_RENDERING_VERBOSITY());
+  PARAVIEW_TRACE_SCOPE("rendering", "interactive render");
 
   vtkTimerLog::MarkStartEvent("Interactive Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(5.0);
@@ -1379,6 +1399,7 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 {
   vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Render(interactive=%s, skip_rendering=%s)",
     (interactive ? "true" : "false"), (skip_rendering ? "true" : "false"));
+  PARAVIEW_TRACE_SCOPE("rendering", "render");
 
   this->UpdateStereoProperties();
 
@@ -1503,8 +1524,11 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   // Render each representation with available geometry.
   // This is the pass where representations get an opportunity to get the
   // currently "available" represented data and try to render it.
-  this->CallProcessViewRequest(
-    vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
+  {
+    PARAVIEW_TRACE_SCOPE("rendering", "request render");
+    this->CallProcessViewRequest(
+      vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
+  }
 
   // set the image reduction factor.
   this->SynchronizedRenderers->SetImageReductionFactor(
@@ -1590,7 +1614,10 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     {
       this->Timer->StartTimer();
     }
-    this->GetRenderWindow()->Render();
+    {
+      PARAVIEW_TRACE_SCOPE("rendering", "render window");
+      this->GetRenderWindow()->Render();
+    }
     if (!this->MakingSelection)
     {
       this->Timer->StopTimer();
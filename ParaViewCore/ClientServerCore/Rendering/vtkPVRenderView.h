@@ -329,6 +329,13 @@ public:
    */
   static vtkInformationIntegerKey* USE_OUTLINE_FOR_LOD();
 
+  /**
+   * Representation can publish this key in their REQUEST_UPDATE_LOD() pass to
+   * indicate that the LOD geometry they provided will be replaced by a finer
+   * one that is still being built.
+   */
+  static vtkInformationIntegerKey* LOD_REFINEMENT_PENDING();
+
   /**
    * Representation can publish this key in their REQUEST_INFORMATION()
    * pass to indicate that the representation needs to disable
@@ -709,6 +716,16 @@ public:
   vtkGetMacro(UseDistributedRenderingForLODRender, bool);
   //@}
 
+  //@{
+  /**
+   * Returns whether some representations are still building finer LOD
+   * geometries, as determined by the most recent call to `UpdateLOD`. In that
+   * case, UpdateLOD() should be called again before the next interactive
+   * renders to get the finer geometries once they are ready.
+   */
+  vtkGetMacro(LODRefinementPending, bool);
+  //@}
+
   //@{
   /**
    * Returns the processes (vtkPVSession::ServerFlags) that are to be involved
@@ -1179,6 +1196,9 @@ private:
   bool DistributedRenderingRequiredLOD;
   bool NonDistributedRenderingRequiredLOD;
 
+  // Set when representations are building finer LOD geometries.
+  bool LODRefinementPending;
+
   // Cached value for parallel projection set on camera.
   int ParallelProjection;
 
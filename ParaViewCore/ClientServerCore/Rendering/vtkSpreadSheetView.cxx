@@ -425,6 +425,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
 
   vtkPVMergeTables* post_gather_algo = vtkPVMergeTables::New();
   this->ReductionFilter->SetPostGatherHelper(post_gather_algo);
+  // merging tables is associative: reduce along a binary tree so that the
+  // root does not receive the tables of all processes at once.
+  this->ReductionFilter->SetTreeFanIn(2);
   post_gather_algo->FastDelete();
 
   this->DeliveryFilter = vtkClientServerMoveData::New();
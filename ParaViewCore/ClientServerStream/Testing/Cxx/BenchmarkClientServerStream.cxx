@@ -0,0 +1,182 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkClientServerStream.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Measures the number of messages per second that can be built and dispatched
+// for a typical property push, i.e. what vtkSIVectorPropertyTemplate::Push and
+// vtkClientServerInterpreter::ProcessStream do for each property of a proxy.
+// The number of property pushes may be given as first argument. Also checks
+// that, once warm, pooled streams build and dispatch messages without
+// allocating, by counting calls to the global operator new.
+
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkObject.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<bool> CountAllocations(false);
+std::atomic<size_t> NumberOfAllocations(0);
+
+void* Allocate(size_t size)
+{
+  if (CountAllocations)
+  {
+    ++NumberOfAllocations;
+  }
+  if (void* ptr = malloc(size > 0 ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+}
+
+void* operator new(size_t size)
+{
+  return Allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+  return Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  free(ptr);
+}
+
+namespace
+{
+// Build the stream for a property push and dispatch it the way the
+// interpreter does: each message is expanded into a new stream and the
+// result is stored in a reused stream.
+bool PushProperty(vtkObjectBase* object, vtkObjectBase* owner, int index,
+  vtkClientServerStream& lastResult)
+{
+  const double values[3] = { 1.0 * index, 2.0, 3.0 };
+
+  vtkClientServerStream stream(owner);
+  stream << vtkClientServerStream::Invoke << object << "SetCenter"
+         << vtkClientServerStream::InsertArray(values, 3) << vtkClientServerStream::End;
+  stream << vtkClientServerStream::Invoke << object << "SetName"
+         << "property" << vtkClientServerStream::End;
+
+  for (int m = 0; m < stream.GetNumberOfMessages(); ++m)
+  {
+    vtkClientServerStream msg;
+    msg << stream.GetCommand(m);
+    for (int a = 0; a < stream.GetNumberOfArguments(m); ++a)
+    {
+      msg << stream.GetArgument(m, a);
+    }
+    msg << vtkClientServerStream::End;
+
+    lastResult.Reset();
+    lastResult << vtkClientServerStream::Reply << vtkClientServerStream::End;
+  }
+
+  double result[3];
+  return stream.GetArgument(0, 2, result, 3) && result[0] == values[0];
+}
+
+double Run(vtkObjectBase* object, vtkObjectBase* owner, int count, bool release)
+{
+  vtkClientServerStream lastResult;
+  auto start = std::chrono::steady_clock::now();
+  for (int cc = 0; cc < count; ++cc)
+  {
+    if (release)
+    {
+      // emulate streams without pooled buffers.
+      vtkClientServerStream::ReleasePooledMemory();
+    }
+    if (!PushProperty(object, owner, cc, lastResult))
+    {
+      return -1;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() > 0 ? (2.0 * count) / elapsed.count() : 0;
+}
+
+// Returns the number of allocations made by `count` property pushes.
+size_t CountPushAllocations(vtkObjectBase* object, vtkObjectBase* owner, int count, bool release)
+{
+  // warm up the pool.
+  Run(object, owner, 1, false);
+  NumberOfAllocations = 0;
+  CountAllocations = true;
+  Run(object, owner, count, release);
+  CountAllocations = false;
+  return NumberOfAllocations;
+}
+}
+
+int BenchmarkClientServerStream(int argc, char* argv[])
+{
+  const int count = argc > 1 ? atoi(argv[1]) : 100000;
+
+  vtkNew<vtkObject> object;
+  vtkNew<vtkObject> owner;
+
+  const double unpooled = Run(object, owner, count, true);
+  const double pooled = Run(object, owner, count, false);
+  if (unpooled < 0 || pooled < 0)
+  {
+    cerr << "FAILED: property values could not be read back." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // streams reusing pooled buffers must still release the objects they
+  // reference.
+  if (object->GetReferenceCount() != 1)
+  {
+    cerr << "FAILED: stream did not release object, reference count is "
+         << object->GetReferenceCount() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // without pooled buffers every stream allocates its buffers, while pooled
+  // streams reuse them.
+  const size_t unpooledAllocations = CountPushAllocations(object, owner, 100, true);
+  const size_t pooledAllocations = CountPushAllocations(object, owner, 100, false);
+  if (unpooledAllocations == 0)
+  {
+    cerr << "FAILED: allocations are not counted." << endl;
+    return EXIT_FAILURE;
+  }
+  if (pooledAllocations != 0)
+  {
+    cerr << "FAILED: pooled streams allocated " << pooledAllocations
+         << " times for 100 property pushes." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "Property pushes: " << count << endl;
+  cout << "Allocations for 100 pushes without pooled buffers: " << unpooledAllocations << endl;
+  cout << "Messages/second without pooled buffers: " << unpooled << endl;
+  cout << "Messages/second with pooled buffers: " << pooled << endl;
+  return EXIT_SUCCESS;
+}
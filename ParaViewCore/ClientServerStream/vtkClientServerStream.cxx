@@ -236,6 +236,43 @@ public:
   // Buffer for return value from StreamToString.
   std::string String;
 
+  // Buffers larger than this are released by Clear() instead of being kept
+  // for reuse.
+  static const size_t MaximumRetainedCapacity = 64 * 1024;
+
+  // Empty the stream, keeping buffers of moderate size.
+  void Clear()
+  {
+    if (this->Data.capacity() > MaximumRetainedCapacity)
+    {
+      DataType().swap(this->Data);
+    }
+    else
+    {
+      this->Data.clear();
+    }
+    if (this->ValueOffsets.capacity() * sizeof(ValueOffsetsType::value_type) >
+      MaximumRetainedCapacity)
+    {
+      ValueOffsetsType().swap(this->ValueOffsets);
+    }
+    else
+    {
+      this->ValueOffsets.clear();
+    }
+    this->MessageIndexes.clear();
+    this->Objects.Clear();
+    this->Invalid = 0;
+    this->StartIndex = InvalidStartIndex;
+  }
+
+  // Get an internals instance for a new stream, from the pool of the calling
+  // thread if possible.
+  static vtkClientServerStreamInternals* Acquire(vtkObjectBase* owner);
+
+  // Give back the internals of a destroyed stream.
+  static void Release(vtkClientServerStreamInternals* internals);
+
   // Access to protected members of vtkClientServerStream.
   static vtkClientServerStream& Write(vtkClientServerStream& css, const void* data, size_t length)
   {
@@ -251,26 +288,114 @@ const vtkClientServerStreamInternals::ValueOffsetsType::size_type
   vtkClientServerStreamInternals::InvalidStartIndex =
     static_cast<vtkClientServerStreamInternals::ValueOffsetsType::size_type>(-1);
 
+namespace
+{
+// Per-thread pool of internals released by destroyed streams.
+class vtkClientServerStreamPool
+{
+public:
+  ~vtkClientServerStreamPool();
+  void Clear();
+
+  // Streams destroyed after the pool (e.g. static instances) must not use it.
+  static vtkClientServerStreamPool* GetInstance();
+
+  // Number of internals kept per thread.
+  static const size_t MaximumSize = 32;
+  std::vector<vtkClientServerStreamInternals*> Internals;
+};
+
+thread_local bool vtkClientServerStreamPoolDestroyed = false;
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool::~vtkClientServerStreamPool()
+{
+  this->Clear();
+  vtkClientServerStreamPoolDestroyed = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStreamPool::Clear()
+{
+  for (auto internals : this->Internals)
+  {
+    delete internals;
+  }
+  this->Internals.clear();
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamPool* vtkClientServerStreamPool::GetInstance()
+{
+  if (vtkClientServerStreamPoolDestroyed)
+  {
+    return nullptr;
+  }
+  static thread_local vtkClientServerStreamPool pool;
+  return &pool;
+}
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStreamInternals* vtkClientServerStreamInternals::Acquire(vtkObjectBase* owner)
+{
+  vtkClientServerStreamPool* pool = vtkClientServerStreamPool::GetInstance();
+  if (pool == nullptr || pool->Internals.empty())
+  {
+    return new vtkClientServerStreamInternals(owner);
+  }
+  vtkClientServerStreamInternals* internals = pool->Internals.back();
+  pool->Internals.pop_back();
+  internals->Objects.Owner = owner;
+  return internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStreamInternals::Release(vtkClientServerStreamInternals* internals)
+{
+  vtkClientServerStreamPool* pool = vtkClientServerStreamPool::GetInstance();
+  if (pool == nullptr || pool->Internals.size() >= vtkClientServerStreamPool::MaximumSize)
+  {
+    delete internals;
+    return;
+  }
+  // Unregister the objects while the owner is still known.
+  internals->Clear();
+  internals->String.clear();
+  internals->Objects.Owner = nullptr;
+  pool->Internals.push_back(internals);
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
 {
   // Initialize the internal representation of the stream.
-  this->Internal = new vtkClientServerStreamInternals(owner);
-  this->Reserve(1024);
+  this->Internal = vtkClientServerStreamInternals::Acquire(owner);
   this->Reset();
+  this->Reserve(1024);
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream::~vtkClientServerStream()
 {
-  delete this->Internal;
+  vtkClientServerStreamInternals::Release(this->Internal);
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(const vtkClientServerStream& r, vtkObjectBase* owner)
 {
-  // Allocate and copy the internal representation of the stream.
-  this->Internal = new vtkClientServerStreamInternals(*r.Internal, owner);
+  // Copy the internal representation of the stream, reusing pooled buffers.
+  this->Internal = vtkClientServerStreamInternals::Acquire(owner);
+  *this->Internal = *r.Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStream::ReleasePooledMemory()
+{
+  if (vtkClientServerStreamPool* pool = vtkClientServerStreamPool::GetInstance())
+  {
+    pool->Clear();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -315,18 +440,8 @@ void vtkClientServerStream::Reserve(size_t size)
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reset()
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
-
-  this->Internal->ValueOffsets.erase(
-    this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
-  this->Internal->MessageIndexes.erase(
-    this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
-  this->Internal->Objects.Clear();
-
-  // No message has yet been started.
-  this->Internal->Invalid = 0;
-  this->Internal->StartIndex = vtkClientServerStreamInternals::InvalidStartIndex;
+  // Empty the entire stream. No message has yet been started.
+  this->Internal->Clear();
 
 // Store the byte order of data to come.
 #ifdef VTK_WORDS_BIGENDIAN
@@ -111,10 +111,21 @@ public:
   void Reserve(size_t size);
 
   /**
-   * Reset the stream to an empty state.
+   * Reset the stream to an empty state. Buffers of moderate size are kept
+   * so that a stream reused for the next message does not need to
+   * reallocate them.
    */
   void Reset();
 
+  /**
+   * Streams are often created on the stack to build a single message. To
+   * avoid allocating and freeing their buffers for every message, the
+   * internal buffers of destroyed streams are kept in a small per-thread pool
+   * and handed to the next streams created on the same thread. This releases
+   * the buffers pooled by the calling thread.
+   */
+  static void ReleasePooledMemory();
+
   /**
    * Copy the stream contents from another stream.
    */
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVLoggerTrace.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the Chrome trace event JSON written by vtkPVLogger::WriteTrace.
+#include "vtkPVLogger.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+struct Event
+{
+  std::string Line;
+  long long Start;
+  long long Duration;
+  int ThreadId;
+};
+
+long long GetNumber(const std::string& line, const char* key)
+{
+  const std::size_t pos = line.find(key);
+  return pos == std::string::npos ? -1 : std::atoll(line.c_str() + pos + strlen(key));
+}
+
+// Returns the complete ("X") event whose line contains `name`.
+bool FindEvent(const std::vector<std::string>& lines, const std::string& name, Event& event)
+{
+  for (const std::string& line : lines)
+  {
+    if (line.find("\"ph\":\"X\"") != std::string::npos && line.find(name) != std::string::npos)
+    {
+      event.Line = line;
+      event.Start = GetNumber(line, "\"ts\":");
+      event.Duration = GetNumber(line, "\"dur\":");
+      event.ThreadId = static_cast<int>(GetNumber(line, "\"tid\":"));
+      return true;
+    }
+  }
+  return false;
+}
+}
+
+int TestPVLoggerTrace(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fname = std::string(tempDir) + "/TestPVLoggerTrace.json";
+  delete[] tempDir;
+
+  vtkPVLogger::SetTracingEnabled(true);
+  vtkPVLogger::ClearTrace();
+  vtkPVLogger::SetTraceProcessId(3);
+  vtkPVLogger::SetTraceProcessName("server");
+  {
+    PARAVIEW_TRACE_SCOPE("test", "outer");
+    {
+      PARAVIEW_TRACE_SCOPE("test", "inner \"quoted\"");
+    }
+    std::thread thread([]() { PARAVIEW_TRACE_SCOPE("test", "other thread"); });
+    thread.join();
+  }
+  vtkPVLogger::SetTracingEnabled(false);
+  {
+    PARAVIEW_TRACE_SCOPE("test", "disabled");
+  }
+
+  expect(!vtkPVLogger::WriteTrace(nullptr), "writing without a file name should fail.");
+  expect(vtkPVLogger::WriteTrace(fname.c_str()), "could not write " << fname << ".");
+
+  std::ifstream ifs(fname.c_str());
+  std::vector<std::string> lines;
+  std::string line;
+  int numEvents = 0;
+  while (std::getline(ifs, line))
+  {
+    lines.push_back(line);
+    numEvents += line.find("\"ph\":\"X\"") != std::string::npos ? 1 : 0;
+  }
+  expect(!lines.empty() && lines.front() == "{\"traceEvents\":[", "missing trace header.");
+  expect(lines.back() == "],\"displayTimeUnit\":\"ms\"}", "missing trace footer.");
+  expect(numEvents == 3, numEvents << " events were written, expected 3.");
+
+  expect(lines.size() > 1 &&
+      lines[1].find("\"name\":\"process_name\"") != std::string::npos &&
+      lines[1].find("\"pid\":3") != std::string::npos &&
+      lines[1].find("\"args\":{\"name\":\"server rank 3\"}") != std::string::npos,
+    "wrong process name metadata: " << (lines.size() > 1 ? lines[1] : std::string()));
+
+  Event outer, inner, other, disabled;
+  expect(FindEvent(lines, "\"name\":\"outer\"", outer), "missing outer scope.");
+  expect(FindEvent(lines, "\"name\":\"inner \\\"quoted\\\"\"", inner),
+    "missing or badly escaped inner scope.");
+  expect(FindEvent(lines, "\"name\":\"other thread\"", other), "missing thread scope.");
+  expect(!FindEvent(lines, "disabled", disabled), "scope recorded while tracing was disabled.");
+  for (const Event* event : { &outer, &inner, &other })
+  {
+    expect(event->Line.find("\"cat\":\"test\"") != std::string::npos &&
+        event->Line.find("\"pid\":3,") != std::string::npos && event->Start >= 0 &&
+        event->Duration >= 0,
+      "bad event: " << event->Line);
+  }
+  expect(inner.Start >= outer.Start &&
+      inner.Start + inner.Duration <= outer.Start + outer.Duration,
+    "inner scope is not nested in the outer one.");
+  expect(inner.ThreadId == outer.ThreadId, "scopes of a thread have different thread ids.");
+  expect(other.ThreadId != outer.ThreadId, "scopes of two threads have the same thread id.");
+
+  vtkPVLogger::ClearTrace();
+  vtkPVLogger::SetTraceProcessName(nullptr);
+  return EXIT_SUCCESS;
+}
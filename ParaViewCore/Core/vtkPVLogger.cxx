@@ -16,7 +16,15 @@
 
 #include "vtkObjectFactory.h"
 
+#include <atomic>
+#include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -77,6 +85,106 @@ static const int PluginVerbosityKey = 2;
 static const int DataMovementVerbosityKey = 3;
 static const int RenderingVerbosityKey = 4;
 static const int ApplicationVerbosityKey = 5;
+static const int CatalystVerbosityKey = 6;
+
+struct TraceEvent
+{
+  const char* Category;
+  const char* Name;
+  vtkTypeInt64 Start;
+  vtkTypeInt64 Duration;
+};
+
+// Ring buffer of the trace events of a single thread. Only the owning thread
+// pushes events; Count is published with release semantics so that a writer
+// reading it with acquire semantics sees complete events.
+class TraceBuffer
+{
+public:
+  static const vtkTypeUInt64 Capacity = 1 << 16;
+
+  TraceBuffer(int threadId)
+    : ThreadId(threadId)
+    , Count(0)
+    , Events(Capacity)
+  {
+  }
+
+  void Push(const TraceEvent& event)
+  {
+    const vtkTypeUInt64 count = this->Count.load(std::memory_order_relaxed);
+    this->Events[count & (Capacity - 1)] = event;
+    this->Count.store(count + 1, std::memory_order_release);
+  }
+
+  const int ThreadId;
+  std::atomic<vtkTypeUInt64> Count;
+  std::vector<TraceEvent> Events;
+};
+
+// Buffers are shared with the registry so that events of threads that have
+// exited are still written out.
+struct TraceRegistry
+{
+  std::mutex Mutex;
+  std::vector<std::shared_ptr<TraceBuffer> > Buffers;
+};
+
+static TraceRegistry& get_trace_registry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+static TraceBuffer& get_trace_buffer()
+{
+  static thread_local std::shared_ptr<TraceBuffer> buffer;
+  if (!buffer)
+  {
+    // Only taken once per thread.
+    auto& registry = get_trace_registry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    buffer = std::make_shared<TraceBuffer>(static_cast<int>(registry.Buffers.size()));
+    registry.Buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+// Wall-clock time in microseconds, so that events of different ranks can be
+// lined up.
+static vtkTypeInt64 get_trace_time()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+static void write_json_string(ostream& os, const char* str)
+{
+  os << '"';
+  for (const char* c = str ? str : ""; *c != '\0'; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      os << '\\' << *c;
+    }
+    else if (static_cast<unsigned char>(*c) >= 0x20)
+    {
+      os << *c;
+    }
+  }
+  os << '"';
+}
+
+static std::atomic<bool> TracingEnabled{ vtksys::SystemTools::GetEnv("PARAVIEW_TRACE_FILE") !=
+  nullptr };
+static std::atomic<int> TraceProcessId{ 0 };
+
+static std::string& get_trace_process_name()
+{
+  static std::string name;
+  return name;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -196,6 +304,149 @@ void vtkPVLogger::SetApplicationVerbosity(vtkLogger::Verbosity value)
   }
 }
 
+//----------------------------------------------------------------------------
+vtkLogger::Verbosity vtkPVLogger::GetCatalystVerbosity()
+{
+  return get_verbosity(CatalystVerbosityKey, "PARAVIEW_LOG_CATALYST_VERBOSITY");
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetCatalystVerbosity(vtkLogger::Verbosity value)
+{
+  if (value > vtkLogger::VERBOSITY_INVALID && value <= vtkLogger::VERBOSITY_MAX)
+  {
+    set_verbosity(CatalystVerbosityKey, value);
+  }
+  else
+  {
+    vtkLogF(WARNING, "ignoring invalid verbosity %d", value);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVLogger::GetTracingEnabled()
+{
+  return TracingEnabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetTracingEnabled(bool value)
+{
+  TracingEnabled.store(value, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVLogger::GetTraceProcessId()
+{
+  return TraceProcessId.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetTraceProcessId(int value)
+{
+  TraceProcessId.store(value, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVLogger::GetTraceProcessName()
+{
+  return get_trace_process_name().c_str();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::SetTraceProcessName(const char* name)
+{
+  get_trace_process_name() = name ? name : "";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVLogger::GetTraceFileName()
+{
+  return vtksys::SystemTools::GetEnv("PARAVIEW_TRACE_FILE");
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVLogger::WriteTrace(const char* filename)
+{
+  if (filename == nullptr || *filename == '\0')
+  {
+    vtkLogF(ERROR, "no filename specified to write the trace to");
+    return false;
+  }
+
+  vtksys::ofstream ofs(filename);
+  if (!ofs)
+  {
+    vtkLogF(ERROR, "failed to open `%s` to write the trace", filename);
+    return false;
+  }
+
+  const int pid = vtkPVLogger::GetTraceProcessId();
+  ofs << "{\"traceEvents\":[\n";
+  std::ostringstream processName;
+  const std::string& name = get_trace_process_name();
+  processName << (name.empty() ? "rank" : name + " rank") << " " << pid;
+  ofs << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+      << ",\"tid\":0,\"args\":{\"name\":";
+  write_json_string(ofs, processName.str().c_str());
+  ofs << "}}";
+
+  auto& registry = get_trace_registry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (const auto& buffer : registry.Buffers)
+  {
+    const vtkTypeUInt64 count = buffer->Count.load(std::memory_order_acquire);
+    const vtkTypeUInt64 first = count > TraceBuffer::Capacity ? count - TraceBuffer::Capacity : 0;
+    for (vtkTypeUInt64 cc = first; cc < count; ++cc)
+    {
+      const TraceEvent& event = buffer->Events[cc & (TraceBuffer::Capacity - 1)];
+      ofs << ",\n{\"name\":";
+      write_json_string(ofs, event.Name);
+      ofs << ",\"cat\":";
+      write_json_string(ofs, event.Category);
+      ofs << ",\"ph\":\"X\",\"ts\":" << event.Start << ",\"dur\":" << event.Duration
+          << ",\"pid\":" << pid << ",\"tid\":" << buffer->ThreadId << "}";
+    }
+    if (first > 0)
+    {
+      vtkLogF(WARNING, "trace buffer of thread %d overflowed, %llu oldest events were dropped",
+        buffer->ThreadId, static_cast<unsigned long long>(first));
+    }
+  }
+  ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return !ofs.fail();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLogger::ClearTrace()
+{
+  auto& registry = get_trace_registry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  for (const auto& buffer : registry.Buffers)
+  {
+    buffer->Count.store(0, std::memory_order_release);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogger::TraceScope::TraceScope(const char* category, const char* name)
+  : Category(category)
+  , Name(name)
+  , Start(vtkPVLogger::GetTracingEnabled() ? get_trace_time() : -1)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVLogger::TraceScope::~TraceScope()
+{
+  if (this->Start >= 0)
+  {
+    TraceEvent event = { this->Category, this->Name, this->Start, 0 };
+    event.Duration = get_trace_time() - this->Start;
+    get_trace_buffer().Push(event);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVLogger::PrintSelf(ostream& os, vtkIndent indent)
 {
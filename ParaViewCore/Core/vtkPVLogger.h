@@ -41,6 +41,30 @@
  * When not changed using the APIs or environment variables, all categories
  * default to vtkLogger::VERBOSITY_TRACE. To change the default used, use
  * `vtkPVLogger::SetDefaultVerbosity`.
+ *
+ * @section PerformanceTracing Performance tracing
+ *
+ * In addition to log messages, vtkPVLogger can record timed scopes for
+ * performance analysis. Scopes are recorded using `PARAVIEW_TRACE_SCOPE()`:
+ *
+ * @code{cpp}
+ * PARAVIEW_TRACE_SCOPE("rendering", "still render");
+ * @endcode
+ *
+ * Each thread records its scopes in its own fixed-size ring buffer without
+ * locking, keeping the most recent events when the buffer is full. Recorded
+ * events are written out using `vtkPVLogger::WriteTrace` in the Chrome trace
+ * event JSON format, which can be loaded in `chrome://tracing` or Perfetto.
+ * Events are tagged with the thread and the process id set using
+ * `SetTraceProcessId`, typically the rank, and the process is named after
+ * the name set using `SetTraceProcessName` and the process id.
+ *
+ * Tracing is off by default. Setting the environment variable
+ * `PARAVIEW_TRACE_FILE` to a filename turns it on at startup, and ParaView
+ * processes write their trace to that file when they finalize. The process
+ * type, e.g. `client` or `server`, and, when there are several ranks, the
+ * rank are added before the file extension, so that a client and its server
+ * do not write the same file.
  */
 
 #ifndef vtkPVLogger_h
@@ -119,6 +143,19 @@ public:
   static void SetApplicationVerbosity(Verbosity value);
   //@}
 
+  //@{
+  /**
+   * Verbosity level for log messages related to in situ processing with
+   * Catalyst.
+   *
+   * Default level is `vtkLogger::VERBOSITY_TRACE` unless overridden by calling
+   * `SetCatalystVerbosity` or by setting the environment variable
+   * `PARAVIEW_LOG_CATALYST_VERBOSITY` to the expected verbosity level.
+   */
+  static Verbosity GetCatalystVerbosity();
+  static void SetCatalystVerbosity(Verbosity value);
+  //@}
+
   //@{
   /**
    * Change default verbosity to use for all ParaView categories defined here if
@@ -131,6 +168,78 @@ public:
   static Verbosity GetDefaultVerbosity();
   static void SetDefaultVerbosity(Verbosity value);
   //@}
+
+  //@{
+  /**
+   * Enable/disable recording of trace scopes. When disabled, trace scopes
+   * cost a single flag test.
+   *
+   * Default is off unless the environment variable `PARAVIEW_TRACE_FILE` is
+   * set.
+   */
+  static bool GetTracingEnabled();
+  static void SetTracingEnabled(bool value);
+  //@}
+
+  //@{
+  /**
+   * Set/get the process id recorded with trace events, typically the rank of
+   * the process. Default is 0.
+   */
+  static int GetTraceProcessId();
+  static void SetTraceProcessId(int value);
+  //@}
+
+  //@{
+  /**
+   * Set/get the name of the process written with the trace events, e.g.
+   * "client" or "server". Trace viewers show the process as this name
+   * followed by the process id. Default is empty.
+   */
+  static const char* GetTraceProcessName();
+  static void SetTraceProcessName(const char* name);
+  //@}
+
+  /**
+   * Returns the value of the `PARAVIEW_TRACE_FILE` environment variable or
+   * nullptr if it is not set.
+   */
+  static const char* GetTraceFileName();
+
+  /**
+   * Write the trace events recorded so far by all threads to `filename`
+   * in Chrome trace event JSON format. Returns false if the file could not
+   * be written.
+   */
+  static bool WriteTrace(const char* filename);
+
+  /**
+   * Discard all recorded trace events. Must not be called while trace
+   * scopes are active in other threads.
+   */
+  static void ClearTrace();
+
+  /**
+   * Records the time spent between its construction and its destruction as
+   * a trace event. `category` and `name` are not copied and must outlive
+   * the process, which is the case for string literals. Use
+   * `PARAVIEW_TRACE_SCOPE()` instead of using this class directly.
+   */
+  class VTKPVCORE_EXPORT TraceScope
+  {
+  public:
+    TraceScope(const char* category, const char* name);
+    ~TraceScope();
+
+  private:
+    TraceScope(const TraceScope&) = delete;
+    void operator=(const TraceScope&) = delete;
+
+    const char* Category;
+    const char* Name;
+    vtkTypeInt64 Start;
+  };
+
 protected:
   vtkPVLogger();
   ~vtkPVLogger() override;
@@ -190,4 +299,27 @@ private:
  */
 #define PARAVIEW_LOG_APPLICATION_VERBOSITY() vtkPVLogger::GetApplicationVerbosity()
 
+/**
+ * Macro to use for verbosity when logging Catalyst messages. Same as calling
+ * vtkPVLogger::GetCatalystVerbosity() e.g.
+ *
+ * @code{cpp}
+ *  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "skipping pipeline %d", index);
+ * @endcode
+ */
+#define PARAVIEW_LOG_CATALYST_VERBOSITY() vtkPVLogger::GetCatalystVerbosity()
+
+/**
+ * Macro to record the enclosing scope as a trace event when tracing is
+ * enabled. `category` and `name` must be string literals e.g.
+ *
+ * @code{cpp}
+ *  PARAVIEW_TRACE_SCOPE("data-movement", "deliver");
+ * @endcode
+ */
+#define PARAVIEW_TRACE_SCOPE(category, name)                                                       \
+  vtkPVLogger::TraceScope PARAVIEW_TRACE_CONCAT(_paraview_trace_scope_, __LINE__)(category, name)
+#define PARAVIEW_TRACE_CONCAT(a, b) PARAVIEW_TRACE_CONCAT_IMPL(a, b)
+#define PARAVIEW_TRACE_CONCAT_IMPL(a, b) a##b
+
 #endif
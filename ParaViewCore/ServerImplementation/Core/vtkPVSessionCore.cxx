@@ -35,9 +35,12 @@
 #include "vtkSIProxyDefinitionManager.h"
 #include "vtkSMMessage.h"
 #include "vtkSmartPointer.h"
+#include <vtksys/SystemTools.hxx>
 
 #include <assert.h>
+#include <cstring>
 #include <fstream>
+#include <list>
 #include <set>
 #include <sstream>
 #include <string>
@@ -79,6 +82,36 @@ void RMICallback(
   }
 }
 };
+namespace
+{
+// Modes for incremental gathering of information across satellites.
+enum
+{
+  // every rank sends its information.
+  INCREMENTAL_GATHER_DISABLED = 0,
+  // every rank sends its information and the root keeps it.
+  INCREMENTAL_GATHER_NOT_CACHED = 1,
+  // the root has kept the information last received from all ranks for the
+  // request, satellites only send their information if it changed.
+  INCREMENTAL_GATHER_CACHED = 2
+};
+
+// Serialized information kept for incremental gathers is limited to this many
+// bytes per process.
+const size_t MaximumGatherCacheSize = 64 * 1024 * 1024;
+
+// Returns a key identifying what is gathered.
+std::string vtkPVSessionCoreGatherRequest(vtkPVInformation* info, vtkTypeUInt32 globalid)
+{
+  vtkMultiProcessStream stream;
+  stream << info->GetClassName() << globalid;
+  info->CopyParametersToStream(stream);
+  std::vector<unsigned char> data;
+  stream.GetRawData(data);
+  return std::string(data.begin(), data.end());
+}
+}
+
 //****************************************************************************/
 //                        Internal Class
 //****************************************************************************/
@@ -229,6 +262,63 @@ public:
       iter++;
     }
   }
+  //---------------------------------------------------------------------------
+  // Serialized information exchanged by CollectInformation() for a request.
+  // On the root, Streams holds the information last received from each rank,
+  // on satellites the information last sent.
+  struct GatherCacheItem
+  {
+    std::vector<std::string> Streams;
+    std::list<std::string>::iterator Position;
+  };
+
+  GatherCacheItem* GetGatherCacheItem(const std::string& request, bool create)
+  {
+    auto iter = this->GatherCache.find(request);
+    if (iter == this->GatherCache.end())
+    {
+      if (!create)
+      {
+        return NULL;
+      }
+      iter = this->GatherCache.insert(std::make_pair(request, GatherCacheItem())).first;
+      this->GatherCacheOrder.push_front(request);
+      iter->second.Position = this->GatherCacheOrder.begin();
+    }
+    else
+    {
+      this->GatherCacheOrder.splice(
+        this->GatherCacheOrder.begin(), this->GatherCacheOrder, iter->second.Position);
+    }
+    return &iter->second;
+  }
+
+  // Drop the least recently used requests until the cache fits in
+  // MaximumGatherCacheSize. The most recent request is always kept.
+  void PruneGatherCache()
+  {
+    size_t size = 0;
+    for (const auto& item : this->GatherCache)
+    {
+      size += item.first.size();
+      for (const auto& str : item.second.Streams)
+      {
+        size += str.size();
+      }
+    }
+    while (size > MaximumGatherCacheSize && this->GatherCacheOrder.size() > 1)
+    {
+      auto iter = this->GatherCache.find(this->GatherCacheOrder.back());
+      size -= iter->first.size();
+      for (const auto& str : iter->second.Streams)
+      {
+        size -= str.size();
+      }
+      this->GatherCache.erase(iter);
+      this->GatherCacheOrder.pop_back();
+    }
+  }
+
   //---------------------------------------------------------------------------
   typedef std::map<vtkTypeUInt32, vtkWeakPointer<vtkSIObject> > SIObjectMapType;
   typedef std::map<vtkTypeUInt32, vtkWeakPointer<vtkObject> > RemoteObjectMapType;
@@ -239,6 +329,9 @@ public:
   unsigned long InterpreterObserverID;
   std::map<vtkTypeUInt32, vtkSMMessage> MessageCacheMap;
   std::set<int> KnownClients;
+  std::map<std::string, GatherCacheItem> GatherCache;
+  // requests in GatherCache, most recently used first.
+  std::list<std::string> GatherCacheOrder;
   // Used for collaboration as client may trigger invalid server request when
   // they are in a transitional state.
   bool DisableErrorMacro;
@@ -831,6 +924,8 @@ bool vtkPVSessionCore::GatherInformation(
 
   // send message to satellites and then start processing.
 
+  std::string request;
+  int mode = INCREMENTAL_GATHER_DISABLED;
   if (this->ParallelController && this->ParallelController->GetNumberOfProcesses() > 1 &&
     this->ParallelController->GetLocalProcessId() == 0 && !this->SymmetricMPIMode)
   {
@@ -845,8 +940,22 @@ bool vtkPVSessionCore::GatherInformation(
     unsigned char type = GATHER_INFORMATION;
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
+    // Satellites can skip sending information that did not change since the
+    // last time the same request was gathered, provided the root kept what
+    // they sent then.
+    if (vtksys::SystemTools::GetEnv("PV_DISABLE_INCREMENTAL_GATHER") == NULL)
+    {
+      request = vtkPVSessionCoreGatherRequest(information, globalid);
+      vtkInternals::GatherCacheItem* item = this->Internals->GetGatherCacheItem(request, false);
+      mode = (item &&
+               item->Streams.size() ==
+                 static_cast<size_t>(this->ParallelController->GetNumberOfProcesses()))
+        ? INCREMENTAL_GATHER_CACHED
+        : INCREMENTAL_GATHER_NOT_CACHED;
+    }
+
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid << mode;
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -854,7 +963,7 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->Broadcast(stream, 0);
   }
 
-  return this->CollectInformation(information);
+  return this->CollectInformation(information, request, mode);
 }
 
 //----------------------------------------------------------------------------
@@ -865,7 +974,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  int mode;
+  stream >> classname >> globalid >> mode;
 
   vtkSmartPointer<vtkObject> o;
   o.TakeReference(vtkPVInstantiator::CreateInstance(classname.c_str()));
@@ -874,7 +984,10 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   {
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
+    this->CollectInformation(info,
+      mode != INCREMENTAL_GATHER_DISABLED ? vtkPVSessionCoreGatherRequest(info, globalid)
+                                          : std::string(),
+      mode);
   }
   else
   {
@@ -895,6 +1008,13 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   }
 
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
+{
+  return this->CollectInformation(info, std::string(), INCREMENTAL_GATHER_DISABLED);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::CollectInformation(
+  vtkPVInformation* info, const std::string& request, int mode)
 {
   // Sanity checks
   assert("pre: NULL PV information!" && (info != NULL));
@@ -933,6 +1053,28 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   stream.GetData(&data, &length);
   vtkIdType local_length = static_cast<vtkIdType>(length);
 
+  // STEP 2.1: For incremental gathers, remember what is sent. Satellites send
+  // nothing if their information did not change and the root kept it.
+  vtkInternals::GatherCacheItem* cacheItem = NULL;
+  if (mode != INCREMENTAL_GATHER_DISABLED)
+  {
+    cacheItem = this->Internals->GetGatherCacheItem(request, true);
+    cacheItem->Streams.resize(rank == 0 ? nranks : 1);
+    if (rank != 0)
+    {
+      std::string& sent = cacheItem->Streams[0];
+      if (mode == INCREMENTAL_GATHER_CACHED && sent.size() == length &&
+        memcmp(sent.data(), data, length) == 0)
+      {
+        local_length = 0;
+      }
+      else
+      {
+        sent.assign(reinterpret_cast<const char*>(data), length);
+      }
+    }
+  }
+
   // STEP 3: Get number of bytes that each process will send
   this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
 
@@ -965,7 +1107,20 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     vtkClientServerStream rcvStream;
     for (int i = 1; i < nranks; ++i)
     {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
+      if (cacheItem)
+      {
+        std::string& received = cacheItem->Streams[i];
+        if (rcvcounts[i] > 0 || mode != INCREMENTAL_GATHER_CACHED)
+        {
+          received.assign(reinterpret_cast<const char*>(&rcvbuffer[offSet[i]]), rcvcounts[i]);
+        }
+        rcvStream.SetData(
+          reinterpret_cast<const unsigned char*>(received.data()), received.size());
+      }
+      else
+      {
+        rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
+      }
       vtkPVInformation* tempInfo = info->NewInstance();
       tempInfo->CopyFromStream(&rcvStream);
       info->AddInformation(tempInfo);
@@ -973,6 +1128,11 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     } // END for all remote ranks
   }   // END if rank == 0
 
+  if (cacheItem)
+  {
+    this->Internals->PruneGatherCache();
+  }
+
   // STEP 7: De-allocate temporary arrays at rank 0
   SafeDeleteArray(rcvcounts);
   SafeDeleteArray(offSet);
@@ -30,6 +30,8 @@
 #include "vtkSMMessageMinimal.h"                 // needed for vtkSMMessage.
 #include "vtkWeakPointer.h"                      // needed for vtkMultiProcessController
 
+#include <string> // needed for std::string
+
 class vtkClientServerInterpreter;
 class vtkClientServerStream;
 class vtkCollection;
@@ -215,6 +217,17 @@ protected:
    */
   bool CollectInformation(vtkPVInformation*);
 
+  /**
+   * Same as CollectInformation(vtkPVInformation*), but lets satellites skip
+   * sending their information when it is identical to what they sent the last
+   * time the same request was gathered; the root then reuses the information
+   * it received then. `request` identifies what is being gathered (class,
+   * global id and parameters of the information) and, like `mode`, must be
+   * the same on all ranks. `mode` is decided by the root, see
+   * GatherInformation().
+   */
+  bool CollectInformation(vtkPVInformation*, const std::string& request, int mode);
+
   /**
    * Increment reference count of a local vtkSIObject.
    */
@@ -17,6 +17,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkInformation.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -33,12 +34,18 @@ vtkStandardNewMacro(vtkSIMetaReaderProxy);
 vtkSIMetaReaderProxy::vtkSIMetaReaderProxy()
 {
   this->FileNameMethod = 0;
+  this->PrefetchObserverTag = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkSIMetaReaderProxy::~vtkSIMetaReaderProxy()
 {
   this->SetFileNameMethod(0);
+  vtkSIProxy* prefetchReader = this->GetSubSIProxy("PrefetchReader");
+  if (prefetchReader && this->PrefetchObserverTag)
+  {
+    prefetchReader->RemoveObserver(this->PrefetchObserverTag);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -61,6 +68,26 @@ void vtkSIMetaReaderProxy::OnCreateVTKObjects()
     stream << vtkClientServerStream::Invoke << this->GetVTKObject() << "SetFileNameMethod"
            << this->GetFileNameMethod() << vtkClientServerStream::End;
   }
+
+  // the optional PrefetchReader decodes files ahead on a background thread
+  // and must not be changed while it does.
+  vtkSIProxy* prefetchReader = this->GetSubSIProxy("PrefetchReader");
+  if (prefetchReader && prefetchReader->GetVTKObject())
+  {
+    stream << vtkClientServerStream::Invoke << this->GetVTKObject() << "SetPrefetchReader"
+           << prefetchReader->GetVTKObject() << vtkClientServerStream::End;
+    this->PrefetchObserverTag = prefetchReader->AddObserver(
+      vtkCommand::StartEvent, this, &vtkSIMetaReaderProxy::CancelPrefetch);
+  }
+  this->Interpreter->ProcessStream(stream);
+}
+
+//----------------------------------------------------------------------------
+void vtkSIMetaReaderProxy::CancelPrefetch()
+{
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << this->GetVTKObject() << "CancelPrefetch"
+         << vtkClientServerStream::End;
   this->Interpreter->ProcessStream(stream);
 }
 
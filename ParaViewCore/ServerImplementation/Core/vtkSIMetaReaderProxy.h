@@ -43,6 +43,13 @@ protected:
 
   void OnCreateVTKObjects() override;
 
+  /**
+   * Cancels the files being prefetched by the vtkFileSeriesReader with the
+   * PrefetchReader subproxy, before the properties of the PrefetchReader are
+   * pushed or pulled.
+   */
+  void CancelPrefetch();
+
   /**
    * Read xml-attributes.
    */
@@ -55,6 +62,8 @@ protected:
 
   char* FileNameMethod;
 
+  unsigned long PrefetchObserverTag;
+
 private:
   vtkSIMetaReaderProxy(const vtkSIMetaReaderProxy&) = delete;
   void operator=(const vtkSIMetaReaderProxy&) = delete;
@@ -18,6 +18,7 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkLogger.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -140,6 +141,12 @@ void vtkSIProxy::Push(vtkSMMessage* message)
   // Handle properties
   int cc = 0;
   int size = message->ExtensionSize(ProxyState::property);
+  if (size > 0)
+  {
+    // let observers, e.g. vtkSIMetaReaderProxy, wait for the VTK object to be
+    // unused before it is changed.
+    this->InvokeEvent(vtkCommand::StartEvent);
+  }
   for (; cc < size; cc++)
   {
     const ProxyState_Property& propMsg = message->GetExtension(ProxyState::property, cc);
@@ -190,6 +197,7 @@ void vtkSIProxy::Pull(vtkSMMessage* message)
   }
 
   message->ClearExtension(PullRequest::arguments);
+  this->InvokeEvent(vtkCommand::StartEvent);
 
   vtkInternals::SIPropertiesMapType::iterator iter;
   for (iter = this->Internals->SIProperties.begin(); iter != this->Internals->SIProperties.end();
@@ -47,12 +47,14 @@ public:
   void AboutToDelete() override;
 
   /**
-   * Push a new state to the underneath implementation
+   * Push a new state to the underneath implementation. Fires
+   * vtkCommand::StartEvent before the properties are set on the VTK object.
    */
   void Push(vtkSMMessage* msg) override;
 
   /**
-   * Pull the current state of the underneath implementation
+   * Pull the current state of the underneath implementation. Fires
+   * vtkCommand::StartEvent before the properties are read from the VTK object.
    */
   void Pull(vtkSMMessage* msg) override;
 
@@ -226,6 +226,7 @@ void vtkSISourceProxy::UpdatePipeline(int port, double time, bool doTime)
 
   vtkVLogScopeF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "%s: update pipeline(%d, %f, %s) ",
     this->GetLogNameOrDefault(), port, time, (doTime ? "true" : "false"));
+  PARAVIEW_TRACE_SCOPE("pipeline", "update pipeline");
 
   vtkAlgorithm* algo = output_port->GetProducer();
   assert(algo);
@@ -74,6 +74,24 @@ int vtkSMChartRepresentationProxy::ReadXMLAttributes(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMChartRepresentationProxy::RefineEarlyResult()
+{
+  vtkSMProperty* pending = this->GetProperty("RefinementPending");
+  if (!pending || !this->GetProperty("RefineResult"))
+  {
+    return false;
+  }
+
+  this->UpdatePropertyInformation(pending);
+  if (vtkSMPropertyHelper(pending).GetAsInt() == 0)
+  {
+    return false;
+  }
+  this->InvokeCommand("RefineResult");
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMChartRepresentationProxy::SetPropertyModifiedFlag(const char* name, int flag)
 {
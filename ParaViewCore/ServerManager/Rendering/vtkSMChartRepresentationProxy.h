@@ -44,6 +44,14 @@ public:
    */
   int ReadXMLAttributes(vtkSMSessionProxyManager* pm, vtkPVXMLElement* element) override;
 
+  /**
+   * For representations that support early results (see the "EarlyResult"
+   * property), requests the exact result when the current one is an estimate.
+   * This marks the representation, and thus the view, modified: returns true
+   * when the view needs another render to show the exact result.
+   */
+  bool RefineEarlyResult();
+
 protected:
   vtkSMChartRepresentationProxy();
   ~vtkSMChartRepresentationProxy() override;
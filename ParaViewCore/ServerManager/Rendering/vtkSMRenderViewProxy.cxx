@@ -188,10 +188,19 @@ void vtkSMRenderViewProxy::UpdateLOD()
     this->ExecuteStream(stream);
     this->GetSession()->CleanupPendingProgress();
 
-    this->NeedsUpdateLOD = false;
+    // keep updating the LOD while representations are building finer ones.
+    vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+    this->NeedsUpdateLOD = view && view->GetLODRefinementPending();
   }
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSMRenderViewProxy::GetLODRefinementPending()
+{
+  vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  return this->NeedsUpdateLOD && view && view->GetLODRefinementPending();
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSMRenderViewProxy::GetNeedsUpdate()
 {
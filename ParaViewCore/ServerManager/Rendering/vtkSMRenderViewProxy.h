@@ -178,6 +178,13 @@ public:
    */
   bool GetNeedsUpdate() override;
 
+  /**
+   * Returns true if some representations were still building finer LOD
+   * geometries when the LOD was last updated. Interactive renders should then
+   * be repeated to show the finer geometries once they are ready.
+   */
+  bool GetLODRefinementPending();
+
   /**
    * Called to render a streaming pass. Returns true if the view "streamed" some
    * geometry.
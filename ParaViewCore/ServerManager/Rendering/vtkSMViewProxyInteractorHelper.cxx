@@ -18,14 +18,23 @@
 #include "vtkObjectFactory.h"
 #include "vtkRenderWindowInteractor.h"
 #include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
 #include "vtkSMViewProxy.h"
 
 #include <cassert>
 
+namespace
+{
+// Interval in milliseconds between the interactive renders showing finer LOD
+// geometries as they are built.
+const unsigned long LODRefinementInterval = 100;
+}
+
 vtkStandardNewMacro(vtkSMViewProxyInteractorHelper);
 //----------------------------------------------------------------------------
 vtkSMViewProxyInteractorHelper::vtkSMViewProxyInteractorHelper()
   : DelayedRenderTimerId(-1)
+  , LODRefinementTimerId(-1)
   , Interacting(false)
   , Interacted(false)
 {
@@ -144,6 +153,7 @@ void vtkSMViewProxyInteractorHelper::Execute(vtkObject* caller, unsigned long ev
 
     case vtkCommand::EndInteractionEvent:
       this->Interacting = false;
+      this->CleanupTimer();
       if (this->Interacted)
       {
         this->Interacted = false;
@@ -174,6 +184,14 @@ void vtkSMViewProxyInteractorHelper::Execute(vtkObject* caller, unsigned long ev
         this->DelayedRenderTimerId = -1;
         this->Render();
       }
+      else if (this->LODRefinementTimerId == timerId)
+      {
+        this->LODRefinementTimerId = -1;
+        if (this->Interacting)
+        {
+          this->Render();
+        }
+      }
     }
   }
 }
@@ -188,6 +206,26 @@ void vtkSMViewProxyInteractorHelper::CleanupTimer()
     this->Interactor->DestroyTimer(this->DelayedRenderTimerId);
     this->DelayedRenderTimerId = -1;
   }
+  if (this->LODRefinementTimerId != -1)
+  {
+    assert(this->Interactor);
+    this->Interactor->DestroyTimer(this->LODRefinementTimerId);
+    this->LODRefinementTimerId = -1;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMViewProxyInteractorHelper::ScheduleLODRefinementRender()
+{
+  // render again while the representations are building finer LOD geometries,
+  // since the view would otherwise keep showing the coarse ones until the next
+  // interaction event.
+  vtkSMRenderViewProxy* rvProxy = vtkSMRenderViewProxy::SafeDownCast(this->ViewProxy);
+  if (this->LODRefinementTimerId == -1 && rvProxy && rvProxy->LastRenderWasInteractive() &&
+    rvProxy->GetLODRefinementPending())
+  {
+    this->LODRefinementTimerId = this->Interactor->CreateOneShotTimer(LODRefinementInterval);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -214,6 +252,7 @@ void vtkSMViewProxyInteractorHelper::Render()
   if (this->Interacting)
   {
     this->ViewProxy->InteractiveRender();
+    this->ScheduleLODRefinementRender();
   }
   else
   {
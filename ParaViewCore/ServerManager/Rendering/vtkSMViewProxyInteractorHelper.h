@@ -42,6 +42,12 @@
  * \li \c EnableRenderOnInteraction :- when present provides a flag whether the interactor
  * should trigger the render calls (either StillRender or InteractiveRender) as
  * a consequence of interaction. If missing, we treat EnableRender as ON.
+ *
+ * While interacting with a vtkSMRenderViewProxy whose representations are
+ * still building finer LOD geometries (see
+ * vtkSMRenderViewProxy::GetLODRefinementPending()), the interactive render is
+ * repeated periodically so that the finer geometries show up even if the user
+ * stops moving the mouse.
 */
 
 #ifndef vtkSMViewProxyInteractorHelper_h
@@ -94,6 +100,7 @@ protected:
   void Execute(vtkObject* caller, unsigned long event, void* calldata);
   void Render();
   void CleanupTimer();
+  void ScheduleLODRefinementRender();
   void Resize();
   //@}
 
@@ -101,6 +108,7 @@ protected:
   vtkWeakPointer<vtkSMViewProxy> ViewProxy;
   vtkWeakPointer<vtkRenderWindowInteractor> Interactor;
   int DelayedRenderTimerId;
+  int LODRefinementTimerId;
   bool Interacting;
   bool Interacted;
 
@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCGNSReaderDecodeInParallel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that zones decoded with DecodeInParallel have the same points, cells
+// and solutions as when they are decoded while being read, for single and
+// double precision meshes.
+#include "vtkCGNSReader.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+#include <vector>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkMultiBlockDataSet> Read(
+  const std::string& fname, bool decodeInParallel, bool doublePrecision)
+{
+  vtkNew<vtkCGNSReader> reader;
+  reader->SetFileName(fname.c_str());
+  reader->SetDecodeInParallel(decodeInParallel);
+  reader->SetDoublePrecisionMesh(doublePrecision ? 1 : 0);
+  reader->UpdateInformation();
+  reader->EnableAllPointArrays();
+  reader->EnableAllCellArrays();
+  reader->Update();
+  return reader->GetOutput();
+}
+
+bool SameArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  vtk_assert(a->GetNumberOfArrays() == b->GetNumberOfArrays());
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* arrayA = a->GetArray(cc);
+    vtkDataArray* arrayB = arrayA ? b->GetArray(arrayA->GetName()) : nullptr;
+    if (!arrayA)
+    {
+      continue;
+    }
+    vtk_assert(arrayB && arrayA->GetDataType() == arrayB->GetDataType());
+    vtk_assert(arrayA->GetNumberOfValues() == arrayB->GetNumberOfValues());
+    for (vtkIdType vv = 0; vv < arrayA->GetNumberOfValues(); ++vv)
+    {
+      vtk_assert(arrayA->GetVariantValue(vv) == arrayB->GetVariantValue(vv));
+    }
+  }
+  return true;
+}
+
+bool SameZone(vtkPointSet* a, vtkPointSet* b)
+{
+  vtk_assert(a->GetNumberOfPoints() == b->GetNumberOfPoints());
+  vtk_assert(a->GetNumberOfCells() == b->GetNumberOfCells());
+  for (vtkIdType pp = 0; pp < a->GetNumberOfPoints(); ++pp)
+  {
+    double ptA[3], ptB[3];
+    a->GetPoint(pp, ptA);
+    b->GetPoint(pp, ptB);
+    vtk_assert(ptA[0] == ptB[0] && ptA[1] == ptB[1] && ptA[2] == ptB[2]);
+  }
+  vtk_assert(SameArrays(a->GetPointData(), b->GetPointData()));
+  vtk_assert(SameArrays(a->GetCellData(), b->GetCellData()));
+  return true;
+}
+
+bool SameCells(vtkUnstructuredGrid* a, vtkUnstructuredGrid* b)
+{
+  vtk_assert(b != nullptr);
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType cc = 0; cc < a->GetNumberOfCells(); ++cc)
+  {
+    vtk_assert(a->GetCellType(cc) == b->GetCellType(cc));
+    a->GetCellPoints(cc, idsA.GetPointer());
+    b->GetCellPoints(cc, idsB.GetPointer());
+    vtk_assert(idsA->GetNumberOfIds() == idsB->GetNumberOfIds());
+    for (vtkIdType pp = 0; pp < idsA->GetNumberOfIds(); ++pp)
+    {
+      vtk_assert(idsA->GetId(pp) == idsB->GetId(pp));
+    }
+  }
+  return true;
+}
+
+// Returns the number of zones compared, or -1 if they differ.
+int Compare(const std::string& fname, bool doublePrecision)
+{
+  cout << "Opening " << fname.c_str() << (doublePrecision ? " (double)" : " (float)") << endl;
+  vtkSmartPointer<vtkMultiBlockDataSet> serial = Read(fname, false, doublePrecision);
+  vtkSmartPointer<vtkMultiBlockDataSet> parallel = Read(fname, true, doublePrecision);
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(serial->NewIterator());
+  int numZones = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkPointSet* psSerial = vtkPointSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!psSerial)
+    {
+      continue;
+    }
+    vtkPointSet* psParallel = vtkPointSet::SafeDownCast(parallel->GetDataSet(iter));
+    vtkUnstructuredGrid* ugSerial = vtkUnstructuredGrid::SafeDownCast(psSerial);
+    if (!psParallel || !SameZone(psSerial, psParallel) ||
+      (ugSerial && !SameCells(ugSerial, vtkUnstructuredGrid::SafeDownCast(psParallel))))
+    {
+      cerr << "ERROR: block " << iter->GetCurrentFlatIndex() << " of " << fname
+           << " differs when decoded in parallel." << endl;
+      return -1;
+    }
+    ++numZones;
+  }
+  return numZones;
+}
+}
+
+int TestCGNSReaderDecodeInParallel(int argc, char* argv[])
+{
+  // Example_mixed.cgns and Example_nface_n.cgns have sections that are always
+  // decoded while being read, which must not be affected.
+  const char* files[] = { "Testing/Data/channelBump_solution.cgns",
+    "Testing/Data/test_node_and_cell.cgns", "Testing/Data/Example_mixed.cgns",
+    "Testing/Data/Example_nface_n.cgns" };
+  int numZones = 0;
+  for (const char* file : files)
+  {
+    char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, file);
+    std::string path = fname ? fname : "";
+    delete[] fname;
+
+    for (bool doublePrecision : { false, true })
+    {
+      const int count = Compare(path, doublePrecision);
+      if (count < 0)
+      {
+        return EXIT_FAILURE;
+      }
+      numZones += count;
+    }
+  }
+  if (numZones == 0)
+  {
+    cerr << "ERROR: no zone was compared." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << __FILE__ << " tests passed." << endl;
+  return EXIT_SUCCESS;
+}
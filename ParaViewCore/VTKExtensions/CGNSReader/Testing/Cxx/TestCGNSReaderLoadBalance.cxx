@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCGNSReaderLoadBalance.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the pieces read with LoadBalanceZones and
+// SplitLargeStructuredZones hold all the cells of a multi-zone file, and that
+// large zones are split between pieces.
+#include "vtkCGNSReader.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataSet.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Returns the total number of cells of the leaves and the number of cells of
+// the largest leaf.
+void CountCells(vtkMultiBlockDataSet* mb, vtkIdType& total, vtkIdType& largest)
+{
+  total = 0;
+  largest = 0;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(mb->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      total += ds->GetNumberOfCells();
+      largest = std::max(largest, ds->GetNumberOfCells());
+    }
+  }
+}
+}
+
+int TestCGNSReaderLoadBalance(int argc, char* argv[])
+{
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/VisItBridge/5blocks.cgns");
+  std::string fivezones = fname ? fname : "";
+  delete[] fname;
+
+  cout << "Opening " << fivezones.c_str() << endl;
+  vtkNew<vtkCGNSReader> reader;
+  reader->SetFileName(fivezones.c_str());
+  reader->UpdatePiece(0, 1, 0);
+
+  vtkIdType expected, largestZone;
+  CountCells(reader->GetOutput(), expected, largestZone);
+  vtk_assert(expected > 0);
+  vtk_assert(largestZone > 1);
+
+  reader->LoadBalanceZonesOn();
+  for (bool split : { false, true })
+  {
+    reader->SetSplitLargeStructuredZones(split);
+    // 8 pieces is more than the number of zones, so that the largest zone is
+    // larger than the average load and is split.
+    for (int numPieces : { 2, 3, 8 })
+    {
+      vtkIdType total = 0;
+      vtkIdType largestPiece = 0;
+      for (int piece = 0; piece < numPieces; ++piece)
+      {
+        reader->UpdatePiece(piece, numPieces, 0);
+        vtkIdType cells, largest;
+        CountCells(reader->GetOutput(), cells, largest);
+        total += cells;
+        largestPiece = std::max(largestPiece, largest);
+      }
+      cout << numPieces << " pieces, split " << split << ": " << total << " cells" << endl;
+      vtk_assert(total == expected);
+      if (split && numPieces == 8)
+      {
+        vtk_assert(largestPiece < largestZone);
+      }
+    }
+  }
+
+  cout << __FILE__ << " tests passed." << endl;
+  return EXIT_SUCCESS;
+}
@@ -674,6 +674,19 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
     return 1;
   }
 
+  // Zone_t data is (VertexSize, CellSize, VertexSizeBoundary) for each index
+  // dimension.
+  std::vector<vtkTypeInt64> zsize;
+  if (CGNSRead::readNodeDataAs<vtkTypeInt64>(cgioNum, zoneId, zsize) == 0 && zsize.size() >= 3 &&
+    zsize.size() <= 9)
+  {
+    zoneInfo.indexDim = static_cast<int>(zsize.size() / 3);
+    for (int cc = 0; cc < zoneInfo.indexDim; ++cc)
+    {
+      zoneInfo.cellDims[cc] = zsize[zoneInfo.indexDim + cc];
+    }
+  }
+
   std::vector<double> zoneChildren;
   getNodeChildrenId(cgioNum, zoneId, zoneChildren);
   for (double zoneChildId : zoneChildren)
@@ -689,6 +702,12 @@ int readZoneInfo(int cgioNum, double zoneId, CGNSRead::ZoneInformation& zoneInfo
           fname.c_str() + std::min(fname.size() + 1, sizeof(zoneInfo.family)), zoneInfo.family);
         zoneInfo.family[32] = 0;
       }
+      else if (strcmp(nodeLabel, "ZoneType_t") == 0)
+      {
+        std::string zoneType;
+        CGNSRead::readNodeStringData(cgioNum, zoneChildId, zoneType);
+        zoneInfo.structured = (zoneType == "Structured");
+      }
       else if (strcmp(nodeLabel, "ZoneBC_t") == 0)
       {
         std::vector<double> zoneBCChildren;
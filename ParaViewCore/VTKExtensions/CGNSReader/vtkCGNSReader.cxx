@@ -43,9 +43,11 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataCache.h"
 #include "vtkPVInformationKeys.h"
 #include "vtkPointData.h"
 #include "vtkPolyhedron.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTypeInt32Array.h"
@@ -60,6 +62,7 @@
 #include <functional>
 #include <iterator>
 #include <map>
+#include <queue>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -102,6 +105,249 @@ private:
   int pair[2];
 };
 
+// A zone, or a slab of a structured zone, to read.
+struct ZonePiece
+{
+  int Zone;
+  bool Split;
+  int VOI[6]; // point extent of the slab when Split is true.
+};
+
+//------------------------------------------------------------------------------
+/**
+ * Assigns zones to `numPieces` ranks by their number of cells using the
+ * longest-processing-time-first heuristic: zones are sorted by decreasing size
+ * and each is given to the rank with the fewest cells so far. When `split` is
+ * true, structured zones larger than the average load per rank are first cut
+ * into slabs along their largest index direction, the slabs of a zone going
+ * to different ranks. All ranks compute the same assignment and this returns
+ * the pieces to read by `piece`, per base.
+ */
+std::map<int, std::vector<ZonePiece> > BalanceZones(
+  CGNSRead::vtkCGNSMetaData* metadata, int piece, int numPieces, bool split)
+{
+  struct WorkItem
+  {
+    vtkTypeInt64 Cells;
+    int Base;
+    ZonePiece Piece;
+  };
+  std::vector<WorkItem> items;
+
+  // zones with unknown size still count for something.
+  vtkTypeInt64 totalCells = 0;
+  const int numBases = metadata->GetNumberOfBaseNodes();
+  for (int bb = 0; bb < numBases; ++bb)
+  {
+    const CGNSRead::BaseInformation& baseInfo = metadata->GetBase(bb);
+    for (int zz = 0; zz < baseInfo.nzones; ++zz)
+    {
+      totalCells += zz < static_cast<int>(baseInfo.zones.size())
+        ? std::max<vtkTypeInt64>(baseInfo.zones[zz].GetNumberOfCells(), 1)
+        : 1;
+    }
+  }
+  const vtkTypeInt64 target = std::max<vtkTypeInt64>((totalCells + numPieces - 1) / numPieces, 1);
+
+  for (int bb = 0; bb < numBases; ++bb)
+  {
+    const CGNSRead::BaseInformation& baseInfo = metadata->GetBase(bb);
+    for (int zz = 0; zz < baseInfo.nzones; ++zz)
+    {
+      WorkItem item;
+      item.Base = bb;
+      item.Piece.Zone = zz;
+      item.Piece.Split = false;
+      std::fill(item.Piece.VOI, item.Piece.VOI + 6, 0);
+      if (zz >= static_cast<int>(baseInfo.zones.size()))
+      {
+        item.Cells = 1;
+        items.push_back(item);
+        continue;
+      }
+
+      const CGNSRead::ZoneInformation& zoneInfo = baseInfo.zones[zz];
+      item.Cells = std::max<vtkTypeInt64>(zoneInfo.GetNumberOfCells(), 1);
+      if (split && zoneInfo.structured && item.Cells > target)
+      {
+        const vtkTypeInt64* cellDims = zoneInfo.cellDims;
+        const int axis = static_cast<int>(
+          std::max_element(cellDims, cellDims + zoneInfo.indexDim) - cellDims);
+        const vtkTypeInt64 count = cellDims[axis];
+        const vtkTypeInt64 numSlabs = std::min<vtkTypeInt64>(
+          std::min<vtkTypeInt64>((item.Cells + target - 1) / target, numPieces), count);
+        if (numSlabs > 1)
+        {
+          item.Piece.Split = true;
+          for (int dd = 0; dd < zoneInfo.indexDim; ++dd)
+          {
+            item.Piece.VOI[2 * dd + 1] = static_cast<int>(cellDims[dd]);
+          }
+          for (vtkTypeInt64 ss = 0; ss < numSlabs; ++ss)
+          {
+            // slabs share their boundary points.
+            const vtkTypeInt64 start = ss * count / numSlabs;
+            const vtkTypeInt64 end = (ss + 1) * count / numSlabs;
+            WorkItem slab = item;
+            slab.Piece.VOI[2 * axis] = static_cast<int>(start);
+            slab.Piece.VOI[2 * axis + 1] = static_cast<int>(end);
+            slab.Cells = std::max<vtkTypeInt64>(item.Cells / count * (end - start), 1);
+            items.push_back(slab);
+          }
+          continue;
+        }
+      }
+      items.push_back(item);
+    }
+  }
+
+  std::stable_sort(items.begin(), items.end(),
+    [](const WorkItem& a, const WorkItem& b) { return a.Cells > b.Cells; });
+
+  typedef std::pair<vtkTypeInt64, int> LoadType;
+  std::priority_queue<LoadType, std::vector<LoadType>, std::greater<LoadType> > loads;
+  for (int cc = 0; cc < numPieces; ++cc)
+  {
+    loads.push(LoadType(0, cc));
+  }
+
+  // ranks already holding a slab of a split zone, keyed by (base, zone).
+  std::map<std::pair<int, int>, std::set<int> > slabOwners;
+  std::map<int, std::vector<ZonePiece> > result;
+  std::vector<LoadType> skipped;
+  for (const WorkItem& item : items)
+  {
+    std::set<int>* owners =
+      item.Piece.Split ? &slabOwners[std::make_pair(item.Base, item.Piece.Zone)] : nullptr;
+    LoadType least = loads.top();
+    loads.pop();
+    while (owners && owners->count(least.second) > 0)
+    {
+      skipped.push_back(least);
+      least = loads.top();
+      loads.pop();
+    }
+    for (const LoadType& load : skipped)
+    {
+      loads.push(load);
+    }
+    skipped.clear();
+
+    if (owners)
+    {
+      owners->insert(least.second);
+    }
+    if (least.second == piece)
+    {
+      result[item.Base].push_back(item.Piece);
+    }
+    least.first += item.Cells;
+    loads.push(least);
+  }
+
+  // read zones in file order.
+  for (auto& iter : result)
+  {
+    std::stable_sort(iter.second.begin(), iter.second.end(),
+      [](const ZonePiece& a, const ZonePiece& b) { return a.Zone < b.Zone; });
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Converts the connectivity of the single element type sections of a zone to
+ * a VTK cell array: the number of points is written in front of each cell and
+ * the CGNS 1-based node indices are made 0-based and put in VTK order. The
+ * sections are read in series, as cgio is not thread-safe, and added here,
+ * then all their cells are decoded in parallel.
+ */
+class SectionDecoder
+{
+public:
+  SectionDecoder()
+    : NumberOfCells(0)
+  {
+  }
+
+  // `elements` holds `numCells` cells of `numPointsPerCell` points, each
+  // preceded by a free slot; `cellTypes` receives the type of these cells.
+  void AddSection(vtkIdType* elements, vtkIdType numCells, int numPointsPerCell, int cellType,
+    bool reorder, int* cellTypes)
+  {
+    if (numCells <= 0)
+    {
+      return;
+    }
+    Section section;
+    section.Elements = elements;
+    section.FirstCell = this->NumberOfCells;
+    section.NumberOfCells = numCells;
+    section.NumberOfPointsPerCell = numPointsPerCell;
+    section.CellType = cellType;
+    section.Reorder = reorder;
+    section.CellTypes = cellTypes;
+    this->Sections.push_back(section);
+    this->NumberOfCells += numCells;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto iter = std::upper_bound(this->Sections.begin(), this->Sections.end(), begin,
+      [](vtkIdType cell, const Section& section) { return cell < section.FirstCell; });
+    for (--iter; begin < end; ++iter)
+    {
+      const vtkIdType first = begin - iter->FirstCell;
+      const vtkIdType last = std::min(end - iter->FirstCell, iter->NumberOfCells);
+      this->DecodeCells(*iter, first, last);
+      begin = iter->FirstCell + last;
+    }
+  }
+
+  // Decodes the sections added since the last call.
+  void Decode()
+  {
+    vtkSMPTools::For(0, this->NumberOfCells, *this);
+    this->Sections.clear();
+    this->NumberOfCells = 0;
+  }
+
+private:
+  struct Section
+  {
+    vtkIdType* Elements;
+    vtkIdType FirstCell;
+    vtkIdType NumberOfCells;
+    int NumberOfPointsPerCell;
+    int CellType;
+    bool Reorder;
+    int* CellTypes;
+  };
+
+  void DecodeCells(const Section& section, vtkIdType first, vtkIdType last)
+  {
+    const vtkIdType npe = section.NumberOfPointsPerCell;
+    vtkIdType* cells = section.Elements + first * (npe + 1);
+    vtkIdType pos = 0;
+    for (vtkIdType icell = first; icell < last; ++icell)
+    {
+      section.CellTypes[icell] = section.CellType;
+      cells[pos++] = npe;
+      for (vtkIdType ip = 0; ip < npe; ++ip, ++pos)
+      {
+        cells[pos] = cells[pos] - 1;
+      }
+    }
+    if (section.Reorder)
+    {
+      CGNSRead::CGNS2VTKorderMonoElem(last - first, section.CellType, cells);
+    }
+  }
+
+  std::vector<Section> Sections;
+  vtkIdType NumberOfCells;
+};
+
 class SectionInformation
 {
 public:
@@ -358,7 +604,8 @@ public:
     return vtkDataSet::SafeDownCast(zoneDO);
   }
 
-  static std::string GenerateMeshKey(const char* basename, const char* zonename);
+  static std::string GenerateMeshKey(
+    vtkCGNSReader* self, const char* basename, const char* zonename);
 };
 
 //----------------------------------------------------------------------------
@@ -366,8 +613,6 @@ vtkCGNSReader::vtkCGNSReader()
   : PointDataArraySelection()
   , CellDataArraySelection()
   , Internal(new CGNSRead::vtkCGNSMetaData())
-  , MeshPointsCache()
-  , ConnectivitiesCache()
 {
   this->FileName = NULL;
 
@@ -382,6 +627,9 @@ vtkCGNSReader::vtkCGNSReader()
   this->CreateEachSolutionAsBlock = 0;
   this->IgnoreFlowSolutionPointers = false;
   this->DistributeBlocks = true;
+  this->LoadBalanceZones = false;
+  this->SplitLargeStructuredZones = false;
+  this->DecodeInParallel = false;
   this->IgnoreSILChangeEvents = false;
   this->CacheMesh = false;
   this->CacheConnectivity = false;
@@ -410,8 +658,7 @@ vtkCGNSReader::vtkCGNSReader()
 vtkCGNSReader::~vtkCGNSReader()
 {
   this->SetFileName(0);
-  this->MeshPointsCache.ClearCache();
-  this->ConnectivitiesCache.ClearCache();
+  vtkPVDataCache::GetInstance()->RemoveOwner(this);
 
   this->PointDataArraySelection->RemoveObserver(this->SelectionObserver);
   this->CellDataArraySelection->RemoveObserver(this->SelectionObserver);
@@ -456,10 +703,11 @@ void vtkCGNSReader::SetController(vtkMultiProcessController* c)
 
 //------------------------------------------------------------------------------
 
-std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(const char* basename, const char* zonename)
+std::string vtkCGNSReader::vtkPrivate::GenerateMeshKey(
+  vtkCGNSReader* self, const char* basename, const char* zonename)
 {
   std::ostringstream query;
-  query << "/" << basename << "/" << zonename;
+  query << vtkPVDataCache::GetOwnerKey(self) << "mesh/" << basename << "/" << zonename;
   return query.str();
 }
 
@@ -1016,6 +1264,31 @@ int vtkCGNSReader::vtkPrivate::readSolution(const std::string& solutionNameStr,
         vtkGenericWarningMacro(<< "cgio_read_data :" << message);
       }
     }
+    else if (self->DecodeInParallel)
+    {
+      // read the component contiguously, then interleave it using several
+      // threads.
+      vtkDataArray* vectorArray = vtkVars[ff];
+      std::vector<char> component(static_cast<size_t>(nVals) * vectorArray->GetDataTypeSize());
+      if (cgio_read_data(self->cgioNum, cgioVarId, fieldSrcStart, fieldSrcEnd, fieldSrcStride,
+            cellDim, fieldMemDims, fieldMemStart, fieldMemEnd, fieldMemStride,
+            (void*)component.data()) != CG_OK)
+      {
+        char message[81];
+        cgio_error_message(message);
+        vtkGenericWarningMacro(<< "cgio_read_data :" << message);
+      }
+      else
+      {
+        switch (vectorArray->GetDataType())
+        {
+          vtkTemplateMacro(CGNSRead::interleave_values(
+            reinterpret_cast<const VTK_TT*>(component.data()),
+            static_cast<VTK_TT*>(vectorArray->GetVoidPointer(cgnsVars[ff].xyzIndex - 1)),
+            physicalDim, nVals, true));
+        }
+      }
+    }
     else
     {
       if (cgio_read_data(self->cgioNum, cgioVarId, fieldSrcStart, fieldSrcEnd, fieldSrcStride,
@@ -1263,10 +1536,10 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     // Try to get from cache
     const char* basename = self->Internal->GetBase(base).name;
     const char* zonename = self->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key mesh/basename/zonename
+    keyMesh = vtkPrivate::GenerateMeshKey(self, basename, zonename);
 
-    points = self->MeshPointsCache.Find(keyMesh);
+    points = vtkPoints::SafeDownCast(vtkPVDataCache::GetInstance()->Find(keyMesh));
     if (points.Get() != nullptr)
     {
       // check storage data type
@@ -1361,17 +1634,19 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
     if (self->GetDoublePrecisionMesh() != 0) // DOUBLE PRECISION MESHPOINTS
     {
       CGNSRead::get_XYZ_mesh<double, float>(self->cgioNum, gridChildId, nCoordsArray, cellDim, nPts,
-        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get());
+        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get(),
+        self->DecodeInParallel);
     }
     else // SINGLE PRECISION MESHPOINTS
     {
       CGNSRead::get_XYZ_mesh<float, double>(self->cgioNum, gridChildId, nCoordsArray, cellDim, nPts,
-        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get());
+        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get(),
+        self->DecodeInParallel);
     }
     // Add points to cache
     if (caching)
     {
-      self->MeshPointsCache.Insert(keyMesh, points);
+      vtkPVDataCache::GetInstance()->Insert(keyMesh, points);
     }
   }
 
@@ -1420,8 +1695,8 @@ vtkSmartPointer<vtkDataObject> vtkCGNSReader::vtkPrivate::readCurvilinearZone(in
 }
 
 //------------------------------------------------------------------------------
-int vtkCGNSReader::GetCurvilinearZone(
-  int base, int zone, int cellDim, int physicalDim, void* v_zsize, vtkMultiBlockDataSet* mbase)
+int vtkCGNSReader::GetCurvilinearZone(int base, int zone, int cellDim, int physicalDim,
+  void* v_zsize, vtkMultiBlockDataSet* mbase, const int* voi)
 {
   cgsize_t* zsize = reinterpret_cast<cgsize_t*>(v_zsize);
 
@@ -1430,10 +1705,16 @@ int vtkCGNSReader::GetCurvilinearZone(
   const char* zonename = this->Internal->GetBase(base).zones[zone].name;
 
   vtkSmartPointer<vtkDataObject> zoneDO = sil->ReadGridForZone(basename, zonename)
-    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, nullptr, this)
+    ? vtkPrivate::readCurvilinearZone(base, zone, cellDim, physicalDim, zsize, voi, this)
     : vtkSmartPointer<vtkDataObject>();
   mbase->SetBlock(zone, zoneDO.Get());
 
+  // Patches of a zone split across ranks are read along with its first slab.
+  if (voi != nullptr && (voi[0] != 0 || voi[2] != 0 || voi[4] != 0))
+  {
+    return 0;
+  }
+
   //----------------------------------------------------------------------------
   // Handle boundary conditions (BC) patches
   //----------------------------------------------------------------------------
@@ -1478,7 +1759,7 @@ int vtkCGNSReader::GetCurvilinearZone(
             if (sil->ReadPatch(basename, zonename, binfo.Name))
             {
               const unsigned int idx = patchesMB->GetNumberOfBlocks();
-              vtkSmartPointer<vtkDataSet> ds = zoneGrid
+              vtkSmartPointer<vtkDataSet> ds = (zoneGrid && voi == nullptr)
                 ? binfo.CreateDataSet(cellDim, zoneGrid)
                 : vtkPrivate::readBCDataSet(binfo, base, zone, cellDim, physicalDim, zsize, this);
               vtkPrivate::AddIsPatchArray(ds, true);
@@ -1596,10 +1877,10 @@ int vtkCGNSReader::GetUnstructuredZone(
     // Try to get from cache
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
-    keyMesh = vtkPrivate::GenerateMeshKey(basename, zonename);
+    // build a key mesh/basename/zonename
+    keyMesh = vtkPrivate::GenerateMeshKey(this, basename, zonename);
 
-    points = this->MeshPointsCache.Find(keyMesh);
+    points = vtkPoints::SafeDownCast(vtkPVDataCache::GetInstance()->Find(keyMesh));
     if (points.Get() != nullptr)
     {
       // check storage data type
@@ -1637,17 +1918,19 @@ int vtkCGNSReader::GetUnstructuredZone(
     if (this->DoublePrecisionMesh != 0) // DOUBLE PRECISION MESHPOINTS
     {
       CGNSRead::get_XYZ_mesh<double, float>(this->cgioNum, gridChildId, nCoordsArray, cellDim, nPts,
-        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get());
+        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get(),
+        this->DecodeInParallel);
     }
     else // SINGLE PRECISION MESHPOINTS
     {
       CGNSRead::get_XYZ_mesh<float, double>(this->cgioNum, gridChildId, nCoordsArray, cellDim, nPts,
-        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get());
+        srcStart, srcEnd, srcStride, memStart, memEnd, memStride, memDims, points.Get(),
+        this->DecodeInParallel);
     }
     // Add points to cache
     if (caching)
     {
-      this->MeshPointsCache.Insert(keyMesh, points);
+      vtkPVDataCache::GetInstance()->Insert(keyMesh, points);
     }
   }
 
@@ -1872,12 +2155,14 @@ int vtkCGNSReader::GetUnstructuredZone(
     // else create new grid
     const char* basename = this->Internal->GetBase(base).name;
     const char* zonename = this->Internal->GetBase(base).zones[zone].name;
-    // build a key /basename/zonename
+    // build a key connectivity/basename/zonename/core
     std::ostringstream query;
-    query << "/" << basename << "/" << zonename << "/core";
+    query << vtkPVDataCache::GetOwnerKey(this) << "connectivity/" << basename << "/" << zonename
+          << "/core";
     keyConnect = query.str();
 
-    ugrid = this->ConnectivitiesCache.Find(keyConnect);
+    ugrid =
+      vtkUnstructuredGrid::SafeDownCast(vtkPVDataCache::GetInstance()->Find(keyConnect));
     if (ugrid.Get() != nullptr)
     {
       if ((ugrid->GetNumberOfCells() != numCoreCells && !hasNGon) ||
@@ -2187,6 +2472,7 @@ int vtkCGNSReader::GetUnstructuredZone(
       }
 
       // Iterate over core sections.
+      SectionDecoder decoder;
       for (std::vector<int>::iterator iter = coreSec.begin(); iter != coreSec.end(); ++iter)
       {
         size_t sec = *iter;
@@ -2218,9 +2504,12 @@ int vtkCGNSReader::GetUnstructuredZone(
 
           cellType = CGNSRead::GetVTKElemType(elemType, higherOrderWarning, reOrderElements);
           //
-          for (vtkIdType i = start - 1; i < end; i++)
+          if (!this->DecodeInParallel)
           {
-            cellsTypes[i] = cellType;
+            for (vtkIdType i = start - 1; i < end; i++)
+            {
+              cellsTypes[i] = cellType;
+            }
           }
           //
           cgsize_t eDataSize = 0;
@@ -2262,6 +2551,14 @@ int vtkCGNSReader::GetUnstructuredZone(
           CGNSRead::get_section_connectivity(this->cgioNum, cgioSectionId, 2, srcStart, srcEnd,
             srcStride, memStart, memEnd, memStride, memDim, localElements);
 
+          if (this->DecodeInParallel)
+          {
+            decoder.AddSection(localElements, elementSize, numPointsPerCell, cellType,
+              reOrderElements, &cellsTypes[start - 1]);
+            cgio_release_id(this->cgioNum, cgioSectionId);
+            continue;
+          }
+
           // Add numptspercell and do -1 on indexes
           for (vtkIdType icell = 0; icell < elementSize; ++icell)
           {
@@ -2341,6 +2638,7 @@ int vtkCGNSReader::GetUnstructuredZone(
 
         cgio_release_id(this->cgioNum, cgioSectionId);
       }
+      decoder.Decode();
 
       cells->SetCells(numCoreCells, cellLocations.GetPointer());
 
@@ -2350,7 +2648,7 @@ int vtkCGNSReader::GetUnstructuredZone(
     }
     if (caching)
     {
-      this->ConnectivitiesCache.Insert(keyConnect, ugrid);
+      vtkPVDataCache::GetInstance()->Insert(keyConnect, ugrid);
     }
   }
   //
@@ -2718,6 +3016,27 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // zones, or slabs of zones, to read for each base.
+  std::map<int, std::vector<ZonePiece> > baseToZonePieces;
+  if (this->LoadBalanceZones && numProcessors > 1)
+  {
+    baseToZonePieces = BalanceZones(
+      this->Internal, processNumber, numProcessors, this->SplitLargeStructuredZones);
+  }
+  else
+  {
+    for (const auto& iter : baseToZoneRange)
+    {
+      for (int zone = iter.second[0]; zone < iter.second[1]; ++zone)
+      {
+        ZonePiece piece;
+        piece.Zone = zone;
+        piece.Split = false;
+        baseToZonePieces[iter.first].push_back(piece);
+      }
+    }
+  }
+
   // Bnd Sections Not implemented yet for parallel
   if (numProcessors > 1)
   {
@@ -2888,10 +3207,9 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
     // so we don't keep ids for released nodes.
     baseChildId.resize(nz);
 
-    int zonemin = baseToZoneRange[numBase][0];
-    int zonemax = baseToZoneRange[numBase][1];
-    for (int zone = zonemin; zone < zonemax; ++zone)
+    for (const ZonePiece& piece : baseToZonePieces[numBase])
     {
+      const int zone = piece.Zone;
       CGNSRead::char_33 zoneName;
       cgsize_t zsize[9];
       CGNS_ENUMT(ZoneType_t) zt = CGNS_ENUMV(ZoneTypeNull);
@@ -2998,7 +3316,8 @@ int vtkCGNSReader::RequestData(vtkInformation* vtkNotUsed(request),
           break;
         case CGNS_ENUMV(Structured):
         {
-          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase);
+          ier = GetCurvilinearZone(numBase, zone, cellDim, physicalDim, zsize, mbase,
+            piece.Split ? piece.VOI : nullptr);
           if (ier != CG_OK)
           {
             vtkErrorMacro(<< "Error Reading file");
@@ -3137,6 +3456,9 @@ void vtkCGNSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CreateEachSolutionAsBlock: " << this->CreateEachSolutionAsBlock << endl;
   os << indent << "IgnoreFlowSolutionPointers: " << this->IgnoreFlowSolutionPointers << endl;
   os << indent << "DistributeBlocks: " << this->DistributeBlocks << endl;
+  os << indent << "LoadBalanceZones: " << this->LoadBalanceZones << endl;
+  os << indent << "SplitLargeStructuredZones: " << this->SplitLargeStructuredZones << endl;
+  os << indent << "DecodeInParallel: " << this->DecodeInParallel << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -3510,7 +3832,7 @@ void vtkCGNSReader::SetCacheMesh(bool enable)
   this->CacheMesh = enable;
   if (!enable)
   {
-    this->MeshPointsCache.ClearCache();
+    vtkPVDataCache::GetInstance()->RemovePrefix(vtkPVDataCache::GetOwnerKey(this) + "mesh/");
   }
 }
 
@@ -3520,7 +3842,8 @@ void vtkCGNSReader::SetCacheConnectivity(bool enable)
   this->CacheConnectivity = enable;
   if (!enable)
   {
-    this->ConnectivitiesCache.ClearCache();
+    vtkPVDataCache::GetInstance()->RemovePrefix(
+      vtkPVDataCache::GetOwnerKey(this) + "connectivity/");
   }
 }
 
@@ -35,7 +35,6 @@
 #ifndef vtkCGNSReader_h
 #define vtkCGNSReader_h
 
-#include "vtkCGNSCache.h" // for vtkCGNSCache, caching of mesh and connectivity
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkNew.h"                             // for vtkNew.
 #include "vtkPVVTKExtensionsCGNSReaderModule.h" // for export macro
@@ -212,11 +211,53 @@ public:
   vtkGetMacro(DistributeBlocks, bool);
   vtkBooleanMacro(DistributeBlocks, bool);
 
+  //@{
+  /**
+   * When DistributeBlocks is on, zones are by default handed out to ranks in
+   * contiguous ranges with the same number of zones. When LoadBalanceZones is
+   * set to true, zones are instead assigned using their number of cells,
+   * largest first, each to the rank with the fewest cells so far.
+   * Default is false.
+   */
+  vtkSetMacro(LoadBalanceZones, bool);
+  vtkGetMacro(LoadBalanceZones, bool);
+  vtkBooleanMacro(LoadBalanceZones, bool);
+  //@}
+
+  //@{
+  /**
+   * When LoadBalanceZones is on, structured zones with more cells than the
+   * average number of cells per rank can be split along their largest index
+   * direction, and the slabs read by different ranks. Boundary patches of a
+   * split zone are only read with its first slab. Default is false.
+   */
+  vtkSetMacro(SplitLargeStructuredZones, bool);
+  vtkGetMacro(SplitLargeStructuredZones, bool);
+  vtkBooleanMacro(SplitLargeStructuredZones, bool);
+  //@}
+
+  //@{
+  /**
+   * When on, the connectivity of the element sections of an unstructured zone
+   * is read for all sections first and then decoded (0-based indices, VTK node
+   * ordering) in parallel using vtkSMPTools. Likewise, the grid coordinates and
+   * the components of vector solutions are read contiguously and then
+   * converted to the point type and interleaved in parallel. Reading itself
+   * stays serial since the CGNS library is not thread-safe. MIXED, NGON_n and
+   * NFACE_n sections are always decoded as they are read. Default is false.
+   */
+  vtkSetMacro(DecodeInParallel, bool);
+  vtkGetMacro(DecodeInParallel, bool);
+  vtkBooleanMacro(DecodeInParallel, bool);
+  //@}
+
   //@{
   /**
    * This reader can cache the mesh points if they are time invariant.
    * They will be stored with a unique reference to their /base/zonename
    * and not be read in the file when doing unsteady analysis.
+   * The points are kept in the vtkPVDataCache shared by all readers and may be
+   * evicted when it runs out of memory.
    */
   void SetCacheMesh(bool enable);
   vtkGetMacro(CacheMesh, bool);
@@ -227,6 +268,8 @@ public:
    * This reader can cache the meshconnectivities if they are time invariant.
    * They will be stored with a unique reference to their /base/zonename
    * and not be read in the file when doing unsteady analysis.
+   * The connectivities are kept in the vtkPVDataCache shared by all readers
+   * and may be evicted when it runs out of memory.
    */
   void SetCacheConnectivity(bool enable);
   vtkGetMacro(CacheConnectivity, bool);
@@ -272,8 +315,9 @@ protected:
   static void SelectionModifiedCallback(
     vtkObject* caller, unsigned long eid, void* clientdata, void* calldata);
 
-  int GetCurvilinearZone(
-    int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
+  // `voi`, when not null, is the point extent of the zone to read.
+  int GetCurvilinearZone(int base, int zone, int cell_dim, int phys_dim, void* zsize,
+    vtkMultiBlockDataSet* mbase, const int* voi = nullptr);
 
   int GetUnstructuredZone(
     int base, int zone, int cell_dim, int phys_dim, void* zsize, vtkMultiBlockDataSet* mbase);
@@ -291,10 +335,7 @@ private:
   void OnSILStateChanged();
   bool IgnoreSILChangeEvents;
 
-  CGNSRead::vtkCGNSMetaData* Internal;               // Metadata
-  CGNSRead::vtkCGNSCache<vtkPoints> MeshPointsCache; // Cache for the mesh points
-  CGNSRead::vtkCGNSCache<vtkUnstructuredGrid>
-    ConnectivitiesCache; // Cache for the mesh connectivities
+  CGNSRead::vtkCGNSMetaData* Internal; // Metadata
 
   char* FileName; // cgns file name
 #if !defined(VTK_LEGACY_REMOVE)
@@ -305,6 +346,9 @@ private:
   int CreateEachSolutionAsBlock; // debug option to create
   bool IgnoreFlowSolutionPointers;
   bool DistributeBlocks;
+  bool LoadBalanceZones;
+  bool SplitLargeStructuredZones;
+  bool DecodeInParallel;
   bool CacheMesh;
   bool CacheConnectivity;
 
@@ -1045,6 +1045,8 @@ static void BroadcastZones(
     {
       stream.Push(zinfo.name, 33);
       stream.Push(zinfo.family, 33);
+      stream << zinfo.structured << zinfo.indexDim << zinfo.cellDims[0] << zinfo.cellDims[1]
+             << zinfo.cellDims[2];
       stream << static_cast<unsigned int>(zinfo.bcs.size());
       for (auto& bcinfo : zinfo.bcs)
       {
@@ -1067,6 +1069,8 @@ static void BroadcastZones(
       stream.Pop(cref, size);
       cref = zinfo.family;
       stream.Pop(cref, size);
+      stream >> zinfo.structured >> zinfo.indexDim >> zinfo.cellDims[0] >> zinfo.cellDims[1] >>
+        zinfo.cellDims[2];
       stream >> count;
       zinfo.bcs.resize(count);
       for (auto& bcinfo : zinfo.bcs)
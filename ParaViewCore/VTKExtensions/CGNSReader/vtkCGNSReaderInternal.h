@@ -40,6 +40,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtk_cgns.h"
 
 namespace CGNSRead
@@ -70,6 +71,42 @@ struct is_float<float>
 {
   static const bool value = true;
 };
+
+// Copies contiguous values read from the file to every `Stride` value of
+// the destination, converting them to its type.
+template <typename T, typename Y>
+struct InterleaveValues
+{
+  const Y* Source;
+  T* Destination;
+  vtkIdType Stride;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      this->Destination[this->Stride * ii] = static_cast<T>(this->Source[ii]);
+    }
+  }
+};
+}
+
+//------------------------------------------------------------------------------
+// Interleaves and converts `nValues` values, using vtkSMPTools when
+// `parallel` is true.
+template <typename T, typename Y>
+void interleave_values(
+  const Y* source, T* destination, vtkIdType stride, vtkIdType nValues, bool parallel)
+{
+  detail::InterleaveValues<T, Y> interleave = { source, destination, stride };
+  if (parallel)
+  {
+    vtkSMPTools::For(0, nValues, interleave);
+  }
+  else
+  {
+    interleave(0, nValues);
+  }
 }
 
 typedef char char_33[33];
@@ -185,10 +222,30 @@ public:
   char_33 name;
   char_33 family;
   std::vector<CGNSRead::ZoneBCInformation> bcs;
+  // zone size from the Zone_t node, used to balance zones across ranks.
+  bool structured;
+  int indexDim;
+  vtkTypeInt64 cellDims[3]; // number of cells along each index direction
   ZoneInformation()
   {
     this->name[0] = '\0';
     this->family[0] = '\0';
+    this->structured = true;
+    this->indexDim = 0;
+    this->cellDims[0] = this->cellDims[1] = this->cellDims[2] = 0;
+  }
+
+  /**
+   * Returns the number of cells in the zone.
+   */
+  vtkTypeInt64 GetNumberOfCells() const
+  {
+    vtkTypeInt64 count = this->indexDim > 0 ? 1 : 0;
+    for (int cc = 0; cc < this->indexDim; ++cc)
+    {
+      count *= this->cellDims[cc];
+    }
+    return count;
   }
 };
 
@@ -399,7 +456,7 @@ int get_XYZ_mesh(const int cgioNum, const std::vector<double>& gridChildId,
   const std::size_t& nCoordsArray, const int cellDim, const vtkIdType nPts,
   const cgsize_t* srcStart, const cgsize_t* srcEnd, const cgsize_t* srcStride,
   const cgsize_t* memStart, const cgsize_t* memEnd, const cgsize_t* memStride,
-  const cgsize_t* memDims, vtkPoints* points)
+  const cgsize_t* memDims, vtkPoints* points, bool decodeInParallel = false)
 {
   T* coords = static_cast<T*>(points->GetVoidPointer(0));
   T* currentCoord = static_cast<T*>(&(coords[0]));
@@ -461,8 +518,9 @@ int get_XYZ_mesh(const int cgioNum, const std::vector<double>& gridChildId,
 
     coordId = gridChildId[c - 1];
 
-    // quick transfer of data if same data types
-    if (sameType == true)
+    // quick transfer of data if same data types, unless the values are
+    // interleaved using several threads.
+    if (sameType == true && !decodeInParallel)
     {
       if (cgio_read_data(cgioNum, coordId, srcStart, srcEnd, srcStride, cellDim, memEnd, memStart,
             memEnd, memStride, (void*)currentCoord))
@@ -474,30 +532,29 @@ int get_XYZ_mesh(const int cgioNum, const std::vector<double>& gridChildId,
     }
     else
     {
-      Y* dataArray = 0;
       const cgsize_t memNoStride[3] = { 1, 1, 1 };
 
-      // need to read into temp array to convert data
-      dataArray = new Y[nPts];
-      if (dataArray == 0)
-      {
-        std::cerr << "Error allocating buffer array\n";
-        break;
-      }
+      // need to read into temp array to convert or interleave data
+      std::vector<Y> convertArray(sameType ? 0 : nPts);
+      std::vector<T> sameTypeArray(sameType ? nPts : 0);
+      void* dataArray = sameType ? static_cast<void*>(sameTypeArray.data())
+                                 : static_cast<void*>(convertArray.data());
       if (cgio_read_data(cgioNum, coordId, srcStart, srcEnd, srcStride, cellDim, memDims, memStart,
-            memDims, memNoStride, (void*)dataArray))
+            memDims, memNoStride, dataArray))
       {
-        delete[] dataArray;
         char message[81];
         cgio_error_message(message);
         std::cerr << "Buffer array cgio_read_data :" << message;
         break;
       }
-      for (vtkIdType ii = 0; ii < nPts; ++ii)
+      if (sameType)
+      {
+        interleave_values(sameTypeArray.data(), currentCoord, memStride[0], nPts, decodeInParallel);
+      }
+      else
       {
-        currentCoord[memStride[0] * ii] = static_cast<T>(dataArray[ii]);
+        interleave_values(convertArray.data(), currentCoord, memStride[0], nPts, decodeInParallel);
       }
-      delete[] dataArray;
     }
   }
   return 0;
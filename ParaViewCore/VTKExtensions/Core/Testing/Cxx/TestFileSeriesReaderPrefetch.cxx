@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFileSeriesReaderPrefetch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkFileSeriesReader decodes the files following the time
+// requests with its PrefetchReader, so that the internal reader does not
+// execute for them, and that the files are only read ahead without one.
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataCache.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int NumberOfFiles = 6;
+
+// Counts the executions of the reader.
+class CountingReader : public vtkXMLPolyDataReader
+{
+public:
+  static CountingReader* New();
+  vtkTypeMacro(CountingReader, vtkXMLPolyDataReader);
+  int Executions = 0;
+
+protected:
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    ++this->Executions;
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+};
+vtkStandardNewMacro(CountingReader);
+
+// Stands for the client-server wrapping of the readers, which this module
+// does not depend on.
+int ReaderCommand(vtkClientServerInterpreter*, vtkObjectBase* ptr, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  vtkXMLPolyDataReader* reader = vtkXMLPolyDataReader::SafeDownCast(ptr);
+  std::string fname;
+  if (reader && strcmp(method, "SetFileName") == 0 && msg.GetArgument(0, 2, &fname))
+  {
+    reader->SetFileName(fname.c_str());
+    return 1;
+  }
+  result << vtkClientServerStream::Error << "Unexpected call to " << method
+         << vtkClientServerStream::End;
+  return 0;
+}
+
+void InitializeInterpreter(vtkClientServerInterpreter* interp)
+{
+  interp->AddCommandFunction("vtkXMLPolyDataReader", ReaderCommand);
+  interp->AddCommandFunction("CountingReader", ReaderCommand);
+}
+
+// Waits for the cache to hold `count` entries, as the files are prefetched
+// on a background thread.
+bool WaitForEntries(unsigned int count)
+{
+  vtkPVDataCache* cache = vtkPVDataCache::GetInstance();
+  for (int cc = 0; cc < 1000 && cache->GetNumberOfEntries() < count; ++cc)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return cache->GetNumberOfEntries() == count;
+}
+
+// File i has i + 1 points.
+void WriteFiles(const std::string& dir)
+{
+  vtksys::SystemTools::RemoveADirectory(dir);
+  vtksys::SystemTools::MakeDirectory(dir);
+  for (int i = 0; i < NumberOfFiles; ++i)
+  {
+    vtkNew<vtkPoints> points;
+    for (int cc = 0; cc <= i; ++cc)
+    {
+      points->InsertNextPoint(cc, i, 0);
+    }
+    vtkNew<vtkPolyData> polydata;
+    polydata->SetPoints(points);
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetInputData(polydata);
+    writer->SetFileName((dir + "/step_" + std::to_string(i) + ".vtp").c_str());
+    writer->Write();
+  }
+}
+
+void Setup(vtkFileSeriesReader* series, vtkAlgorithm* reader, const std::string& dir)
+{
+  series->SetReader(reader);
+  series->SetFileNameMethod("SetFileName");
+  for (int i = 0; i < NumberOfFiles; ++i)
+  {
+    series->AddFileName((dir + "/step_" + std::to_string(i) + ".vtp").c_str());
+  }
+}
+}
+
+int TestFileSeriesReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string dir = std::string(tempDir) + "/TestFileSeriesReaderPrefetch";
+  delete[] tempDir;
+  WriteFiles(dir);
+
+  vtkClientServerInterpreterInitializer::GetInitializer()->RegisterCallback(
+    &InitializeInterpreter);
+  vtkPVDataCache* cache = vtkPVDataCache::GetInstance();
+  cache->SetMemoryBudget(64 * 1024);
+
+  {
+    vtkNew<CountingReader> reader;
+    vtkNew<vtkXMLPolyDataReader> prefetchReader;
+    vtkNew<vtkFileSeriesReader> series;
+    Setup(series, reader, dir);
+    series->SetPrefetchReader(prefetchReader);
+    series->SetPrefetchCount(2);
+
+    // the first file is read by the internal reader, the following ones are
+    // decoded ahead by the time they are requested.
+    for (int i = 0; i < NumberOfFiles; ++i)
+    {
+      series->UpdateTimeStep(i);
+      vtkPolyData* output = vtkPolyData::SafeDownCast(series->GetOutputDataObject(0));
+      expect(output && output->GetNumberOfPoints() == i + 1,
+        "wrong output for file " << i << " after prefetching.");
+      expect(reader->Executions == 1,
+        "the internal reader executed " << reader->Executions << " times up to file " << i);
+      const unsigned int prefetched = std::min(i + 2, NumberOfFiles - 1);
+      expect(WaitForEntries(prefetched),
+        "the cache has " << cache->GetNumberOfEntries() << " entries after file " << i
+                         << ", expected " << prefetched);
+    }
+    series->CancelPrefetch();
+  }
+  expect(cache->GetNumberOfEntries() == 0, "the outputs of a deleted reader were kept.");
+
+  {
+    // without a PrefetchReader, the files are only read ahead.
+    vtkNew<CountingReader> reader;
+    vtkNew<vtkFileSeriesReader> series;
+    Setup(series, reader, dir);
+    series->SetPrefetchCount(2);
+    for (int i = 0; i < NumberOfFiles; ++i)
+    {
+      series->UpdateTimeStep(i);
+      vtkPolyData* output = vtkPolyData::SafeDownCast(series->GetOutputDataObject(0));
+      expect(output && output->GetNumberOfPoints() == i + 1,
+        "wrong output for file " << i << " after reading ahead.");
+    }
+    series->CancelPrefetch();
+    expect(reader->Executions == NumberOfFiles && cache->GetNumberOfEntries() == 0,
+      "files were decoded ahead without a PrefetchReader.");
+  }
+
+  vtksys::SystemTools::RemoveADirectory(dir);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVDataCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVDataCache evicts the least recently used entries to stay
+// within its budget, and that the default budget is shared by the processes
+// running on the host.
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPVDataCache.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+unsigned long GetDefaultBudget(const char* localSize)
+{
+  vtksys::SystemTools::PutEnv(std::string("OMPI_COMM_WORLD_LOCAL_SIZE=") + localSize);
+  vtkNew<vtkPVDataCache> cache;
+  vtksys::SystemTools::UnPutEnv("OMPI_COMM_WORLD_LOCAL_SIZE");
+  return cache->GetMemoryBudget();
+}
+}
+
+int TestPVDataCache(int, char* [])
+{
+  vtkNew<vtkPVDataCache> cache;
+  cache->SetMemoryBudget(300);
+  vtkNew<vtkFloatArray> a, b, c, d, replacement;
+
+  expect(cache->Insert("a", a, 100) && cache->Insert("b", b, 100) && cache->Insert("c", c, 100),
+    "entries within the budget were not inserted.");
+  expect(cache->GetMemoryUsage() == 300, "wrong usage " << cache->GetMemoryUsage());
+
+  // Entries are ordered from the most recently inserted or found: a, c, b.
+  expect(cache->Find("a").GetPointer() == a.GetPointer(), "an inserted entry was not found.");
+
+  // b is the least recently used entry: d, a, c.
+  expect(cache->Insert("d", d, 100), "an entry within the budget was not inserted.");
+  expect(cache->Find("b").GetPointer() == nullptr,
+    "the least recently used entry was not evicted.");
+  expect(cache->GetNumberOfEntries() == 3 && cache->GetMemoryUsage() == 300,
+    "wrong usage " << cache->GetMemoryUsage() << " after eviction.");
+
+  // Entries larger than the budget are not inserted and evict nothing.
+  expect(!cache->Insert("large", replacement, 301), "an entry over the budget was inserted.");
+  expect(cache->GetNumberOfEntries() == 3 && cache->Find("large").GetPointer() == nullptr,
+    "an entry over the budget changed the cache.");
+
+  // Inserting with an existing key replaces the entry: a, d, c.
+  expect(cache->Insert("a", replacement, 50), "an entry was not replaced.");
+  expect(cache->Find("a").GetPointer() == replacement.GetPointer() &&
+      cache->GetMemoryUsage() == 250,
+    "wrong usage " << cache->GetMemoryUsage() << " after replacing an entry.");
+
+  // Reducing the budget evicts the least recently used entries: a, d.
+  cache->SetMemoryBudget(150);
+  expect(cache->Find("c").GetPointer() == nullptr &&
+      cache->Find("d").GetPointer() == d.GetPointer() &&
+      cache->Find("a").GetPointer() == replacement.GetPointer(),
+    "reducing the budget did not evict the least recently used entry.");
+  expect(cache->GetMemoryUsage() == 150, "wrong usage " << cache->GetMemoryUsage());
+
+  // Without an explicit size, arrays use their actual memory size.
+  vtkNew<vtkFloatArray> large;
+  large->SetNumberOfValues(1 << 20);
+  expect(!cache->Insert("large", large), "an array over the budget was inserted.");
+  cache->SetMemoryBudget(8192);
+  expect(cache->Insert("large", large) &&
+      cache->GetMemoryUsage() == 150 + large->GetActualMemorySize(),
+    "wrong usage " << cache->GetMemoryUsage() << " for an array.");
+
+  cache->RemovePrefix("l");
+  expect(cache->GetNumberOfEntries() == 2 && cache->GetMemoryUsage() == 150,
+    "removing an entry did not free its memory.");
+  cache->SetMemoryBudget(0);
+  expect(cache->GetNumberOfEntries() == 0 && !cache->Insert("a", a, 1),
+    "a budget of 0 did not disable the cache.");
+
+  // The default budget is shared by the processes running on the host,
+  // unless the budget is given explicitly.
+  vtksys::SystemTools::UnPutEnv("PV_DATA_CACHE_BUDGET");
+  const unsigned long budget = GetDefaultBudget("1");
+  const unsigned long sharedBudget = GetDefaultBudget("4");
+  expect(budget > 0 && sharedBudget * 4 <= budget && budget < (sharedBudget + 1024) * 4,
+    "a default budget of " << sharedBudget << " KiB is not a quarter of " << budget << " KiB.");
+  vtksys::SystemTools::PutEnv("PV_DATA_CACHE_BUDGET=64");
+  expect(GetDefaultBudget("4") == 64 * 1024, "PV_DATA_CACHE_BUDGET was not used.");
+  vtksys::SystemTools::UnPutEnv("PV_DATA_CACHE_BUDGET");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,258 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestParallelSerialWriter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the files written by vtkParallelSerialWriter with several I/O ranks:
+// one file per group of processes and timestep holding the data of the
+// group, and a .pvd index for XML writers only.
+#include <mpi.h>
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkParallelSerialWriter.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+const int NumberOfTimeSteps = 3;
+const int NumberOfIORanks = 2;
+
+// Piece p has p + 1 vertices, at x = time.
+class PieceSource : public vtkPolyDataAlgorithm
+{
+public:
+  static PieceSource* New();
+  vtkTypeMacro(PieceSource, vtkPolyDataAlgorithm);
+
+protected:
+  PieceSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+    override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[NumberOfTimeSteps];
+    for (int cc = 0; cc < NumberOfTimeSteps; ++cc)
+    {
+      timeSteps[cc] = cc;
+    }
+    double timeRange[2] = { 0.0, NumberOfTimeSteps - 1.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+    override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkCellArray> verts;
+    for (vtkIdType cc = 0; cc <= piece; ++cc)
+    {
+      points->InsertNextPoint(time, piece, static_cast<double>(cc));
+      verts->InsertNextCell(1, &cc);
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+    output->SetPoints(points.GetPointer());
+    output->SetVerts(verts.GetPointer());
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PieceSource);
+
+// Stands for the client-server wrapping of the writers, which this module
+// does not depend on.
+template <typename WriterType>
+int WriterCommand(vtkClientServerInterpreter*, vtkObjectBase* ptr, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  WriterType* writer = WriterType::SafeDownCast(ptr);
+  std::string fname;
+  if (writer && strcmp(method, "SetFileName") == 0 && msg.GetArgument(0, 2, &fname))
+  {
+    writer->SetFileName(fname.c_str());
+    return 1;
+  }
+  if (writer && strcmp(method, "Write") == 0)
+  {
+    writer->Write();
+    return 1;
+  }
+  result << vtkClientServerStream::Error << "Unexpected call to " << method
+         << vtkClientServerStream::End;
+  return 0;
+}
+
+void Write(vtkAlgorithm* writer, vtkClientServerInterpreter* interp, const std::string& fname,
+  vtkMultiProcessController* controller)
+{
+  vtkNew<PieceSource> source;
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkParallelSerialWriter> psWriter;
+  psWriter->SetInterpreter(interp);
+  psWriter->SetWriter(writer);
+  psWriter->SetFileNameMethod("SetFileName");
+  psWriter->SetFileName(fname.c_str());
+  psWriter->SetPostGatherHelper(append.GetPointer());
+  psWriter->SetPiece(controller->GetLocalProcessId());
+  psWriter->SetNumberOfPieces(controller->GetNumberOfProcesses());
+  psWriter->SetWriteAllTimeSteps(1);
+  psWriter->SetNumberOfIORanks(NumberOfIORanks);
+  psWriter->SetInputConnection(source->GetOutputPort());
+  psWriter->Write();
+}
+
+// Checks that each group wrote a file per timestep and that the files of a
+// timestep hold the points of all the pieces.
+template <typename ReaderType>
+bool CheckParts(const std::string& dir, const char* ext, int numProcs)
+{
+  const vtkIdType expected = static_cast<vtkIdType>(numProcs) * (numProcs + 1) / 2;
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    vtkIdType numPoints = 0;
+    for (int group = 0; group < NumberOfIORanks; ++group)
+    {
+      std::ostringstream fname;
+      fname << dir << "/out_" << group << "." << step << ext;
+      if (!vtksys::SystemTools::FileExists(fname.str().c_str(), true))
+      {
+        cerr << "ERROR: " << fname.str() << " was not written." << endl;
+        return false;
+      }
+      vtkNew<ReaderType> reader;
+      reader->SetFileName(fname.str().c_str());
+      reader->Update();
+      numPoints += reader->GetOutput()->GetNumberOfPoints();
+    }
+    if (numPoints != expected)
+    {
+      cerr << "ERROR: timestep " << step << " has " << numPoints << " points in " << dir
+           << ", expected " << expected << "." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the number of datasets in a .pvd file, or -1 if it does not exist.
+int CountIndexEntries(const std::string& fname)
+{
+  std::ifstream index(fname.c_str());
+  if (!index)
+  {
+    return -1;
+  }
+  int count = 0;
+  std::string line;
+  while (std::getline(index, line))
+  {
+    count += line.find("<DataSet") != std::string::npos ? 1 : 0;
+  }
+  return count;
+}
+}
+
+int TestParallelSerialWriter(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string xmlDir = std::string(tempDir) + "/TestParallelSerialWriter/xml";
+  const std::string legacyDir = std::string(tempDir) + "/TestParallelSerialWriter/legacy";
+  delete[] tempDir;
+  if (myId == 0)
+  {
+    for (const std::string& dir : { xmlDir, legacyDir })
+    {
+      vtksys::SystemTools::RemoveADirectory(dir);
+      vtksys::SystemTools::MakeDirectory(dir);
+    }
+  }
+  controller->Barrier();
+
+  vtkNew<vtkClientServerInterpreter> interp;
+  interp->AddCommandFunction("vtkXMLPolyDataWriter", WriterCommand<vtkXMLPolyDataWriter>);
+  interp->AddCommandFunction("vtkPolyDataWriter", WriterCommand<vtkPolyDataWriter>);
+
+  vtkNew<vtkXMLPolyDataWriter> xmlWriter;
+  Write(xmlWriter.GetPointer(), interp.GetPointer(), xmlDir + "/out.vtp", controller.GetPointer());
+  vtkNew<vtkPolyDataWriter> legacyWriter;
+  Write(legacyWriter.GetPointer(), interp.GetPointer(), legacyDir + "/out.vtk",
+    controller.GetPointer());
+  controller->Barrier();
+
+  int success = 1;
+  if (myId == 0)
+  {
+    if (!CheckParts<vtkXMLPolyDataReader>(xmlDir, ".vtp", numProcs) ||
+      !CheckParts<vtkPolyDataReader>(legacyDir, ".vtk", numProcs))
+    {
+      success = 0;
+    }
+
+    const int numEntries = CountIndexEntries(xmlDir + "/out.pvd");
+    if (numEntries != NumberOfIORanks * NumberOfTimeSteps)
+    {
+      cerr << "ERROR: the XML index has " << numEntries << " datasets, expected "
+           << NumberOfIORanks * NumberOfTimeSteps << "." << endl;
+      success = 0;
+    }
+    if (vtksys::SystemTools::FileExists((legacyDir + "/out.pvd").c_str()))
+    {
+      cerr << "ERROR: a .pvd index was written for legacy files." << endl;
+      success = 0;
+    }
+  }
+  controller->Broadcast(&success, 1, 0);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
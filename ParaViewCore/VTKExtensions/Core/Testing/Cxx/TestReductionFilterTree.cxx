@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestReductionFilterTree.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that reducing along a tree of processes (TreeFanIn) gives the same
+// results on every rank as gathering, for both reduction modes and with ranks
+// that have no input.
+#include <mpi.h>
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkReductionFilter.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+// Rank r has r + 1 vertices at (r, i, 0).
+vtkSmartPointer<vtkPolyData> MakeInput(int rank)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType cc = 0; cc <= rank; ++cc)
+  {
+    points->InsertNextPoint(rank, static_cast<double>(cc), 0.0);
+    verts->InsertNextCell(1, &cc);
+  }
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points.GetPointer());
+  polyData->SetVerts(verts.GetPointer());
+  return polyData;
+}
+
+// Returns the output of a vtkReductionFilter appending the inputs.
+vtkSmartPointer<vtkPolyData> Reduce(vtkMultiProcessController* controller, bool hasInput,
+  int mode, int reductionProcessId, int treeFanIn)
+{
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(append.GetPointer());
+  reduction->SetReductionMode(mode);
+  reduction->SetReductionProcessId(reductionProcessId);
+  reduction->SetTreeFanIn(treeFanIn);
+  if (hasInput)
+  {
+    reduction->SetInputData(MakeInput(controller->GetLocalProcessId()));
+  }
+  reduction->Update();
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  output->ShallowCopy(reduction->GetOutputDataObject(0));
+  return output;
+}
+
+bool SamePoints(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfPoints(); ++cc)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(cc, pa);
+    b->GetPoint(cc, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestReductionFilterTree(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // Which ranks have an input: all of them, every other rank starting with 1,
+  // and the last one only, so that the root of the tree has no input.
+  std::vector<std::vector<bool> > inputPatterns(3, std::vector<bool>(numProcs, true));
+  for (int rank = 0; rank < numProcs; ++rank)
+  {
+    inputPatterns[1][rank] = (rank % 2 == 0);
+    inputPatterns[2][rank] = (rank == numProcs - 1);
+  }
+
+  struct ModeType
+  {
+    int Mode;
+    int ReductionProcessId;
+  };
+  const ModeType modes[] = { { vtkReductionFilter::REDUCE_ALL_TO_ONE, 0 },
+    { vtkReductionFilter::REDUCE_ALL_TO_ONE, numProcs - 1 },
+    { vtkReductionFilter::REDUCE_ALL_TO_ALL, 0 } };
+
+  int success = 1;
+  for (const std::vector<bool>& hasInput : inputPatterns)
+  {
+    vtkIdType expectedPoints = 0;
+    for (int rank = 0; rank < numProcs; ++rank)
+    {
+      expectedPoints += hasInput[rank] ? rank + 1 : 0;
+    }
+
+    for (const ModeType& mode : modes)
+    {
+      vtkSmartPointer<vtkPolyData> gathered =
+        Reduce(controller.GetPointer(), hasInput[myId], mode.Mode, mode.ReductionProcessId, 0);
+      const bool hasResult =
+        mode.Mode == vtkReductionFilter::REDUCE_ALL_TO_ALL || myId == mode.ReductionProcessId;
+      if (hasResult && gathered->GetNumberOfPoints() != expectedPoints)
+      {
+        cerr << "ERROR: rank " << myId << " gathered " << gathered->GetNumberOfPoints()
+             << " points, expected " << expectedPoints << "." << endl;
+        success = 0;
+      }
+
+      for (int treeFanIn : { 2, 3 })
+      {
+        vtkSmartPointer<vtkPolyData> reduced = Reduce(controller.GetPointer(), hasInput[myId],
+          mode.Mode, mode.ReductionProcessId, treeFanIn);
+        if (!SamePoints(gathered, reduced))
+        {
+          cerr << "ERROR: rank " << myId << " has " << reduced->GetNumberOfPoints()
+               << " points with TreeFanIn " << treeFanIn << " and reduction mode " << mode.Mode
+               << " to " << mode.ReductionProcessId << ", while gathering gives "
+               << gathered->GetNumberOfPoints() << " points." << endl;
+          success = 0;
+        }
+      }
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
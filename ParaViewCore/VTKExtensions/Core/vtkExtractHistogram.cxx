@@ -27,10 +27,14 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <vector>
@@ -66,6 +70,8 @@ vtkExtractHistogram::vtkExtractHistogram()
   this->UseCustomBinRanges = false;
   this->CustomBinRanges[0] = 0;
   this->CustomBinRanges[1] = 100;
+  this->SampleSize = 0;
+  this->OutputIsEstimate = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -85,6 +91,9 @@ void vtkExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseCustomBinRanges: " << this->UseCustomBinRanges << "\n";
   os << indent << "CustomBinRanges: " << this->CustomBinRanges[0] << ", "
      << this->CustomBinRanges[1] << endl;
+  os << indent << "CalculateAverages: " << this->CalculateAverages << "\n";
+  os << indent << "SampleSize: " << this->SampleSize << "\n";
+  os << indent << "OutputIsEstimate: " << this->OutputIsEstimate << "\n";
 }
 
 //-----------------------------------------------------------------------------
@@ -276,11 +285,202 @@ void vtkExtractHistogram::FillBinExtents(vtkDoubleArray* bin_extents, double min
   }
 }
 
-inline int vtkExtractHistogramClamp(int value, int min, int max)
+namespace
 {
-  value = value < min ? min : value;
-  value = value > max ? max : value;
-  return value;
+// Number of values binned by each vtkSMPTools::For call. Progress is reported
+// and abort is checked in between.
+const vtkIdType vtkExtractHistogramSlabSize = 1 << 20;
+
+// Returns the bin of a value. Values out of [min, max] (and NaN) go to the
+// first or last bin. This has no branches so that loops over contiguous
+// values vectorize.
+struct vtkExtractHistogramBinner
+{
+  double Min;
+  double Shift;
+  double Delta;
+  double LastBin;
+
+  int operator()(double value) const
+  {
+    const double index = (value - this->Min + this->Shift) / this->Delta;
+    return static_cast<int>(std::max(0.0, std::min(index, this->LastBin)));
+  }
+};
+
+// Values of one component of an array with the standard memory layout.
+template <typename ValueType>
+struct vtkExtractHistogramComponentValues
+{
+  const ValueType* Data;
+  int NumberOfComponents;
+  int Component;
+
+  double operator()(vtkIdType tuple) const
+  {
+    return static_cast<double>(this->Data[tuple * this->NumberOfComponents + this->Component]);
+  }
+};
+
+// Magnitudes of the tuples of an array with the standard memory layout.
+template <typename ValueType>
+struct vtkExtractHistogramMagnitudeValues
+{
+  const ValueType* Data;
+  int NumberOfComponents;
+
+  double operator()(vtkIdType tuple) const
+  {
+    const ValueType* values = this->Data + tuple * this->NumberOfComponents;
+    double value = 0;
+    for (int j = 0; j < this->NumberOfComponents; ++j)
+    {
+      const double comp = static_cast<double>(values[j]);
+      value += comp * comp;
+    }
+    return std::sqrt(value);
+  }
+};
+
+// Values of any array, through the vtkDataArray API. A Component equal to the
+// number of components selects the magnitude.
+struct vtkExtractHistogramArrayValues
+{
+  vtkDataArray* Array;
+  int Component;
+
+  double operator()(vtkIdType tuple) const
+  {
+    const int numComps = this->Array->GetNumberOfComponents();
+    if (this->Component < numComps)
+    {
+      return this->Array->GetComponent(tuple, this->Component);
+    }
+    double value = 0;
+    for (int j = 0; j < numComps; ++j)
+    {
+      const double comp = this->Array->GetComponent(tuple, j);
+      value += comp * comp;
+    }
+    return std::sqrt(value);
+  }
+};
+
+// Counts the values of one tuple per window of Stride tuples in per-thread
+// bins, which are added to Counts when a vtkSMPTools::For call completes. The
+// bins of a batch of values are computed first and counted afterwards, which
+// keeps the first loop free of dependencies.
+template <typename ValuesType>
+class vtkExtractHistogramCounter
+{
+public:
+  vtkExtractHistogramCounter(const ValuesType& values, const vtkExtractHistogramBinner& binner,
+    vtkIdType numTuples, vtkIdType stride, std::vector<vtkIdType>& counts)
+    : Values(values)
+    , Binner(binner)
+    , NumberOfTuples(numTuples)
+    , Stride(stride)
+    , Counts(counts)
+  {
+  }
+
+  void Initialize() { this->LocalCounts.Local().assign(this->Counts.size(), 0); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkIdType>& counts = this->LocalCounts.Local();
+    const int batchSize = 256;
+    int bins[batchSize];
+    for (vtkIdType first = begin; first < end; first += batchSize)
+    {
+      const int size = static_cast<int>(std::min<vtkIdType>(batchSize, end - first));
+      for (int cc = 0; cc < size; ++cc)
+      {
+        bins[cc] = this->Binner(this->Values(this->GetTuple(first + cc)));
+      }
+      for (int cc = 0; cc < size; ++cc)
+      {
+        ++counts[bins[cc]];
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    // Local counts are reset since threads that do not take part in the next
+    // vtkSMPTools::For call keep theirs.
+    typedef typename vtkSMPThreadLocal<std::vector<vtkIdType> >::iterator IteratorType;
+    for (IteratorType iter = this->LocalCounts.begin(); iter != this->LocalCounts.end(); ++iter)
+    {
+      for (size_t bin = 0; bin < this->Counts.size(); ++bin)
+      {
+        this->Counts[bin] += (*iter)[bin];
+      }
+      std::fill(iter->begin(), iter->end(), 0);
+    }
+  }
+
+private:
+  // Returns the tuple of a sample. When sampling, the tuple is picked
+  // pseudo-randomly in the window of the sample so that periodic data, such
+  // as the rows of a structured grid, is not aliased.
+  vtkIdType GetTuple(vtkIdType sample) const
+  {
+    if (this->Stride == 1)
+    {
+      return sample;
+    }
+    vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(sample);
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    const vtkIdType tuple = sample * this->Stride + static_cast<vtkIdType>(hash % this->Stride);
+    return std::min(tuple, this->NumberOfTuples - 1);
+  }
+
+  ValuesType Values;
+  vtkExtractHistogramBinner Binner;
+  vtkIdType NumberOfTuples;
+  vtkIdType Stride;
+  std::vector<vtkIdType>& Counts;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > LocalCounts;
+};
+
+// Bins the sampled values in slabs. Returns false when aborted.
+template <typename ValuesType>
+bool vtkExtractHistogramCount(vtkExtractHistogram* self, const ValuesType& values,
+  const vtkExtractHistogramBinner& binner, vtkIdType numTuples, vtkIdType stride,
+  std::vector<vtkIdType>& counts)
+{
+  const vtkIdType numSamples = (numTuples + stride - 1) / stride;
+  vtkExtractHistogramCounter<ValuesType> counter(values, binner, numTuples, stride, counts);
+  for (vtkIdType first = 0; first < numSamples; first += vtkExtractHistogramSlabSize)
+  {
+    const vtkIdType last = std::min(first + vtkExtractHistogramSlabSize, numSamples);
+    vtkSMPTools::For(first, last, counter);
+    self->UpdateProgress(0.10 + 0.90 * last / numSamples);
+    if (self->GetAbortExecute())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ValueType>
+bool vtkExtractHistogramCountContiguous(vtkExtractHistogram* self, vtkDataArray* data_array,
+  const vtkExtractHistogramBinner& binner, vtkIdType numTuples, vtkIdType stride,
+  std::vector<vtkIdType>& counts)
+{
+  const ValueType* data = static_cast<const ValueType*>(data_array->GetVoidPointer(0));
+  const int numComps = data_array->GetNumberOfComponents();
+  if (self->GetComponent() == numComps)
+  {
+    vtkExtractHistogramMagnitudeValues<ValueType> values = { data, numComps };
+    return vtkExtractHistogramCount(self, values, binner, numTuples, stride, counts);
+  }
+  vtkExtractHistogramComponentValues<ValueType> values = { data, numComps, self->GetComponent() };
+  return vtkExtractHistogramCount(self, values, binner, numTuples, stride, counts);
+}
 }
 
 //-----------------------------------------------------------------------------
@@ -295,43 +495,35 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
+  const vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
   double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
   double half_delta = bin_delta / 2.0;
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  vtkExtractHistogramBinner binner;
+  binner.Min = min;
+  binner.Shift = this->CenterBinsAroundMinAndMax ? half_delta : 0.;
+  binner.Delta = bin_delta;
+  binner.LastBin = this->BinCount - 1;
+
+  if (this->CalculateAverages)
   {
-    if (i % 1000 == 0)
-    {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
+    // Averages are accumulated serially, along with the counts.
+    vtkExtractHistogramArrayValues values = { data_array, this->Component };
+    for (vtkIdType i = 0; i != num_of_tuples; ++i)
     {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      if (i % 1000 == 0)
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
+        this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
+        if (this->GetAbortExecute())
+        {
+          return;
+        }
       }
-      value = sqrt(value);
-    }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
-    }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+      // If the value is equal to max, include it in the last bin.
+      const int index = binner(values(i));
+      bin_values->SetValue(index, bin_values->GetValue(index) + 1);
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
-
-    if (this->CalculateAverages)
-    {
       // Get all other arrays, add their value to the bin
       // For each bin, we will need 2 values per array ->
       // total, num. elements
@@ -354,6 +546,48 @@ void vtkExtractHistogram::BinAnArray(
         }
       }
     }
+    return;
+  }
+
+  // When sampling, one value is binned per window of stride values.
+  vtkIdType stride = 1;
+  if (this->SampleSize > 0 && num_of_tuples > this->SampleSize)
+  {
+    stride = (num_of_tuples + this->SampleSize - 1) / this->SampleSize;
+    this->OutputIsEstimate = true;
+  }
+
+  std::vector<vtkIdType> counts(this->BinCount, 0);
+  bool completed;
+  const bool contiguous = data_array->HasStandardMemoryLayout();
+  if (contiguous && data_array->GetDataType() == VTK_FLOAT)
+  {
+    completed = vtkExtractHistogramCountContiguous<float>(
+      this, data_array, binner, num_of_tuples, stride, counts);
+  }
+  else if (contiguous && data_array->GetDataType() == VTK_DOUBLE)
+  {
+    completed = vtkExtractHistogramCountContiguous<double>(
+      this, data_array, binner, num_of_tuples, stride, counts);
+  }
+  else
+  {
+    vtkExtractHistogramArrayValues values = { data_array, this->Component };
+    completed = vtkExtractHistogramCount(this, values, binner, num_of_tuples, stride, counts);
+  }
+  if (!completed)
+  {
+    return;
+  }
+
+  // Scale sampled counts to the number of values.
+  const vtkIdType numSamples = (num_of_tuples + stride - 1) / stride;
+  const double scale = static_cast<double>(num_of_tuples) / numSamples;
+  for (int i = 0; i < this->BinCount; ++i)
+  {
+    const vtkIdType count =
+      stride == 1 ? counts[i] : static_cast<vtkIdType>(std::floor(counts[i] * scale + 0.5));
+    bin_values->SetValue(i, bin_values->GetValue(i) + static_cast<int>(count));
   }
 }
 
@@ -365,6 +599,7 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   // encounter any problems
   vtkTable* const output_data = vtkTable::GetData(outputVector, 0);
   output_data->Initialize();
+  this->OutputIsEstimate = false;
 
   if (this->UseCustomBinRanges && this->CustomBinRanges[1] < this->CustomBinRanges[0])
   {
@@ -408,7 +643,7 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
     // for composite datasets visit each leaf dataset and add in its counts
     vtkCompositeDataIterator* cdit = cdin->NewIterator();
     cdit->InitTraversal();
-    while (!cdit->IsDoneWithTraversal())
+    while (!cdit->IsDoneWithTraversal() && !this->GetAbortExecute())
     {
       vtkDataObject* dObj = cdit->GetCurrentDataObject();
       vtkDataArray* data_array = this->GetInputArrayToProcess(0, dObj);
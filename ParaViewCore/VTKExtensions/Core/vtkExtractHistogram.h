@@ -22,6 +22,12 @@
  * will have contain a vtkDoubleArray named "bin_extents" which contains
  * the boundaries between each histogram bin, and a vtkUnsignedLongArray
  * named "bin_values" which will contain the value for each bin.
+ *
+ * Unless averages are requested, values are binned in parallel using
+ * vtkSMPTools, one set of bins per thread. Large arrays are binned in slabs
+ * so that progress is reported and the execution can be aborted in between.
+ * Setting SampleSize produces a quick estimate of the histogram of large
+ * arrays.
 */
 
 #ifndef vtkExtractHistogram_h
@@ -101,6 +107,24 @@ public:
   vtkBooleanMacro(CalculateAverages, int);
   //@}
 
+  //@{
+  /**
+   * When positive, arrays with more than SampleSize values are not binned
+   * entirely: about SampleSize evenly strided values are binned and the counts
+   * are scaled to the number of values of the array, giving an estimate of the
+   * histogram. Ignored when CalculateAverages is true. Default is 0, i.e. all
+   * values are binned.
+   */
+  vtkSetClampMacro(SampleSize, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(SampleSize, vtkIdType);
+  //@}
+
+  /**
+   * Returns true when the counts of the last output were estimated from a
+   * sample of the values (see SampleSize), false when they are exact.
+   */
+  vtkGetMacro(OutputIsEstimate, bool);
+
 protected:
   vtkExtractHistogram();
   ~vtkExtractHistogram() override;
@@ -135,6 +159,8 @@ protected:
   int Component;
   int BinCount;
   int CalculateAverages;
+  vtkIdType SampleSize;
+  bool OutputIsEstimate;
 
   vtkEHInternals* Internal;
 
@@ -27,12 +27,16 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkDataObject.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataCache.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -44,10 +48,17 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <ctype.h> // for isprint().
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -360,6 +371,134 @@ private:
 }
 
 //=============================================================================
+namespace
+{
+// Runs the tasks prefetching files on a background thread, one at a time. A
+// task returning false discards the tasks following it.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  typedef std::function<bool()> Task;
+
+  ~vtkFileSeriesReaderPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Terminate = true;
+      this->Interrupt = true;
+      this->Pending.clear();
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  // Replaces the tasks waiting to run.
+  void Schedule(std::vector<Task>& tasks)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Pending.assign(tasks.begin(), tasks.end());
+      if (this->Pending.empty())
+      {
+        return;
+      }
+      if (!this->Thread.joinable())
+      {
+        this->Thread = std::thread(&vtkFileSeriesReaderPrefetcher::Run, this);
+      }
+    }
+    this->Condition.notify_all();
+  }
+
+  // Reads files so that they are in the operating system's file cache when
+  // the reader opens them. Files read recently are skipped.
+  void Read(const std::vector<std::string>& files)
+  {
+    std::vector<Task> tasks;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      for (const auto& fname : files)
+      {
+        if (std::find(this->Done.begin(), this->Done.end(), fname) == this->Done.end())
+        {
+          tasks.push_back([this, fname]() { return this->ReadFile(fname); });
+        }
+      }
+    }
+    this->Schedule(tasks);
+  }
+
+  // Discards the tasks waiting to run and waits for the running one.
+  void Cancel()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Pending.clear();
+    this->Interrupt = true;
+    this->Condition.wait(lock, [this]() { return !this->Running; });
+    this->Interrupt = false;
+  }
+
+private:
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Terminate || !this->Pending.empty(); });
+      if (this->Terminate)
+      {
+        return;
+      }
+      const Task task = this->Pending.front();
+      this->Pending.pop_front();
+      this->Running = true;
+      lock.unlock();
+
+      const bool proceed = task();
+
+      lock.lock();
+      this->Running = false;
+      if (!proceed)
+      {
+        this->Pending.clear();
+      }
+      this->Condition.notify_all();
+    }
+  }
+
+  bool ReadFile(const std::string& fname)
+  {
+    std::vector<char> buffer(1 << 20);
+    std::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+    while (file && !this->Interrupt)
+    {
+      file.read(buffer.data(), buffer.size());
+    }
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Done.push_back(fname);
+    while (this->Done.size() > 64)
+    {
+      this->Done.pop_front();
+    }
+    return true;
+  }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<Task> Pending;
+  std::deque<std::string> Done;
+  bool Running = false;
+  bool Terminate = false;
+  // set while cancelling, so that files being read are not read to the end.
+  std::atomic<bool> Interrupt{ false };
+};
+}
+
 struct vtkFileSeriesReaderInternals
 {
   std::vector<std::string> FileNames;
@@ -367,6 +506,14 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Indices of the files read most recently, used to guess the direction of
+  // the next time requests.
+  std::deque<int> RecentIndices;
+  vtkFileSeriesReaderPrefetcher Prefetcher;
+  // Interpreter used on the prefetching thread to set the file name of the
+  // PrefetchReader.
+  vtkSmartPointer<vtkClientServerInterpreter> PrefetchInterpreter;
 };
 
 //=============================================================================
@@ -383,11 +530,16 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+  this->CacheOutputs = false;
+  this->PrefetchCount = 0;
+  this->PrefetchReader = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->SetPrefetchReader(nullptr);
+  vtkPVDataCache::GetInstance()->RemoveOwner(this);
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -492,6 +644,10 @@ int vtkFileSeriesReader::ProcessRequest(
 {
   vtkEnsureMTime check(this);
 
+  // the files are only prefetched while the pipeline is idle, since some
+  // readers use libraries that are not safe to use from several threads.
+  this->CancelPrefetch();
+
   this->UpdateMetaData();
 
   if (this->Reader)
@@ -686,7 +842,29 @@ int vtkFileSeriesReader::RequestData(
   vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
-  int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+  // The outputs are cached for the state of the reader before the file name
+  // change, see vtkMetaReader::GetMTime(), and the file being read. Outputs
+  // decoded ahead are found the same way.
+  const bool prefetchOutputs = this->PrefetchCount > 0 && this->GetPrefetchOutputs();
+  const bool useCache =
+    (this->CacheOutputs || prefetchOutputs) && this->GetNumberOfOutputPorts() == 1;
+  const std::string cacheExtra = std::to_string(this->_FileIndex);
+  int retVal;
+  if (useCache &&
+    vtkPVDataCache::GetInstance()->FindOutputs(this, this->BeforeFileNameMTime, outputVector,
+      vtkMultiProcessController::GetGlobalController(), cacheExtra))
+  {
+    retVal = 1;
+  }
+  else
+  {
+    retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
+    if (retVal && useCache && this->CacheOutputs)
+    {
+      vtkPVDataCache::GetInstance()->InsertOutputs(
+        this, this->BeforeFileNameMTime, outputVector, cacheExtra);
+    }
+  }
 
   if (this->GetNumberOfFileNames() > 0)
   {
@@ -694,9 +872,187 @@ int vtkFileSeriesReader::RequestData(
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
   }
 
+  if (retVal && this->PrefetchCount > 0)
+  {
+    this->PrefetchFiles(outInfo);
+  }
   return retVal;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::GetPrefetchOutputs()
+{
+  // readers may communicate in RequestData(), which the prefetching thread
+  // cannot do.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  return this->PrefetchReader && this->FileNameMethod && this->GetNumberOfOutputPorts() == 1 &&
+    (!controller || controller->GetNumberOfProcesses() <= 1);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchFiles(vtkInformation* outInfo)
+{
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  auto& recent = this->Internal->RecentIndices;
+  const int index = static_cast<int>(this->_FileIndex);
+  if (index < 0 || index >= numFiles)
+  {
+    return;
+  }
+  if (recent.empty() || recent.back() != index)
+  {
+    recent.push_back(index);
+  }
+  while (recent.size() > 4)
+  {
+    recent.pop_front();
+  }
+
+  // play forward unless most of the last requests went backward.
+  int steps = 0;
+  for (size_t cc = 1; cc < recent.size(); ++cc)
+  {
+    steps += (recent[cc] > recent[cc - 1]) ? 1 : -1;
+  }
+  const int direction = steps < 0 ? -1 : 1;
+
+  std::vector<int> indices;
+  for (int cc = 1; cc <= this->PrefetchCount; ++cc)
+  {
+    const int next = index + direction * cc;
+    if (next < 0 || next >= numFiles)
+    {
+      break;
+    }
+    indices.push_back(next);
+  }
+
+  if (!this->GetPrefetchOutputs())
+  {
+    // files read ahead take space in the system's file cache, so their total
+    // size is limited by the budget of the data cache.
+    const unsigned long budget = vtkPVDataCache::GetInstance()->GetMemoryBudget();
+    unsigned long total = 0;
+    std::vector<std::string> files;
+    for (int next : indices)
+    {
+      const std::string fname = this->GetFileName(static_cast<unsigned int>(next));
+      total += static_cast<unsigned long>(vtksys::SystemTools::FileLength(fname) / 1024);
+      if (total > budget)
+      {
+        break;
+      }
+      files.push_back(fname);
+    }
+    vtkDebugMacro("Reading " << files.size() << " files after index " << index << ".");
+    this->Internal->Prefetcher.Read(files);
+    return;
+  }
+
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  if (!this->Internal->PrefetchInterpreter)
+  {
+    this->Internal->PrefetchInterpreter.TakeReference(
+      vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter());
+  }
+  std::vector<vtkFileSeriesReaderPrefetcher::Task> tasks;
+  for (int next : indices)
+  {
+    // the outputs are inserted with the key RequestData() looks for when the
+    // time of the file is requested, for the same piece.
+    vtkSmartPointer<vtkInformation> info = vtkSmartPointer<vtkInformation>::New();
+    const bool hasTime = outInfo->Has(vtkSDDP::UPDATE_TIME_STEP()) != 0;
+    double time = 0.0;
+    if (hasTime)
+    {
+      vtkNew<vtkInformation> timeInfo;
+      this->Internal->TimeRanges->GetInputTimeInfo(next, timeInfo);
+      if (timeInfo->Has(vtkSDDP::TIME_STEPS()))
+      {
+        const int length = timeInfo->Length(vtkSDDP::TIME_STEPS());
+        time = timeInfo->Get(vtkSDDP::TIME_STEPS())[direction > 0 ? 0 : length - 1];
+      }
+      else if (timeInfo->Has(vtkSDDP::TIME_RANGE()))
+      {
+        time = timeInfo->Get(vtkSDDP::TIME_RANGE())[direction > 0 ? 0 : 1];
+      }
+      else
+      {
+        break;
+      }
+      info->Set(vtkSDDP::UPDATE_TIME_STEP(), time);
+    }
+    const bool hasPiece = outInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()) != 0;
+    int piece = -1, numPieces = 1, ghostLevels = 0;
+    if (hasPiece)
+    {
+      info->CopyEntry(outInfo, vtkSDDP::UPDATE_PIECE_NUMBER());
+      info->CopyEntry(outInfo, vtkSDDP::UPDATE_NUMBER_OF_PIECES());
+      info->CopyEntry(outInfo, vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+      piece = outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER());
+      numPieces = outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES());
+      ghostLevels = outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    }
+
+    vtkSmartPointer<vtkAlgorithm> reader = this->PrefetchReader;
+    vtkSmartPointer<vtkClientServerInterpreter> interpreter =
+      this->Internal->PrefetchInterpreter;
+    const std::string method = this->FileNameMethod;
+    const std::string fname = this->GetFileName(static_cast<unsigned int>(next));
+    const std::string extra = std::to_string(next);
+    const vtkMTimeType version = this->BeforeFileNameMTime;
+    tasks.push_back([=]() {
+      vtkPVDataCache* cache = vtkPVDataCache::GetInstance();
+      vtkNew<vtkInformationVector> outputs;
+      outputs->Append(info);
+      if (cache->Find(cache->GetOutputsKey(this, version, outputs, extra) + "0"))
+      {
+        return true;
+      }
+
+      vtkClientServerStream stream;
+      stream << vtkClientServerStream::Invoke << reader << method.c_str() << fname.c_str()
+             << vtkClientServerStream::End;
+      interpreter->ProcessStream(stream);
+      const int status = hasTime ? reader->UpdateTimeStep(time, piece, numPieces, ghostLevels)
+                                 : reader->UpdatePiece(piece, numPieces, ghostLevels);
+      vtkDataObject* output = reader->GetOutputDataObject(0);
+      if (!status || !output)
+      {
+        return false;
+      }
+
+      // stop before evicting outputs more likely to be requested.
+      if (cache->GetMemoryUsage() + output->GetActualMemorySize() > cache->GetMemoryBudget())
+      {
+        return false;
+      }
+      info->Set(vtkDataObject::DATA_OBJECT(), output);
+      cache->InsertOutputs(this, version, outputs, extra);
+      info->Remove(vtkDataObject::DATA_OBJECT());
+      return true;
+    });
+  }
+  vtkDebugMacro("Decoding " << tasks.size() << " files after index " << index << ".");
+  this->Internal->Prefetcher.Schedule(tasks);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetPrefetchReader(vtkAlgorithm* reader)
+{
+  if (reader != this->PrefetchReader)
+  {
+    this->CancelPrefetch();
+  }
+  vtkSetObjectBodyMacro(PrefetchReader, vtkAlgorithm, reader);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::CancelPrefetch()
+{
+  this->Internal->Prefetcher.Cancel();
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestInformationForInput(
   int index, vtkInformation* request, vtkInformationVector* outputVector)
@@ -943,6 +1299,9 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "CacheOutputs: " << this->CacheOutputs << endl;
+  os << indent << "PrefetchCount: " << this->PrefetchCount << endl;
+  os << indent << "PrefetchReader: " << this->PrefetchReader << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -151,6 +151,63 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * If true, the outputs of the internal reader are kept in the vtkPVDataCache
+   * shared by all readers, so that going back to a time step that was already
+   * read does not read the file again, as long as the cache has not evicted
+   * it. Only the readers with a single output port are supported. False by
+   * default.
+   */
+  vtkGetMacro(CacheOutputs, bool);
+  vtkSetMacro(CacheOutputs, bool);
+  vtkBooleanMacro(CacheOutputs, bool);
+  //@}
+
+  //@{
+  /**
+   * Number of files to prefetch on a background thread after each time
+   * request, e.g. when playing an animation. The files following the current
+   * one are prefetched when the last time requests went forward, the ones
+   * preceding it when they went backward.
+   *
+   * When the PrefetchReader is set and the reader runs on a single process,
+   * the files are decoded by the PrefetchReader and its outputs are inserted
+   * in the vtkPVDataCache, for the first time step of each file when playing
+   * forward and the last one when playing backward, so that the following
+   * time requests do not execute the internal reader. Files are decoded while
+   * the pipeline is idle, e.g. while the views render, only as long as their
+   * outputs fit in the budget of the cache. Readers of formats whose library
+   * is not safe to use from several threads, e.g. when another reader of the
+   * same format executes at the same time, should not use it.
+   *
+   * Otherwise the files are only read so that they are already in the
+   * system's file cache when the internal reader opens them, at most as many
+   * bytes as the budget of the vtkPVDataCache.
+   *
+   * 0 disables prefetching, which is the default.
+   */
+  vtkSetClampMacro(PrefetchCount, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PrefetchCount, int);
+  //@}
+
+  //@{
+  /**
+   * Reader used to decode the files ahead, see PrefetchCount. It must be of
+   * the same type and have the same properties as the internal reader. The
+   * files being prefetched are cancelled before it is replaced.
+   */
+  virtual void SetPrefetchReader(vtkAlgorithm*);
+  vtkGetObjectMacro(PrefetchReader, vtkAlgorithm);
+  //@}
+
+  /**
+   * Discards the files waiting to be prefetched and waits for the one being
+   * prefetched, if any. It is called before processing any pipeline request,
+   * and must be called before changing the properties of the PrefetchReader.
+   */
+  void CancelPrefetch();
+
 protected:
   vtkFileSeriesReader();
   ~vtkFileSeriesReader() override;
@@ -224,9 +281,25 @@ protected:
   void CopyRealFileNamesFromFileNames();
 
   bool IgnoreReaderTime;
+  bool CacheOutputs;
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Starts prefetching the files likely to be requested next, see
+   * PrefetchCount. `outInfo` is the information of the output just updated.
+   */
+  void PrefetchFiles(vtkInformation* outInfo);
+
+  /**
+   * True if the files are decoded ahead by the PrefetchReader, false if they
+   * are only read, see PrefetchCount.
+   */
+  bool GetPrefetchOutputs();
+
+  int PrefetchCount;
+  vtkAlgorithm* PrefetchReader;
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
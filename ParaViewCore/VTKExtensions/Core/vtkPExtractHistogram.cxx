@@ -93,6 +93,13 @@ int vtkPExtractHistogram::RequestData(
     // Nothing to do if there is no data
     return 1;
   }
+
+  // The reduced histogram is an estimate if any process sampled its values.
+  int localEstimate = this->OutputIsEstimate ? 1 : 0;
+  int globalEstimate = localEstimate;
+  this->Controller->AllReduce(&localEstimate, &globalEstimate, 1, vtkCommunicator::MAX_OP);
+  this->OutputIsEstimate = (globalEstimate != 0);
+
   // Now we need to collect and reduce data from all nodes on the root.
   vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
   reduceFilter->SetController(this->Controller);
@@ -0,0 +1,406 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataCache.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkCommunicator.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vtksys/SystemInformation.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class vtkPVDataCache::vtkInternals
+{
+public:
+  struct Entry
+  {
+    std::string Key;
+    vtkSmartPointer<vtkObject> Object;
+    unsigned long Size;
+  };
+
+  typedef std::list<Entry> EntriesType;
+
+  std::mutex Mutex;
+  unsigned long Budget = 0;
+  unsigned long Usage = 0;
+
+  // most recently used entries first.
+  EntriesType Entries;
+  std::unordered_map<std::string, EntriesType::iterator> Index;
+
+  // version of the outputs cached by each owner.
+  std::map<std::string, vtkMTimeType> OutputVersions;
+
+  void Erase(EntriesType::iterator iter)
+  {
+    this->Usage -= iter->Size;
+    this->Index.erase(iter->Key);
+    this->Entries.erase(iter);
+  }
+
+  void ErasePrefix(const std::string& prefix)
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      auto current = iter++;
+      if (current->Key.compare(0, prefix.size(), prefix) == 0)
+      {
+        this->Erase(current);
+      }
+    }
+  }
+
+  void Evict(unsigned long size)
+  {
+    while (!this->Entries.empty() && this->Usage + size > this->Budget)
+    {
+      this->Erase(std::prev(this->Entries.end()));
+    }
+  }
+};
+
+namespace
+{
+unsigned long vtkPVDataCacheGetSize(vtkObject* object)
+{
+  if (auto dobj = vtkDataObject::SafeDownCast(object))
+  {
+    return dobj->GetActualMemorySize();
+  }
+  if (auto array = vtkAbstractArray::SafeDownCast(object))
+  {
+    return array->GetActualMemorySize();
+  }
+  if (auto points = vtkPoints::SafeDownCast(object))
+  {
+    return points->GetActualMemorySize();
+  }
+  return 0;
+}
+
+// Returns the number of processes sharing the memory of this host. MPI
+// launchers export it to the processes they start. Otherwise, all the
+// processes of the global controller are assumed to run on this host.
+int vtkPVDataCacheGetNumberOfLocalProcesses()
+{
+  const char* variables[] = { "OMPI_COMM_WORLD_LOCAL_SIZE", "MPI_LOCALNRANKS",
+    "MV2_COMM_WORLD_LOCAL_SIZE" };
+  for (const char* variable : variables)
+  {
+    const char* value = vtksys::SystemTools::GetEnv(variable);
+    if (value && std::atoi(value) > 0)
+    {
+      return std::atoi(value);
+    }
+  }
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  return controller ? std::max(controller->GetNumberOfProcesses(), 1) : 1;
+}
+
+unsigned long vtkPVDataCacheDefaultBudget()
+{
+  if (const char* budget = vtksys::SystemTools::GetEnv("PV_DATA_CACHE_BUDGET"))
+  {
+    return static_cast<unsigned long>(std::strtoul(budget, nullptr, 10) * 1024);
+  }
+  vtksys::SystemInformation sysinfo;
+  sysinfo.RunMemoryCheck();
+  const size_t mebibytes =
+    sysinfo.GetTotalPhysicalMemory() / 4 / vtkPVDataCacheGetNumberOfLocalProcesses();
+  return static_cast<unsigned long>(mebibytes * 1024);
+}
+}
+
+vtkStandardNewMacro(vtkPVDataCache);
+//----------------------------------------------------------------------------
+vtkPVDataCache::vtkPVDataCache()
+  : Internals(new vtkPVDataCache::vtkInternals())
+{
+  this->Internals->Budget = vtkPVDataCacheDefaultBudget();
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataCache::~vtkPVDataCache()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataCache* vtkPVDataCache::GetInstance()
+{
+  static vtkSmartPointer<vtkPVDataCache> Instance =
+    vtkSmartPointer<vtkPVDataCache>::Take(vtkPVDataCache::New());
+  return Instance;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::SetMemoryBudget(unsigned long kibibytes)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  if (internals.Budget != kibibytes)
+  {
+    internals.Budget = kibibytes;
+    internals.Evict(0);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVDataCache::GetMemoryBudget()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.Budget;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVDataCache::GetMemoryUsage()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.Usage;
+}
+
+//----------------------------------------------------------------------------
+size_t vtkPVDataCache::GetNumberOfEntries()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return internals.Entries.size();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCache::Insert(const std::string& key, vtkObject* object)
+{
+  return this->Insert(key, object, vtkPVDataCacheGetSize(object));
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCache::Insert(const std::string& key, vtkObject* object, unsigned long kibibytes)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+
+  auto iter = internals.Index.find(key);
+  if (iter != internals.Index.end())
+  {
+    internals.Erase(iter->second);
+  }
+  if (object == nullptr || kibibytes > internals.Budget)
+  {
+    return false;
+  }
+
+  internals.Evict(kibibytes);
+  internals.Entries.push_front(vtkInternals::Entry{ key, object, kibibytes });
+  internals.Index[key] = internals.Entries.begin();
+  internals.Usage += kibibytes;
+  vtkDebugMacro("Cached `" << key << "` (" << kibibytes << " KiB), " << internals.Usage << "/"
+                           << internals.Budget << " KiB used.");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkObject> vtkPVDataCache::Find(const std::string& key)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+
+  auto iter = internals.Index.find(key);
+  if (iter == internals.Index.end())
+  {
+    return nullptr;
+  }
+  internals.Entries.splice(internals.Entries.begin(), internals.Entries, iter->second);
+  return iter->second->Object;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::Remove(const std::string& key)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  auto iter = internals.Index.find(key);
+  if (iter != internals.Index.end())
+  {
+    internals.Erase(iter->second);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::RemovePrefix(const std::string& prefix)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.ErasePrefix(prefix);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::Clear()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Entries.clear();
+  internals.Index.clear();
+  internals.OutputVersions.clear();
+  internals.Usage = 0;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVDataCache::GetOwnerKey(vtkObject* owner)
+{
+  std::ostringstream key;
+  key << owner->GetClassName() << "(" << owner << ")/";
+  return key.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::RemoveOwner(vtkObject* owner)
+{
+  const std::string prefix = vtkPVDataCache::GetOwnerKey(owner);
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.ErasePrefix(prefix);
+  internals.OutputVersions.erase(prefix);
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVDataCache::GetOutputsKey(vtkAlgorithm* algorithm, vtkMTimeType version,
+  vtkInformationVector* outputVector, const std::string& extra)
+{
+  const std::string owner = vtkPVDataCache::GetOwnerKey(algorithm);
+  {
+    // outputs cached for a previous state of the algorithm cannot be used
+    // anymore.
+    auto& internals = *this->Internals;
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    auto iter = internals.OutputVersions.find(owner);
+    if (iter != internals.OutputVersions.end() && iter->second != version)
+    {
+      internals.ErasePrefix(owner + "outputs/");
+    }
+    internals.OutputVersions[owner] = version;
+  }
+
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  std::ostringstream key;
+  key << owner << "outputs/" << version << "/" << extra << "/";
+  if (outInfo && outInfo->Has(vtkSDDP::UPDATE_TIME_STEP()))
+  {
+    key << std::setprecision(17) << outInfo->Get(vtkSDDP::UPDATE_TIME_STEP());
+  }
+  key << "/";
+  if (outInfo && outInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()))
+  {
+    key << outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER()) << ":"
+        << outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES()) << ":"
+        << outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+  key << "/";
+  return key.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataCache::FindOutputs(vtkAlgorithm* algorithm, vtkMTimeType version,
+  vtkInformationVector* outputVector, vtkMultiProcessController* controller,
+  const std::string& extra)
+{
+  const std::string key = this->GetOutputsKey(algorithm, version, outputVector, extra);
+  const int numPorts = outputVector->GetNumberOfInformationObjects();
+
+  std::vector<vtkSmartPointer<vtkDataObject> > cached(numPorts);
+  int found = (numPorts > 0 && this->GetMemoryBudget() > 0) ? 1 : 0;
+  for (int port = 0; found && port < numPorts; ++port)
+  {
+    vtkDataObject* output = vtkDataObject::GetData(outputVector, port);
+    cached[port] = vtkDataObject::SafeDownCast(this->Find(key + std::to_string(port)));
+    found = (output && cached[port] && output->IsA(cached[port]->GetClassName()));
+  }
+
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int allFound = 0;
+    controller->AllReduce(&found, &allFound, 1, vtkCommunicator::MIN_OP);
+    found = allFound;
+  }
+  if (!found)
+  {
+    return false;
+  }
+
+  for (int port = 0; port < numPorts; ++port)
+  {
+    vtkDataObject::GetData(outputVector, port)->ShallowCopy(cached[port]);
+  }
+  vtkDebugMacro("Using cached outputs for `" << key << "`.");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::InsertOutputs(vtkAlgorithm* algorithm, vtkMTimeType version,
+  vtkInformationVector* outputVector, const std::string& extra)
+{
+  if (this->GetMemoryBudget() == 0)
+  {
+    return;
+  }
+
+  const std::string key = this->GetOutputsKey(algorithm, version, outputVector, extra);
+  const int numPorts = outputVector->GetNumberOfInformationObjects();
+  for (int port = 0; port < numPorts; ++port)
+  {
+    vtkDataObject* output = vtkDataObject::GetData(outputVector, port);
+    if (output == nullptr)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkDataObject> clone;
+    clone.TakeReference(output->NewInstance());
+    clone->DeepCopy(output);
+    this->Insert(key + std::to_string(port), clone);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryBudget: " << this->GetMemoryBudget() << endl;
+  os << indent << "MemoryUsage: " << this->GetMemoryUsage() << endl;
+  os << indent << "NumberOfEntries: " << this->GetNumberOfEntries() << endl;
+}
@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataCache.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVDataCache
+ * @brief   process-wide, memory bounded cache shared by readers.
+ *
+ * vtkPVDataCache is a least-recently-used cache of VTK objects (data objects,
+ * arrays, points) identified by string keys. There is a single instance per
+ * process, obtained with GetInstance(), and all algorithms using it share the
+ * same memory budget: when inserting an object would make the cache go over
+ * the budget, the least recently used entries are evicted first. The cache
+ * may be used from several threads at once.
+ *
+ * Keys are opaque strings. Algorithms should prefix them with
+ * GetOwnerKey() so that their entries can be removed with RemoveOwner() when
+ * they are destroyed or when their entries become invalid.
+ *
+ * FindOutputs() and InsertOutputs() are convenience methods for readers
+ * caching their whole output for a given time step and piece, e.g. to avoid
+ * reading the files again when going back and forth in time.
+ *
+ * The memory budget defaults to the value, in MiB, of the
+ * PV_DATA_CACHE_BUDGET environment variable. If it is not set, a quarter of
+ * the physical memory of the host is shared evenly by the processes running
+ * on it, as reported by the MPI launcher, or by all the processes of the
+ * global controller otherwise. A budget of 0 disables the cache.
+ */
+
+#ifndef vtkPVDataCache_h
+#define vtkPVDataCache_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" //needed for exports
+#include "vtkSmartPointer.h"              // for vtkSmartPointer
+
+#include <string> // for std::string
+
+class vtkAlgorithm;
+class vtkInformationVector;
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVDataCache : public vtkObject
+{
+public:
+  static vtkPVDataCache* New();
+  vtkTypeMacro(vtkPVDataCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns the cache shared by all algorithms in this process.
+   */
+  static vtkPVDataCache* GetInstance();
+
+  //@{
+  /**
+   * Get/Set the memory budget, in kibibytes. Reducing the budget evicts
+   * entries as needed. 0 disables the cache.
+   */
+  void SetMemoryBudget(unsigned long kibibytes);
+  unsigned long GetMemoryBudget();
+  //@}
+
+  /**
+   * Returns the memory currently used by the cached objects, in kibibytes.
+   */
+  unsigned long GetMemoryUsage();
+
+  /**
+   * Returns the number of objects in the cache.
+   */
+  size_t GetNumberOfEntries();
+
+  //@{
+  /**
+   * Adds `object` to the cache, replacing any object with the same key. When
+   * `kibibytes` is not given, the size is determined using
+   * GetActualMemorySize() for data objects, arrays and points. Returns false if
+   * the object was not added, e.g. when it is larger than the budget.
+   * The object is not copied: callers must not modify it afterwards.
+   */
+  bool Insert(const std::string& key, vtkObject* object);
+  bool Insert(const std::string& key, vtkObject* object, unsigned long kibibytes);
+  //@}
+
+  /**
+   * Returns the object cached with the key, or nullptr.
+   */
+  vtkSmartPointer<vtkObject> Find(const std::string& key);
+
+  //@{
+  /**
+   * Removes entries from the cache.
+   */
+  void Remove(const std::string& key);
+  void RemovePrefix(const std::string& prefix);
+  void Clear();
+  //@}
+
+  //@{
+  /**
+   * Keys used by `owner` should start with GetOwnerKey(owner). RemoveOwner()
+   * removes all the entries of `owner`.
+   */
+  static std::string GetOwnerKey(vtkObject* owner);
+  void RemoveOwner(vtkObject* owner);
+  //@}
+
+  //@{
+  /**
+   * Convenience methods to cache the output of a reader. To be called from the
+   * RequestData() of `algorithm`. FindOutputs() returns true and shallow
+   * copies the cached data objects to all the outputs in `outputVector` if
+   * they were inserted by InsertOutputs() for the same time step, piece and
+   * `version`, in which case the reader does not need to execute. `version`
+   * identifies the state of the algorithm, typically its MTime, and entries
+   * for older versions are discarded. `extra` may be used to add information
+   * to the key.
+   *
+   * When `controller` is not nullptr, FindOutputs() only returns true when
+   * the outputs are in the cache on all the processes, so that readers that
+   * communicate in RequestData() do so on all or none of the processes. It
+   * must then be called on all the processes.
+   *
+   * InsertOutputs() stores deep copies of the outputs, since readers
+   * may reuse their arrays on the next execution.
+   */
+  bool FindOutputs(vtkAlgorithm* algorithm, vtkMTimeType version,
+    vtkInformationVector* outputVector, vtkMultiProcessController* controller = nullptr,
+    const std::string& extra = std::string());
+  void InsertOutputs(vtkAlgorithm* algorithm, vtkMTimeType version,
+    vtkInformationVector* outputVector, const std::string& extra = std::string());
+  //@}
+
+  /**
+   * Returns the prefix of the keys used by FindOutputs() and InsertOutputs(),
+   * to which the output port index is appended.
+   */
+  std::string GetOutputsKey(vtkAlgorithm* algorithm, vtkMTimeType version,
+    vtkInformationVector* outputVector, const std::string& extra);
+
+protected:
+  vtkPVDataCache();
+  ~vtkPVDataCache() override;
+
+private:
+  vtkPVDataCache(const vtkPVDataCache&) = delete;
+  void operator=(const vtkPVDataCache&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -29,6 +29,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <vtksys/SystemTools.hxx>
@@ -74,6 +75,8 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
   this->NumberOfTimeSteps = 0;
   this->CurrentTimeIndex = 0;
 
+  this->NumberOfIORanks = 1;
+
   this->Interpreter = nullptr;
   this->SetInterpreter(vtkClientServerInterpreterInitializer::GetGlobalInterpreter());
 }
@@ -174,6 +177,7 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
   vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
   this->WriteATimestep(input);
 
+  bool done = true;
   if (write_all)
   {
     this->CurrentTimeIndex++;
@@ -183,6 +187,15 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
       request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
       this->CurrentTimeIndex = 0;
     }
+    else
+    {
+      done = false;
+    }
+  }
+
+  if (done)
+  {
+    this->WriteIndex();
   }
 
   return 1;
@@ -191,6 +204,9 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
 //----------------------------------------------------------------------------
 void vtkParallelSerialWriter::WriteATimestep(vtkDataObject* input)
 {
+  // Names of the files written by each group, filled on the first process only.
+  std::vector<std::string> parts;
+
   vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(input);
   if (cds)
   {
@@ -206,7 +222,7 @@ void vtkParallelSerialWriter::WriteATimestep(vtkDataObject* input)
       std::string ext = vtksys::SystemTools::GetFilenameLastExtension(this->FileName);
       std::ostringstream fname;
       fname << path << "/" << fnamenoext << idx << ext;
-      this->WriteAFile(fname.str().c_str(), curObj);
+      this->WriteAFile(fname.str().c_str(), curObj, parts);
     }
   }
   else if (input)
@@ -214,17 +230,44 @@ void vtkParallelSerialWriter::WriteATimestep(vtkDataObject* input)
     vtkSmartPointer<vtkDataObject> inputCopy;
     inputCopy.TakeReference(input->NewInstance());
     inputCopy->ShallowCopy(input);
-    this->WriteAFile(this->FileName, inputCopy);
+    this->WriteAFile(this->FileName, inputCopy, parts);
+  }
+
+  // Only the VTK XML formats can be indexed by a collection file.
+  if (!parts.empty() && this->Writer->IsA("vtkXMLWriter"))
+  {
+    this->AddIndexEntries(input, parts);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* input)
+void vtkParallelSerialWriter::WriteAFile(
+  const char* filename, vtkDataObject* input, std::vector<std::string>& parts)
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  // Split the processes into contiguous groups, each gathered to its first
+  // process. Keying on the process id makes that process the group root.
+  int numGroups = std::min(std::max(this->NumberOfIORanks, 1), numProcs);
+  int group = 0;
+  vtkSmartPointer<vtkMultiProcessController> groupController = controller;
+  if (numGroups > 1)
+  {
+    group = static_cast<int>(static_cast<vtkTypeInt64>(myId) * numGroups / numProcs);
+    groupController.TakeReference(controller->PartitionController(group, myId));
+    if (!groupController)
+    {
+      vtkErrorMacro("Could not partition the processes. Writing a single file instead.");
+      groupController = controller;
+      numGroups = 1;
+      group = 0;
+    }
+  }
 
   vtkSmartPointer<vtkReductionFilter> reductionFilter = vtkSmartPointer<vtkReductionFilter>::New();
-  reductionFilter->SetController(controller);
+  reductionFilter->SetController(groupController);
   reductionFilter->SetPreGatherHelper(this->PreGatherHelper);
   reductionFilter->SetPostGatherHelper(this->PostGatherHelper);
   reductionFilter->SetInputDataObject(input);
@@ -235,41 +278,138 @@ void vtkParallelSerialWriter::WriteAFile(const char* filename, vtkDataObject* in
   outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), this->GhostLevel);
   reductionFilter->Update();
 
-  if (controller->GetLocalProcessId() == 0)
+  int writtenGroup = -1;
+  if (groupController->GetLocalProcessId() == 0)
   {
     vtkDataObject* output = reductionFilter->GetOutputDataObject(0);
     if (vtkIsEmpty(output) == false)
     {
-      std::ostringstream fname;
-      if (this->WriteAllTimeSteps)
+      std::string fname = this->GetPartFileName(filename, group, numGroups);
+      this->Writer->SetInputDataObject(output);
+      this->SetWriterFileName(fname.c_str());
+      this->WriteInternal();
+      this->Writer->SetInputConnection(0);
+      writtenGroup = group;
+    }
+  }
+
+  if (numGroups > 1)
+  {
+    // Let the first process know which groups wrote a file so that it can
+    // index them.
+    std::vector<int> writtenGroups(myId == 0 ? numProcs : 1, -1);
+    controller->Gather(&writtenGroup, &writtenGroups[0], 1, 0);
+    if (myId == 0)
+    {
+      for (int cc = 0; cc < numProcs; ++cc)
       {
-        std::string path = vtksys::SystemTools::GetFilenamePath(filename);
-        std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
-        std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
-        if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
+        if (writtenGroups[cc] >= 0)
         {
-          // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
-          char suffix[100];
-          snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
-          fname << path << "/" << fnamenoext << suffix << ext;
+          parts.push_back(vtksys::SystemTools::GetFilenameName(
+            this->GetPartFileName(filename, writtenGroups[cc], numGroups)));
         }
-        else
-        {
-          fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
-        }
-      }
-      else
-      {
-        fname << filename;
       }
-      this->Writer->SetInputDataObject(output);
-      this->SetWriterFileName(fname.str().c_str());
-      this->WriteInternal();
-      this->Writer->SetInputConnection(0);
     }
   }
 }
 
+//----------------------------------------------------------------------------
+std::string vtkParallelSerialWriter::GetPartFileName(
+  const char* filename, int group, int numberOfGroups)
+{
+  std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(filename);
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(filename);
+  if (numberOfGroups > 1)
+  {
+    std::ostringstream groupname;
+    groupname << fnamenoext << "_" << group;
+    fnamenoext = groupname.str();
+  }
+
+  std::ostringstream fname;
+  if (this->WriteAllTimeSteps)
+  {
+    if (this->FileNameSuffix && vtkFileSeriesWriter::SuffixValidation(this->FileNameSuffix))
+    {
+      // Print this->CurrentTimeIndex to a string using this->FileNameSuffix as format
+      char suffix[100];
+      snprintf(suffix, 100, this->FileNameSuffix, this->CurrentTimeIndex);
+      fname << path << "/" << fnamenoext << suffix << ext;
+    }
+    else
+    {
+      fname << path << "/" << fnamenoext << "." << this->CurrentTimeIndex << ext;
+    }
+  }
+  else if (numberOfGroups > 1)
+  {
+    fname << path << "/" << fnamenoext << ext;
+  }
+  else
+  {
+    fname << filename;
+  }
+  return fname.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::AddIndexEntries(
+  vtkDataObject* input, const std::vector<std::string>& parts)
+{
+  // The collection covers all the timesteps written in this pass.
+  if (!this->WriteAllTimeSteps || this->CurrentTimeIndex == 0)
+  {
+    this->IndexEntries.clear();
+  }
+
+  double time = this->CurrentTimeIndex;
+  if (input && input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+  {
+    time = input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+  }
+  for (size_t cc = 0; cc < parts.size(); ++cc)
+  {
+    std::ostringstream entry;
+    entry << "    <DataSet";
+    if (this->WriteAllTimeSteps)
+    {
+      entry << " timestep=\"" << time << "\"";
+    }
+    entry << " part=\"" << cc << "\" file=\"" << parts[cc] << "\"/>";
+    this->IndexEntries.push_back(entry.str());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteIndex()
+{
+  if (this->IndexEntries.empty())
+  {
+    return;
+  }
+
+  std::string path = vtksys::SystemTools::GetFilenamePath(this->FileName);
+  std::string fnamenoext = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->FileName);
+  std::string indexname = path + "/" + fnamenoext + ".pvd";
+  ofstream index(indexname.c_str(), ios::out);
+  if (!index)
+  {
+    vtkErrorMacro("Could not open " << indexname << " for writing.");
+    return;
+  }
+  index << "<?xml version=\"1.0\"?>\n"
+        << "<VTKFile type=\"Collection\" version=\"0.1\">\n"
+        << "  <Collection>\n";
+  for (size_t cc = 0; cc < this->IndexEntries.size(); ++cc)
+  {
+    index << this->IndexEntries[cc] << "\n";
+  }
+  index << "  </Collection>\n"
+        << "</VTKFile>\n";
+  this->IndexEntries.clear();
+}
+
 //----------------------------------------------------------------------------
 // Overload standard modified time function. If the internal reader is
 // modified, then this object is modified as well.
@@ -317,4 +457,5 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfIORanks: " << this->NumberOfIORanks << endl;
 }
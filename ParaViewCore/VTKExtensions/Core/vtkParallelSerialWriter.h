@@ -22,6 +22,14 @@
  * and PostGatherHelper.
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
+ *
+ * When NumberOfIORanks is greater than 1, the processes are split into that
+ * many contiguous groups instead. Each group is gathered to its first process,
+ * which writes its own file named `<name>_<group><ext>`. When the internal
+ * writer is a VTK XML writer, the first process also writes a `<name>.pvd`
+ * collection file that indexes the files written, once all the timesteps
+ * are written. Other formats, such as CSV or PLY, have no collection file
+ * format, hence no index is written for them.
 */
 
 #ifndef vtkParallelSerialWriter_h
@@ -30,6 +38,9 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsCoreModule.h" //needed for exports
 
+#include <string> // needed for std::string
+#include <vector> // needed for std::vector
+
 class vtkClientServerInterpreter;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkParallelSerialWriter : public vtkDataObjectAlgorithm
@@ -146,6 +157,18 @@ public:
   vtkSetStringMacro(FileNameSuffix);
   //@}
 
+  //@{
+  /**
+   * Get/Set the number of processes that write files. Data is gathered to
+   * one process per group of processes and each of these writes its own file,
+   * which spreads the memory and I/O load of large outputs. The value is
+   * limited to the number of processes. 0 or 1 (the default) gathers all the
+   * data to the first process and writes a single file.
+   */
+  vtkSetClampMacro(NumberOfIORanks, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfIORanks, int);
+  //@}
+
 protected:
   vtkParallelSerialWriter();
   ~vtkParallelSerialWriter() override;
@@ -162,7 +185,10 @@ private:
   void operator=(const vtkParallelSerialWriter&) = delete;
 
   void WriteATimestep(vtkDataObject* input);
-  void WriteAFile(const char* fname, vtkDataObject* input);
+  void WriteAFile(const char* fname, vtkDataObject* input, std::vector<std::string>& parts);
+  std::string GetPartFileName(const char* fname, int group, int numberOfGroups);
+  void AddIndexEntries(vtkDataObject* input, const std::vector<std::string>& parts);
+  void WriteIndex();
 
   void SetWriterFileName(const char* fname);
   void WriteInternal();
@@ -184,6 +210,11 @@ private:
   char* FileName;
   char* FileNameSuffix;
 
+  int NumberOfIORanks;
+  // Entries of the collection file, accumulated over the timesteps written
+  // and written at once after the last one.
+  std::vector<std::string> IndexEntries;
+
   vtkClientServerInterpreter* Interpreter;
 };
 
@@ -25,6 +25,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInstantiator.h"
@@ -44,6 +45,35 @@
 #include <sstream>
 #include <vector>
 
+namespace
+{
+// Sends a possibly NULL data object to another process.
+void vtkReductionFilterSend(vtkMultiProcessController* controller, vtkDataObject* data, int remote)
+{
+  int hasData = data ? 1 : 0;
+  controller->Send(&hasData, 1, remote, vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+  if (data)
+  {
+    controller->Send(data, remote, vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+  }
+}
+
+// Receives a data object sent with vtkReductionFilterSend().
+vtkSmartPointer<vtkDataObject> vtkReductionFilterReceive(
+  vtkMultiProcessController* controller, int remote)
+{
+  int hasData = 0;
+  controller->Receive(&hasData, 1, remote, vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+  vtkSmartPointer<vtkDataObject> data;
+  if (hasData)
+  {
+    data.TakeReference(
+      controller->ReceiveDataObject(remote, vtkReductionFilter::TRANSMIT_DATA_OBJECT));
+  }
+  return data;
+}
+}
+
 vtkStandardNewMacro(vtkReductionFilter);
 vtkCxxSetObjectMacro(vtkReductionFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkReductionFilter, PreGatherHelper, vtkAlgorithm);
@@ -60,6 +90,7 @@ vtkReductionFilter::vtkReductionFilter()
   this->GenerateProcessIds = 0;
   this->ReductionMode = vtkReductionFilter::REDUCE_ALL_TO_ONE;
   this->ReductionProcessId = 0;
+  this->TreeFanIn = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -366,6 +397,12 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
   }
 
+  if (this->TreeFanIn >= 2 && this->PassThrough < 0 && !vtkSelection::SafeDownCast(preOutput))
+  {
+    this->TreeReduce(preOutput, output);
+    return;
+  }
+
   std::vector<vtkSmartPointer<vtkDataObject> > data_sets;
   std::vector<vtkSmartPointer<vtkDataObject> > receiveData(numProcs);
 
@@ -435,6 +472,98 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     this->PostProcess(output, &data_sets[0], static_cast<unsigned int>(data_sets.size()));
   }
 }
+//----------------------------------------------------------------------------
+void vtkReductionFilter::TreeReduce(vtkDataObject* preOutput, vtkDataObject* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  const int myId = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const vtkTypeInt64 fanIn = this->TreeFanIn;
+
+  // At each stage, processes whose id is a multiple of span * fanIn reduce
+  // their partial result with the ones of the next fanIn - 1 processes that
+  // are multiples of span. Inputs stay in process order, as when gathering.
+  vtkSmartPointer<vtkDataObject> partial = preOutput;
+  bool reduced = false;
+  for (vtkTypeInt64 span = 1; span < numProcs; span *= fanIn)
+  {
+    if (myId % (span * fanIn) != 0)
+    {
+      vtkReductionFilterSend(controller, partial, static_cast<int>(myId - myId % (span * fanIn)));
+      partial = NULL;
+      break;
+    }
+
+    std::vector<vtkSmartPointer<vtkDataObject> > inputs;
+    if (partial)
+    {
+      inputs.push_back(partial);
+    }
+    for (vtkTypeInt64 child = myId + span; child < numProcs && child < myId + span * fanIn;
+         child += span)
+    {
+      vtkSmartPointer<vtkDataObject> childData =
+        vtkReductionFilterReceive(controller, static_cast<int>(child));
+      if (childData)
+      {
+        inputs.push_back(childData);
+      }
+    }
+    if (inputs.size() > 1)
+    {
+      partial.TakeReference(output->NewInstance());
+      this->PostProcess(partial, &inputs[0], static_cast<unsigned int>(inputs.size()));
+      reduced = true;
+    }
+  }
+
+  // Process 0 now has the complete result.
+  const int reductionId =
+    this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL ? 0 : this->ReductionProcessId;
+  if (reductionId != 0 && myId == 0)
+  {
+    int wasReduced = reduced ? 1 : 0;
+    controller->Send(&wasReduced, 1, reductionId, vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+    vtkReductionFilterSend(controller, partial, reductionId);
+    partial = NULL;
+  }
+  else if (reductionId != 0 && myId == reductionId)
+  {
+    int wasReduced = 0;
+    controller->Receive(&wasReduced, 1, 0, vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+    partial = vtkReductionFilterReceive(controller, 0);
+    reduced = (wasReduced != 0);
+  }
+
+  if (myId == reductionId)
+  {
+    if (partial && reduced)
+    {
+      output->ShallowCopy(partial);
+    }
+    else if (partial)
+    {
+      vtkSmartPointer<vtkDataObject> inputs[1] = { partial };
+      this->PostProcess(output, inputs, 1);
+    }
+  }
+  else if (preOutput && this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ONE)
+  {
+    vtkSmartPointer<vtkDataObject> inputs[1] = { preOutput };
+    this->PostProcess(output, inputs, 1);
+  }
+
+  if (this->ReductionMode == vtkReductionFilter::REDUCE_ALL_TO_ALL)
+  {
+    int hasData = (myId == 0 && partial) ? 1 : 0;
+    controller->Broadcast(&hasData, 1, 0);
+    if (hasData)
+    {
+      controller->Broadcast(output, 0);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkReductionFilter::GatherSelection(vtkSelection* sendData,
   std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId)
@@ -485,4 +614,5 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "TreeFanIn: " << this->TreeFanIn << endl;
 }
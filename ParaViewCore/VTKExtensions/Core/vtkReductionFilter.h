@@ -28,6 +28,10 @@
  * In addition to doing reduction the PassThrough variable lets you choose
  * to pass through the results of any one node instead of aggregating all of
  * them together.
+ *
+ * For associative PostGatherHelpers, TreeFanIn lets the reduction happen
+ * along a tree of processes instead, so that no node gathers the data of all
+ * the others at once.
 */
 
 #ifndef vtkReductionFilter_h
@@ -124,6 +128,23 @@ public:
   vtkGetMacro(GenerateProcessIds, int);
   //@}
 
+  //@{
+  /**
+   * When set to k >= 2, results are reduced along a k-ary tree of processes
+   * rather than gathered on a single node: at each stage, a node runs the
+   * PostGatherHelper on its result and the results of up to k - 1 other nodes,
+   * so that the reduction takes log_k(P) stages and no node holds the results
+   * of more than k nodes at once. This requires the PostGatherHelper to be
+   * associative, i.e. reducing partial reductions in process order must give
+   * the same result as reducing all results at once, as is the case for
+   * appending data, merging tables or adding attributes.
+   * Ignored when PassThrough is set and for selections.
+   * Default is 0, i.e. results are gathered.
+   */
+  vtkSetClampMacro(TreeFanIn, int, 0, VTK_INT_MAX);
+  vtkGetMacro(TreeFanIn, int);
+  //@}
+
   enum Tags
   {
     TRANSMIT_DATA_OBJECT = 23484
@@ -155,6 +176,12 @@ protected:
   int GatherSelection(vtkSelection* sendData,
     std::vector<vtkSmartPointer<vtkDataObject> >& receiveData, int destProcessId);
 
+  /**
+   * Reduces the preOutput of all processes along a tree rooted at process 0.
+   * See TreeFanIn.
+   */
+  void TreeReduce(vtkDataObject* preOutput, vtkDataObject* output);
+
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
   vtkMultiProcessController* Controller;
@@ -162,6 +189,7 @@ protected:
   int GenerateProcessIds;
   int ReductionMode;
   int ReductionProcessId;
+  int TreeFanIn;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&) = delete;
@@ -0,0 +1,353 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEnSightGoldBinaryReader.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPEnSightGoldBinaryReader reads the same values from a
+// transient case whether the files are memory mapped, read as streams, or
+// read as streams because mapping them failed. Also checks that the time step
+// offsets index is written as soon as a file has been scanned, and that a
+// reader opening the case again loads the offsets from it.
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPEnSightGoldBinaryReader.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <map>
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int NX = 40;
+const int NY = 30;
+const int NUMBER_OF_STEPS = 3;
+
+// Counts the files read through a mapping and as streams, and can make
+// mapping fail.
+class TestReader : public vtkPEnSightGoldBinaryReader
+{
+public:
+  static TestReader* New();
+  vtkTypeMacro(TestReader, vtkPEnSightGoldBinaryReader);
+
+  bool FailMapping = false;
+  int NumberOfMappedFiles = 0;
+  int NumberOfUnmappedFiles = 0;
+
+  const std::map<int, long>& GetOffsets(const char* fileName)
+  {
+    return this->FileOffsets[fileName];
+  }
+
+  // Opens `path` and loads the offsets of `fileName` from its index, as the
+  // reader does the first time it opens a file.
+  const std::map<int, long>& LoadOffsetIndex(const std::string& path, const char* fileName)
+  {
+    if (this->OpenFile(path.c_str()))
+    {
+      this->ReadOffsetIndex(fileName);
+    }
+    return this->FileOffsets[fileName];
+  }
+
+protected:
+  bool MapFile(const char* filename, size_t size) override
+  {
+    const bool mapped = !this->FailMapping && this->Superclass::MapFile(filename, size);
+    (mapped ? this->NumberOfMappedFiles : this->NumberOfUnmappedFiles)++;
+    return mapped;
+  }
+};
+vtkStandardNewMacro(TestReader);
+
+void WriteLine(ofstream& file, const char* line)
+{
+  char buffer[80];
+  memset(buffer, 0, sizeof(buffer));
+  strncpy(buffer, line, sizeof(buffer) - 1);
+  file.write(buffer, sizeof(buffer));
+}
+
+void WriteInt(ofstream& file, int value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void WriteFloat(ofstream& file, float value)
+{
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Writes a transient case with a single file per variable, holding all the
+// time steps. At time step s, point (i, j) is at (i, j, s) and its
+// temperature is 1000 * s + i + NX * j.
+std::string WriteCase(const std::string& directory)
+{
+  const int numPts = NX * NY;
+  vtksys::SystemTools::RemoveFile(directory + "/transient.geo.pvoffsets");
+  vtksys::SystemTools::RemoveFile(directory + "/transient.scl.pvoffsets");
+  ofstream geometry((directory + "/transient.geo").c_str(), ios::out | ios::binary);
+  ofstream temperature((directory + "/transient.scl").c_str(), ios::out | ios::binary);
+  WriteLine(geometry, "C Binary");
+  for (int step = 0; step < NUMBER_OF_STEPS; ++step)
+  {
+    WriteLine(geometry, "BEGIN TIME STEP");
+    WriteLine(geometry, "transient geometry");
+    WriteLine(geometry, "written by TestPEnSightGoldBinaryReader");
+    WriteLine(geometry, "node id off");
+    WriteLine(geometry, "element id off");
+    WriteLine(geometry, "part");
+    WriteInt(geometry, 1);
+    WriteLine(geometry, "surface");
+    WriteLine(geometry, "coordinates");
+    WriteInt(geometry, numPts);
+    for (int c = 0; c < 3; ++c)
+    {
+      for (int j = 0; j < NY; ++j)
+      {
+        for (int i = 0; i < NX; ++i)
+        {
+          WriteFloat(geometry, static_cast<float>(c == 0 ? i : (c == 1 ? j : step)));
+        }
+      }
+    }
+    WriteLine(geometry, "quad4");
+    WriteInt(geometry, (NX - 1) * (NY - 1));
+    for (int j = 0; j + 1 < NY; ++j)
+    {
+      for (int i = 0; i + 1 < NX; ++i)
+      {
+        // ids start at 1.
+        const int id = i + NX * j + 1;
+        WriteInt(geometry, id);
+        WriteInt(geometry, id + 1);
+        WriteInt(geometry, id + NX + 1);
+        WriteInt(geometry, id + NX);
+      }
+    }
+    WriteLine(geometry, "END TIME STEP");
+
+    WriteLine(temperature, "BEGIN TIME STEP");
+    WriteLine(temperature, "temperature");
+    WriteLine(temperature, "part");
+    WriteInt(temperature, 1);
+    WriteLine(temperature, "coordinates");
+    for (int id = 0; id < numPts; ++id)
+    {
+      WriteFloat(temperature, static_cast<float>(1000 * step + id));
+    }
+    WriteLine(temperature, "END TIME STEP");
+  }
+
+  const std::string caseFileName = directory + "/transient.case";
+  ofstream caseFile(caseFileName.c_str());
+  caseFile << "FORMAT\n"
+           << "type: ensight gold\n\n"
+           << "GEOMETRY\n"
+           << "model: 1 1 transient.geo\n\n"
+           << "VARIABLE\n"
+           << "scalar per node: 1 1 temperature transient.scl\n\n"
+           << "TIME\n"
+           << "time set: 1\n"
+           << "number of steps: " << NUMBER_OF_STEPS << "\n"
+           << "time values: 0 1 2\n\n"
+           << "FILE\n"
+           << "file set: 1\n"
+           << "number of steps: " << NUMBER_OF_STEPS << "\n";
+  return caseFileName;
+}
+
+// Reads the time steps backwards, so that the reader has to scan for the
+// offsets of the time steps first, then seek back to them.
+int ReadSteps(TestReader* reader, const std::string& caseFileName,
+  vtkSmartPointer<vtkDataSet> outputs[NUMBER_OF_STEPS])
+{
+  reader->SetCaseFileName(caseFileName.c_str());
+  for (int step = NUMBER_OF_STEPS - 1; step >= 0; --step)
+  {
+    reader->UpdateTimeStep(step);
+    vtkMultiBlockDataSet* output =
+      vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+    vtkDataSet* block = output ? vtkDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+    expect(block != nullptr, "no output for time step " << step << ".");
+    outputs[step].TakeReference(block->NewInstance());
+    outputs[step]->DeepCopy(block);
+
+    vtkDataArray* temperature = block->GetPointData()->GetArray("temperature");
+    expect(block->GetNumberOfPoints() == NX * NY && temperature != nullptr,
+      "wrong output for time step " << step << ".");
+    for (vtkIdType cc = 0; cc < block->GetNumberOfPoints(); ++cc)
+    {
+      double point[3];
+      block->GetPoint(cc, point);
+      const double expected = 1000 * step + point[0] + NX * point[1];
+      expect(point[2] == step && temperature->GetTuple1(cc) == expected,
+        "wrong values at time step " << step << " for point " << cc << ".");
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a == nullptr || b == nullptr || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < a->GetNumberOfTuples(); ++cc)
+  {
+    for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+    {
+      if (a->GetComponent(cc, comp) != b->GetComponent(cc, comp))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPEnSightGoldBinaryReader(int argc, char* argv[])
+{
+  // The reader distributes the cells among the processes of the global
+  // controller.
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string directory = tempDir;
+  delete[] tempDir;
+  const std::string caseFileName = WriteCase(directory);
+
+  vtkSmartPointer<vtkDataSet> mapped[NUMBER_OF_STEPS];
+  vtkNew<TestReader> mappedReader;
+  mappedReader->UseMemoryMappingOn();
+  if (ReadSteps(mappedReader, caseFileName, mapped) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkDataSet> streamed[NUMBER_OF_STEPS];
+  vtkNew<TestReader> streamedReader;
+  streamedReader->UseMemoryMappingOff();
+  if (ReadSteps(streamedReader, caseFileName, streamed) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkDataSet> fallback[NUMBER_OF_STEPS];
+  vtkNew<TestReader> fallbackReader;
+  fallbackReader->UseMemoryMappingOn();
+  fallbackReader->FailMapping = true;
+  if (ReadSteps(fallbackReader, caseFileName, fallback) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+#ifndef _WIN32
+  expect(mappedReader->NumberOfMappedFiles > 0 && mappedReader->NumberOfUnmappedFiles == 0,
+    "the files were not mapped.");
+#endif
+  expect(streamedReader->NumberOfMappedFiles == 0 && streamedReader->NumberOfUnmappedFiles == 0,
+    "the files were mapped with UseMemoryMapping off.");
+  expect(fallbackReader->NumberOfMappedFiles == 0 && fallbackReader->NumberOfUnmappedFiles > 0,
+    "mapping the files was not attempted.");
+
+  for (int step = 0; step < NUMBER_OF_STEPS; ++step)
+  {
+    vtkDataArray* temperatures[3] = { mapped[step]->GetPointData()->GetArray("temperature"),
+      streamed[step]->GetPointData()->GetArray("temperature"),
+      fallback[step]->GetPointData()->GetArray("temperature") };
+    expect(SameArrays(temperatures[0], temperatures[1]) &&
+        SameArrays(temperatures[0], temperatures[2]),
+      "the temperatures of time step " << step << " differ between the read modes.");
+    for (vtkIdType cc = 0; cc < mapped[step]->GetNumberOfPoints(); ++cc)
+    {
+      double p[3][3];
+      mapped[step]->GetPoint(cc, p[0]);
+      streamed[step]->GetPoint(cc, p[1]);
+      fallback[step]->GetPoint(cc, p[2]);
+      expect(memcmp(p[0], p[1], sizeof(p[0])) == 0 && memcmp(p[0], p[2], sizeof(p[0])) == 0,
+        "the points of time step " << step << " differ between the read modes.");
+    }
+    expect(mapped[step]->GetNumberOfCells() == streamed[step]->GetNumberOfCells() &&
+        mapped[step]->GetNumberOfCells() == fallback[step]->GetNumberOfCells(),
+      "the cells of time step " << step << " differ between the read modes.");
+  }
+
+  // The offsets index of a file is written right after the file is scanned,
+  // while the reader is still alive.
+  const std::string geometryIndex = directory + "/transient.geo.pvoffsets";
+  vtkSmartPointer<vtkDataSet> indexed[NUMBER_OF_STEPS];
+  vtkNew<TestReader> indexingReader;
+  indexingReader->UseOffsetIndexOn();
+  if (ReadSteps(indexingReader, caseFileName, indexed) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  expect(vtksys::SystemTools::FileExists(geometryIndex) &&
+      vtksys::SystemTools::FileExists(directory + "/transient.scl.pvoffsets"),
+    "the offsets index was not written after scanning the files.");
+  const std::map<int, long> scanned = indexingReader->GetOffsets("transient.geo");
+  expect(scanned.size() == static_cast<size_t>(NUMBER_OF_STEPS - 1),
+    "expected " << NUMBER_OF_STEPS - 1 << " scanned offsets, got " << scanned.size() << ".");
+
+  // Opening the case again loads the offsets from the index.
+  vtkNew<TestReader> reopenedReader;
+  reopenedReader->SetCaseFileName(caseFileName.c_str());
+  reopenedReader->UseOffsetIndexOn();
+  expect(reopenedReader->LoadOffsetIndex(directory + "/transient.geo", "transient.geo") == scanned,
+    "the offsets were not loaded from the index.");
+  vtkSmartPointer<vtkDataSet> reopened[NUMBER_OF_STEPS];
+  if (ReadSteps(reopenedReader, caseFileName, reopened) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  for (int step = 0; step < NUMBER_OF_STEPS; ++step)
+  {
+    expect(SameArrays(mapped[step]->GetPointData()->GetArray("temperature"),
+             reopened[step]->GetPointData()->GetArray("temperature")),
+      "the temperatures of time step " << step << " differ when read through the index.");
+  }
+
+  // An index that does not match the size of its file is ignored.
+  {
+    ofstream index(geometryIndex.c_str());
+    index << "EnSightOffsetIndex 1\n1 0\n1 80\n2 160\n";
+  }
+  vtkNew<TestReader> staleReader;
+  staleReader->UseOffsetIndexOn();
+  expect(staleReader->LoadOffsetIndex(directory + "/transient.geo", "transient.geo").empty(),
+    "the offsets of a stale index were loaded.");
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
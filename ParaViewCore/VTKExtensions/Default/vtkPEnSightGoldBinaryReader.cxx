@@ -17,8 +17,113 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <ctype.h>
+#include <cstring>
+#include <sstream>
+#include <streambuf>
 #include <string>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------
+// Stream buffer reading from a memory mapping of the whole file. Installed
+// on IFile, it turns each read into a copy out of the page cache, without a
+// system call nor the intermediate copy made by the file buffer, and seeking
+// only moves a pointer.
+class vtkPEnSightGoldBinaryReader::vtkMappedFile : public std::streambuf
+{
+public:
+  vtkMappedFile()
+    : Data(nullptr)
+    , Size(0)
+  {
+  }
+
+  ~vtkMappedFile() override
+  {
+#ifndef _WIN32
+    if (this->Data)
+    {
+      munmap(this->Data, this->Size);
+    }
+#endif
+  }
+
+  // Returns false if the file cannot be mapped, in which case the file stream
+  // must be used as is.
+  bool Open(const char* filename, size_t size)
+  {
+#ifndef _WIN32
+    if (size == 0)
+    {
+      return false;
+    }
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+    {
+      return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+    this->Data = static_cast<char*>(data);
+    this->Size = size;
+    this->setg(this->Data, this->Data, this->Data + this->Size);
+    return true;
+#else
+    (void)filename;
+    (void)size;
+    return false;
+#endif
+  }
+
+  // Returns a pointer to `length` bytes at `position`, nullptr if they are
+  // past the end of the file.
+  const char* GetData(long position, size_t length) const
+  {
+    if (position < 0 || static_cast<size_t>(position) + length > this->Size)
+    {
+      return nullptr;
+    }
+    return this->Data + position;
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    off_type position = off;
+    if (dir == std::ios_base::cur)
+    {
+      position += this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      position += static_cast<off_type>(this->Size);
+    }
+    if (position < 0 || position > static_cast<off_type>(this->Size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->Data, this->Data + position, this->Data + this->Size);
+    return pos_type(position);
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+private:
+  char* Data;
+  size_t Size;
+};
+
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
@@ -28,6 +133,11 @@ vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
   this->IFile = NULL;
+  this->MappedFile = nullptr;
+  this->UseMemoryMapping =
+    vtksys::SystemTools::GetEnv("PV_DISABLE_ENSIGHT_MEMORY_MAPPING") == nullptr;
+  this->UseOffsetIndex = false;
+  this->OpenedFileModifiedTime = 0;
   this->FileSize = 0;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
@@ -47,12 +157,17 @@ vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::~vtkPEnSightGoldBinaryReader()
 {
+  for (const auto& item : this->OffsetIndexFiles)
+  {
+    this->WriteOffsetIndex(item.first.c_str(), false);
+  }
   if (this->IFile)
   {
     this->IFile->close();
     delete this->IFile;
     this->IFile = NULL;
   }
+  delete this->MappedFile;
   delete[] this->FloatBuffer[2];
   delete[] this->FloatBuffer[1];
   delete[] this->FloatBuffer[0];
@@ -75,6 +190,8 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     delete this->IFile;
     this->IFile = NULL;
   }
+  delete this->MappedFile;
+  this->MappedFile = nullptr;
 
   // Open the new file
   vtkDebugMacro(<< "Opening file " << filename);
@@ -83,6 +200,8 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   {
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
+    this->OpenedFileName = filename;
+    this->OpenedFileModifiedTime = static_cast<long long>(fs.st_mtime);
 
 #ifdef _WIN32
     this->IFile = new ifstream(filename, ios::in | ios::binary);
@@ -101,6 +220,11 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     return 0;
   }
 
+  if (this->UseMemoryMapping && !this->MapFile(filename, static_cast<size_t>(fs.st_size)))
+  {
+    vtkDebugMacro(<< "Could not map " << filename << ", reading it as a stream.");
+  }
+
   // we now need to check for Fortran and byte ordering
 
   // we need to look at the first 4 bytes of the file, and the 84-87 bytes
@@ -165,6 +289,20 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
   return 1;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPEnSightGoldBinaryReader::MapFile(const char* filename, size_t size)
+{
+  this->MappedFile = new vtkMappedFile();
+  if (!this->MappedFile->Open(filename, size))
+  {
+    delete this->MappedFile;
+    this->MappedFile = nullptr;
+    return false;
+  }
+  static_cast<std::ios*>(this->IFile)->rdbuf(this->MappedFile);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 {
@@ -250,6 +388,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
   {
     int realTimeStep = timeStep - 1;
     int j = 0;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
     {
@@ -280,6 +419,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
         this->FileOffsets[fileName][j] = this->IFile->tellg();
       }
     }
+    this->WriteOffsetIndex(fileName, true);
 
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
@@ -1140,6 +1280,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   {
     int realTimeStep = timeStep - 1;
     int k, j = 0;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (k = realTimeStep; k >= 0; k--)
     {
@@ -1185,6 +1326,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
       this->ReadLine(line);
@@ -1330,6 +1472,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1388,6 +1531,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
 
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
@@ -1552,6 +1696,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1610,6 +1755,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
 
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
@@ -1764,6 +1910,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   {
     int realTimeStep = timeStep - 1;
     int j = 0;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
     {
@@ -1808,6 +1955,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
@@ -1927,6 +2075,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2008,6 +2157,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     } // end for
+    this->WriteOffsetIndex(fileName, true);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
@@ -2183,6 +2333,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2261,6 +2412,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
@@ -2432,6 +2584,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->ReadOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2510,6 +2663,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
       }
       this->FileOffsets[fileName][j] = this->IFile->tellg();
     }
+    this->WriteOffsetIndex(fileName, true);
     this->ReadLine(line);
     while (strncmp(line, "BEGIN TIME STEP", 15) != 0)
     {
@@ -4474,6 +4628,38 @@ void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(int i, float* vector)
 {
   // We assume FloatBufferIndexBegin, FloatBufferFilePosition, and FloatBufferNumberOfVectors
   // were previously set.
+  if (this->MappedFile)
+  {
+    // read the components straight from the mapping, no need to buffer them.
+    for (int c = 0; c < 3; c++)
+    {
+      long position = this->FloatBufferFilePosition +
+        c * this->FloatBufferNumberOfVectors * static_cast<long>(sizeof(float)) +
+        i * static_cast<long>(sizeof(float));
+      if (this->Fortran)
+      {
+        position += 4 + c * 8;
+      }
+      const char* data = this->MappedFile->GetData(position, sizeof(float));
+      if (!data)
+      {
+        vtkErrorMacro("Read failed");
+        vector[c] = 0.0f;
+        continue;
+      }
+      memcpy(&vector[c], data, sizeof(float));
+    }
+    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+    {
+      vtkByteSwap::Swap4LERange(vector, 3);
+    }
+    else
+    {
+      vtkByteSwap::Swap4BERange(vector, 3);
+    }
+    return;
+  }
+
   int closestBufferBegin = (i / this->FloatBufferSize) * this->FloatBufferSize;
   if ((this->FloatBufferIndexBegin == -1) || (closestBufferBegin != this->FloatBufferIndexBegin))
   {
@@ -4490,6 +4676,12 @@ void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(int i, float* vector)
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 {
+  if (this->MappedFile)
+  {
+    // GetVectorFromFloatBuffer() reads from the mapping directly.
+    return;
+  }
+
   long currentPosition = this->IFile->tellg();
 
   int sizeToRead;
@@ -4532,8 +4724,108 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
   this->IFile->seekg(currentPosition);
 }
 
+//----------------------------------------------------------------------------
+// The index file of a data file lists the offsets of its time steps:
+//   EnSightOffsetIndex 1
+//   <size of the data file> <modification time of the data file>
+//   <time step> <offset>
+//   ...
+// It is only used if the size and the modification time still match.
+void vtkPEnSightGoldBinaryReader::ReadOffsetIndex(const char* fileName)
+{
+  if (!this->UseOffsetIndex || this->OpenedFileName.empty() ||
+    this->OffsetIndexFiles.find(fileName) != this->OffsetIndexFiles.end())
+  {
+    return;
+  }
+
+  std::map<int, long>& offsets = this->FileOffsets[fileName];
+  OffsetIndexFile& indexFile = this->OffsetIndexFiles[fileName];
+  indexFile.Name = this->OpenedFileName + ".pvoffsets";
+  indexFile.FileSize = this->FileSize;
+  indexFile.ModifiedTime = this->OpenedFileModifiedTime;
+  indexFile.Written = false;
+
+  ifstream index(indexFile.Name.c_str());
+  std::string header;
+  long size;
+  long long mtime;
+  if (index && std::getline(index, header) && header == "EnSightOffsetIndex 1" &&
+    (index >> size >> mtime) && size == this->FileSize && mtime == this->OpenedFileModifiedTime)
+  {
+    int timeStep;
+    long offset;
+    while (index >> timeStep >> offset)
+    {
+      if (offset > 0 && offset <= this->FileSize)
+      {
+        offsets.insert(std::make_pair(timeStep, offset));
+      }
+    }
+    vtkDebugMacro("Read " << offsets.size() << " time step offsets from " << indexFile.Name);
+  }
+  indexFile.NumberOfOffsets = offsets.size();
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::WriteOffsetIndex(const char* fileName, bool afterScan)
+{
+  auto iter = this->OffsetIndexFiles.find(fileName);
+  if (iter == this->OffsetIndexFiles.end())
+  {
+    return;
+  }
+  OffsetIndexFile& indexFile = iter->second;
+  const std::map<int, long>& offsets = this->FileOffsets[fileName];
+  if (offsets.size() <= indexFile.NumberOfOffsets || (afterScan && indexFile.Written))
+  {
+    return;
+  }
+  indexFile.NumberOfOffsets = offsets.size();
+  indexFile.Written = true;
+
+  // All processes scan the files the same way; one of them is enough to write
+  // the index.
+  if (this->GetMultiProcessLocalProcessId() > 0)
+  {
+    return;
+  }
+
+  // Write to a temporary file first so that other readers never see a
+  // partial index. The index is an optimization: failing to write it, e.g.
+  // in a read-only directory, is not an error.
+  std::ostringstream tmpFileName;
+  tmpFileName << indexFile.Name << "." << this << ".tmp";
+  {
+    ofstream index(tmpFileName.str().c_str());
+    if (!index)
+    {
+      vtkDebugMacro("Could not write " << indexFile.Name);
+      return;
+    }
+    index << "EnSightOffsetIndex 1\n"
+          << indexFile.FileSize << " " << indexFile.ModifiedTime << "\n";
+    for (const auto& offset : offsets)
+    {
+      index << offset.first << " " << offset.second << "\n";
+    }
+    if (!index)
+    {
+      index.close();
+      vtksys::SystemTools::RemoveFile(tmpFileName.str());
+      return;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpFileName.str().c_str(), indexFile.Name.c_str()))
+  {
+    vtksys::SystemTools::RemoveFile(tmpFileName.str());
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
+  os << indent << "UseOffsetIndex: " << this->UseOffsetIndex << endl;
 }
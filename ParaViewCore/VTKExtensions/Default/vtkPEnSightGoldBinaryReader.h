@@ -27,6 +27,20 @@
  *
  *  Copyright (c) CEA
  * \endverbatim
+ *
+ * On POSIX platforms the files are read through a memory mapping rather than
+ * through the file stream when UseMemoryMapping is on (the default). Set the
+ * environment variable PV_DISABLE_ENSIGHT_MEMORY_MAPPING to change the
+ * default.
+ *
+ * When UseOffsetIndex is on (off by default), the offsets of the time steps
+ * found while scanning a transient file are saved in an index file next to
+ * it, named after the file with a ".pvoffsets" extension. An index file is
+ * written right after the first scan of its file, so that it is available to
+ * other readers right away, and updated with the offsets found afterwards
+ * when the reader is destroyed. Opening the file again later reads the
+ * offsets from the index instead of scanning the file, as long as the size
+ * and the modification time of the file did not change.
 */
 
 #ifndef vtkPEnSightGoldBinaryReader_h
@@ -46,6 +60,29 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When set, files are mapped in memory and read from the mapping instead
+   * of through a file stream, which avoids a system call and a copy for each
+   * read. Falls back to the file stream if the file cannot be mapped. Takes
+   * effect the next time a file is opened.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  //@}
+
+  //@{
+  /**
+   * When set, the time step offsets of transient files are saved to and
+   * restored from an index file stored next to each file. Off by default,
+   * since it writes files to the data directory.
+   */
+  vtkSetMacro(UseOffsetIndex, bool);
+  vtkGetMacro(UseOffsetIndex, bool);
+  vtkBooleanMacro(UseOffsetIndex, bool);
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -53,6 +90,13 @@ protected:
   // Returns 1 if successful.  Sets file size as a side action.
   int OpenFile(const char* filename);
 
+  /**
+   * Maps the file opened by OpenFile() and makes IFile read from the mapping.
+   * Returns false if the file cannot be mapped, in which case IFile reads the
+   * file as a stream.
+   */
+  virtual bool MapFile(const char* filename, size_t size);
+
   // Returns 1 if successful.  Handles constructing the filename, opening the file and checking
   // if it's binary
   int InitializeFile(const char* filename);
@@ -189,6 +233,21 @@ protected:
    */
   int CountTimeSteps();
 
+  /**
+   * Restore the time step offsets of `fileName` from the index file of the
+   * opened file. This only happens the first time a file is opened.
+   */
+  void ReadOffsetIndex(const char* fileName);
+
+  /**
+   * Save the time step offsets of `fileName` to its index file if new offsets
+   * were found since the index was read or last written. Right after a scan
+   * (`afterScan`), this only writes the index the first time, so that
+   * stepping through a series does not rewrite it at every step: the offsets
+   * found by later scans are saved when the reader is destroyed.
+   */
+  void WriteOffsetIndex(const char* fileName, bool afterScan);
+
   //@{
   /**
    * Read to the next time step in the geometry file.
@@ -205,6 +264,24 @@ protected:
   int Fortran;
 
   ifstream* IFile;
+  // When set, IFile reads from this mapping of the file.
+  class vtkMappedFile;
+  vtkMappedFile* MappedFile;
+  bool UseMemoryMapping;
+  bool UseOffsetIndex;
+  // Full name and modification time of the file opened by OpenFile().
+  std::string OpenedFileName;
+  long long OpenedFileModifiedTime;
+  // Index file of each file name, as it was when it was last read or written.
+  struct OffsetIndexFile
+  {
+    std::string Name;
+    long FileSize;
+    long long ModifiedTime;
+    size_t NumberOfOffsets;
+    bool Written;
+  };
+  std::map<std::string, OffsetIndexFile> OffsetIndexFiles;
   // The size of the file could be used to choose byte order.
   long FileSize;
 
@@ -30,6 +30,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPEnSightGoldBinaryReader.h"
 #include "vtkPEnSightGoldReader.h"
+#include "vtkPVDataCache.h"
 
 #include <assert.h>
 #include <ctype.h> /* isspace */
@@ -44,11 +45,41 @@ vtkPGenericEnSightReader::vtkPGenericEnSightReader()
   // -2 is the default starting value
   this->MultiProcessLocalProcessId = -2;
   this->MultiProcessNumberOfProcesses = -2;
+  this->CacheOutputs = false;
+  this->UseOffsetIndex = false;
 }
 
 //----------------------------------------------------------------------------
 vtkPGenericEnSightReader::~vtkPGenericEnSightReader()
 {
+  vtkPVDataCache::GetInstance()->RemoveOwner(this);
+}
+
+//----------------------------------------------------------------------------
+int vtkPGenericEnSightReader::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->CacheOutputs)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  // The parallel readers communicate while reading, hence all the processes
+  // must agree on using the cached outputs.
+  vtkPVDataCache* cache = vtkPVDataCache::GetInstance();
+  const vtkMTimeType cacheVersion = this->GetMTime();
+  if (cache->FindOutputs(
+        this, cacheVersion, outputVector, vtkMultiProcessController::GetGlobalController()))
+  {
+    return 1;
+  }
+
+  int retVal = this->Superclass::RequestData(request, inputVector, outputVector);
+  if (retVal)
+  {
+    cache->InsertOutputs(this, cacheVersion, outputVector);
+  }
+  return retVal;
 }
 
 //----------------------------------------------------------------------------
@@ -100,6 +131,8 @@ int vtkPGenericEnSightReader::RequestInformation(
     {
       this->Reader = vtkPEnSightGoldBinaryReader::New();
     }
+    static_cast<vtkPEnSightGoldBinaryReader*>(this->Reader)->SetUseOffsetIndex(
+      this->UseOffsetIndex);
   }
   else
   {
@@ -203,4 +236,6 @@ void vtkPGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "MultiProcessLocalProcessId: " << this->MultiProcessLocalProcessId << endl;
   os << indent << "MultiProcessNumberOfProcesses: " << this->MultiProcessNumberOfProcesses << endl;
+  os << indent << "CacheOutputs: " << this->CacheOutputs << endl;
+  os << indent << "UseOffsetIndex: " << this->UseOffsetIndex << endl;
 }
@@ -38,11 +38,37 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * If true, the outputs are kept in the vtkPVDataCache shared by all readers
+   * so that going back to a time step that was already read does not read the
+   * files again, as long as the cache has not evicted it.
+   * False by default.
+   */
+  vtkSetMacro(CacheOutputs, bool);
+  vtkGetMacro(CacheOutputs, bool);
+  vtkBooleanMacro(CacheOutputs, bool);
+  //@}
+
+  //@{
+  /**
+   * If true, the offsets of the time steps of transient EnSight Gold binary
+   * files are saved in an index file next to each file, so that they do not
+   * need to be found again the next time the files are read.
+   * False by default.
+   * @sa vtkPEnSightGoldBinaryReader::SetUseOffsetIndex
+   */
+  vtkSetMacro(UseOffsetIndex, bool);
+  vtkGetMacro(UseOffsetIndex, bool);
+  vtkBooleanMacro(UseOffsetIndex, bool);
+  //@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
 
   int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   /**
    * Multi Process cache. Will be read a lot of times.
@@ -56,6 +82,9 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool CacheOutputs;
+  bool UseOffsetIndex;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
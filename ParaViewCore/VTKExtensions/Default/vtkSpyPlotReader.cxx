@@ -35,6 +35,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkMultiProcessStream.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataCache.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
@@ -110,6 +111,7 @@ vtkSpyPlotReader::vtkSpyPlotReader()
   this->GenerateTracerArray = 1;      // by default do not generate tracer array
   this->GenerateMarkers = 1;          // by default do generate markers
   this->IsAMR = 1;
+  this->CacheOutputs = 0;
   this->FileNameChanged = true;
   this->TimeSteps = new vtkSpyPlotReader::VectorOfDoubles();
   this->TimeRequestedFromPipeline = false;
@@ -118,6 +120,7 @@ vtkSpyPlotReader::vtkSpyPlotReader()
 //-----------------------------------------------------------------------------
 vtkSpyPlotReader::~vtkSpyPlotReader()
 {
+  vtkPVDataCache::GetInstance()->RemoveOwner(this);
   this->SetFileName(0);
   this->CellDataArraySelection->Delete();
   this->Map->Clean(0);
@@ -643,6 +646,17 @@ int vtkSpyPlotReader::RequestData(vtkInformation* request,
     return 0;
   }
 
+  // Time steps that were already read may be in the cache. All the processes
+  // must agree since reading the files requires communication.
+  const vtkMTimeType cacheVersion = this->GetMTime();
+  if (this->CacheOutputs &&
+    vtkPVDataCache::GetInstance()->FindOutputs(
+      this, cacheVersion, outputVector, this->GlobalController))
+  {
+    this->UpdateTimeStep(request, outputVector, cds);
+    return 1;
+  }
+
   vtkPolyData* tracersData = NULL;
 
   if (this->GenerateTracerArray == 1)
@@ -917,6 +931,10 @@ int vtkSpyPlotReader::RequestData(vtkInformation* request,
     this->AddBlockIdArray(cds);
   }
 
+  if (this->CacheOutputs)
+  {
+    vtkPVDataCache::GetInstance()->InsertOutputs(this, cacheVersion, outputVector);
+  }
   return 1;
 }
 
@@ -1460,6 +1478,16 @@ void vtkSpyPlotReader::PrintSelf(ostream& os, vtkIndent indent)
     os << "false" << endl;
   }
 
+  os << "CacheOutputs: ";
+  if (this->CacheOutputs)
+  {
+    os << "true" << endl;
+  }
+  else
+  {
+    os << "false" << endl;
+  }
+
   os << "TimeStep: " << this->TimeStep << endl;
   os << "TimeStepRange: " << this->TimeStepRange[0] << " " << this->TimeStepRange[1] << endl;
   if (this->CellDataArraySelection)
@@ -199,6 +199,18 @@ public:
   vtkBooleanMacro(MergeXYZComponents, int);
   //@}
 
+  //@{
+  /**
+   * If true, the outputs are kept in the vtkPVDataCache shared by all readers
+   * so that going back to a time step that was already read does not read the
+   * files again, as long as the cache has not evicted it.
+   * False by default.
+   */
+  vtkSetMacro(CacheOutputs, int);
+  vtkGetMacro(CacheOutputs, int);
+  vtkBooleanMacro(CacheOutputs, int);
+  //@}
+
   //@{
   /**
    * Get the time step range.
@@ -391,6 +403,8 @@ protected:
 
   int MergeXYZComponents;
 
+  int CacheOutputs;
+
   // This flag is used to determine if core meta-data needs to be re-read.
   bool FileNameChanged;
 
@@ -5,9 +5,12 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
+#include <atomic>
 #include <sstream>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
@@ -78,6 +81,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
   this->NumberOfCellFields = 0;
   this->HaveInformation = 0;
   this->DownConvertVolumeFraction = 1;
+  this->DecodeInParallel = 1;
   this->DataTypeChanged = 0;
   this->GeomTimeStep = -1; // Indicate that geometry will have to be loaded
   this->NeedToCheck = 1;   // Indicates non-geometric data needs to be checked
@@ -192,6 +196,86 @@ void vtkSpyPlotUniReader::SetDownConvertVolumeFraction(int vf)
   this->DataTypeChanged = 1;
 }
 
+//-----------------------------------------------------------------------------
+template <class t>
+int vtkSpyPlotUniReaderRunLengthDataDecode(
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1);
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Run-length decodes the planes of a cell field for all the blocks of a dump.
+// The compressed planes are read in series, as they come in the file, then
+// decoded in parallel.
+class vtkSpyPlotUniReaderPlaneDecoder
+{
+public:
+  vtkSpyPlotUniReaderPlaneDecoder(vtkSpyPlotUniReader* self)
+    : Self(self)
+    , Failed(false)
+  {
+  }
+
+  // Returns where to read the `numBytes` compressed bytes of a plane decoded
+  // into either `floatOut` or `byteOut`.
+  unsigned char* AddPlane(int numBytes, float* floatOut, unsigned char* byteOut, int outSize)
+  {
+    Plane plane;
+    plane.Offset = this->Buffer.size();
+    plane.Size = numBytes;
+    plane.FloatOut = floatOut;
+    plane.ByteOut = byteOut;
+    plane.OutSize = outSize;
+    this->Planes.push_back(plane);
+    this->Buffer.resize(this->Buffer.size() + numBytes);
+    return this->Buffer.data() + plane.Offset;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cc = begin; cc < end && !this->Failed; ++cc)
+    {
+      const Plane& plane = this->Planes[cc];
+      const unsigned char* in = this->Buffer.data() + plane.Offset;
+      if ((plane.FloatOut &&
+            !::vtkSpyPlotUniReaderRunLengthDataDecode(
+              this->Self, in, plane.Size, plane.FloatOut, plane.OutSize)) ||
+        (plane.ByteOut &&
+            !::vtkSpyPlotUniReaderRunLengthDataDecode(this->Self, in, plane.Size, plane.ByteOut,
+              plane.OutSize, static_cast<unsigned char>(255))))
+      {
+        this->Failed = true;
+      }
+    }
+  }
+
+  // Decodes the planes added since the last call. Returns false on error.
+  bool Decode()
+  {
+    this->Failed = false;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Planes.size()), *this);
+    this->Planes.clear();
+    this->Buffer.clear();
+    return !this->Failed;
+  }
+
+private:
+  struct Plane
+  {
+    size_t Offset;
+    int Size;
+    float* FloatOut;
+    unsigned char* ByteOut;
+    int OutSize;
+  };
+
+  vtkSpyPlotUniReader* Self;
+  std::vector<unsigned char> Buffer;
+  std::vector<Plane> Planes;
+  std::atomic<bool> Failed;
+};
+}
+
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::MakeCurrent()
 {
@@ -325,6 +409,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  vtkSpyPlotUniReaderPlaneDecoder decoder(this);
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -390,6 +475,9 @@ int vtkSpyPlotUniReader::MakeCurrent()
     int numBytes;
     int block;
     int actualBlockId = 0;
+    // The arrays read for each block. They are only kept once all of them are
+    // read and decoded, so that a failure leaves no partially read array.
+    std::vector<std::pair<int, vtkSmartPointer<vtkDataArray> > > readArrays;
     for (block = 0; block < dp->NumberOfBlocks; ++block)
     {
       vtkSpyPlotBlock* bk = this->Blocks + block;
@@ -397,18 +485,18 @@ int vtkSpyPlotUniReader::MakeCurrent()
       {
         vtkFloatArray* floatArray = 0;
         vtkUnsignedCharArray* unsignedCharArray = 0;
-        vtkDataArray* dataArray = 0;
+        vtkSmartPointer<vtkDataArray> dataArray;
         if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
         {
           if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
           {
             unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
+            dataArray.TakeReference(unsignedCharArray);
           }
           else
           {
             floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
+            dataArray.TakeReference(floatArray);
           }
           dataArray->SetNumberOfComponents(1);
           dataArray->SetNumberOfTuples(
@@ -428,6 +516,21 @@ int vtkSpyPlotUniReader::MakeCurrent()
             vtkErrorMacro("Problem reading the number of bytes");
             return 0;
           }
+          if (this->DecodeInParallel)
+          {
+            // Keep the plane, it is decoded with the others once all the
+            // blocks of the variable have been read.
+            unsigned char* buffer = decoder.AddPlane(numBytes,
+              floatArray ? floatArray->GetPointer(zax * planeSize) : nullptr,
+              unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : nullptr,
+              planeSize);
+            if (!spis.ReadString(buffer, numBytes))
+            {
+              vtkErrorMacro("Problem reading the bytes");
+              return 0;
+            }
+            continue;
+          }
           if (static_cast<int>(arrayBuffer.size()) < numBytes)
           {
             arrayBuffer.resize(numBytes);
@@ -458,13 +561,24 @@ int vtkSpyPlotUniReader::MakeCurrent()
         }
         if (dataArray)
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+          readArrays.push_back(std::make_pair(actualBlockId, dataArray));
           actualBlockId++;
         }
       }
     }
+    if (!decoder.Decode())
+    {
+      vtkErrorMacro("Problem RLD decoding data array " << var->Name);
+      return 0;
+    }
+    for (auto& readArray : readArrays)
+    {
+      vtkDataArray* dataArray = readArray.second;
+      dataArray->Register(nullptr);
+      var->DataBlocks[readArray.first] = dataArray;
+      var->GhostCellsFixed[readArray.first] = 0;
+      vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -664,7 +778,7 @@ void vtkSpyPlotUniReader::PrintInformation()
 //-----------------------------------------------------------------------------
 template <class t>
 int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
+  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale)
 {
   int outIndex = 0, inIndex = 0;
 
@@ -1337,6 +1451,7 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
+  os << indent << "DecodeInParallel: " << this->DecodeInParallel << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -231,6 +231,17 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  //@{
+  /**
+   * When on (the default), the run-length encoded planes of a cell field are
+   * read for all blocks first and then decoded in parallel using vtkSMPTools.
+   * When off, each plane is decoded as soon as it is read.
+   */
+  vtkSetMacro(DecodeInParallel, int);
+  vtkGetMacro(DecodeInParallel, int);
+  vtkBooleanMacro(DecodeInParallel, int);
+  //@}
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader() override;
@@ -306,6 +317,7 @@ private:
 
   int DataTypeChanged;
   int DownConvertVolumeFraction;
+  int DecodeInParallel;
 
   int NumberOfCellFields;
 
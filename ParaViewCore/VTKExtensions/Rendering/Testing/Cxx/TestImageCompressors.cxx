@@ -13,6 +13,7 @@
 
 =========================================================================*/
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -26,6 +27,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <cstring>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -81,6 +83,114 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   return true;
 }
 
+// Compresses and decompresses the input with and without band-parallel
+// compression and checks that both produce the same image.
+bool TestBands(vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+{
+  vtkNew<vtkUnsignedCharArray> results[2];
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    vtkNew<vtkUnsignedCharArray> compressed;
+    results[cc]->SetNumberOfComponents(input->GetNumberOfComponents());
+    results[cc]->SetNumberOfTuples(input->GetNumberOfTuples());
+
+    compressor->SetNumberOfBands(cc == 0 ? 1 : 7);
+    compressor->SetInput(input);
+    compressor->SetOutput(compressed.Get());
+    if (!compressor->Compress())
+    {
+      return false;
+    }
+    compressor->SetInput(compressed.Get());
+    compressor->SetOutput(results[cc].Get());
+    if (!compressor->Decompress())
+    {
+      return false;
+    }
+  }
+  compressor->SetNumberOfBands(1);
+
+  const vtkIdType numBytes = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  if (memcmp(results[0]->GetPointer(0), results[1]->GetPointer(0), numBytes) != 0)
+  {
+    cerr << "Band-parallel compression mismatch for " << compressor->GetClassName() << endl;
+    return false;
+  }
+  return true;
+}
+
+// Sends a sequence of frames through vtkDeltaImageCompressor, changing a small
+// region between frames, and checks that the round trip is exact and that only
+// the changed tiles are transmitted.
+bool TestDeltaFrames(vtkUnsignedCharArray* input, int width, int height)
+{
+  vtkNew<vtkDeltaImageCompressor> encoder;
+  vtkNew<vtkDeltaImageCompressor> decoder;
+  encoder->SetLossLessMode(1);
+  encoder->SetTileSize(16);
+  encoder->SetImageResolution(width, height);
+  decoder->SetImageResolution(width, height);
+
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  const int numComps = frame->GetNumberOfComponents();
+  const vtkIdType numBytes = frame->GetNumberOfTuples() * numComps;
+
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(numComps);
+  decompressed->SetNumberOfTuples(frame->GetNumberOfTuples());
+
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    if (cc > 0)
+    {
+      // modify a single pixel.
+      unsigned char* ptr = frame->GetPointer((width * (height / 2) + width / 2) * numComps);
+      ptr[0] = static_cast<unsigned char>(ptr[0] + 1);
+    }
+
+    encoder->SetInput(frame.Get());
+    encoder->SetOutput(compressed.Get());
+    if (!encoder->Compress())
+    {
+      cerr << "Delta compression failed for frame " << cc << endl;
+      return false;
+    }
+    if (encoder->GetLastFrameWasKeyFrame() != (cc == 0) ||
+      (cc > 0 && encoder->GetNumberOfChangedTiles() != 1))
+    {
+      cerr << "Unexpected tiles encoded for frame " << cc << ": "
+           << encoder->GetNumberOfChangedTiles() << endl;
+      return false;
+    }
+
+    decoder->SetInput(compressed.Get());
+    decoder->SetOutput(decompressed.Get());
+    if (!decoder->Decompress())
+    {
+      cerr << "Delta decompression failed for frame " << cc << endl;
+      return false;
+    }
+    if (memcmp(frame->GetPointer(0), decompressed->GetPointer(0), numBytes) != 0)
+    {
+      cerr << "Delta round trip mismatch for frame " << cc << endl;
+      return false;
+    }
+  }
+
+  // resetting must force a key frame.
+  encoder->Reset();
+  encoder->SetInput(frame.Get());
+  encoder->SetOutput(compressed.Get());
+  if (!encoder->Compress() || !encoder->GetLastFrameWasKeyFrame())
+  {
+    cerr << "Reset did not force a key frame." << endl;
+    return false;
+  }
+  return true;
+}
+
 int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
@@ -120,6 +230,23 @@ int TestImageCompressors(int argc, char* argv[])
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
+  if (!TestDeltaFrames(input, image->GetDimensions()[0], image->GetDimensions()[1]))
+  {
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkLZ4Compressor> bandedLZ4;
+  bandedLZ4->SetQuality(0);
+  vtkNew<vtkSquirtCompressor> bandedSquirt;
+  bandedSquirt->SetSquirtLevel(0);
+  vtkNew<vtkZlibImageCompressor> bandedZlib;
+  bandedZlib->SetCompressionLevel(1);
+  if (!TestBands(bandedLZ4.Get(), input) || !TestBands(bandedSquirt.Get(), input) ||
+    !TestBands(bandedZlib.Get(), input))
+  {
+    return TEST_FAILED;
+  }
+
   MapType datas;
   for (int cc = 0; cc < max_count; cc++)
   {
@@ -129,6 +256,12 @@ int TestImageCompressors(int argc, char* argv[])
     {
       return TEST_FAILED;
     }
+    lz4->SetNumberOfBands(8);
+    if (!DoTest(datas["LZ4 (quality: 0, bands: 8)"], lz4.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+    lz4->SetNumberOfBands(1);
     if (test_lossy)
     {
       lz4->SetQuality(3);
@@ -168,6 +301,14 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    vtkNew<vtkDeltaImageCompressor> delta;
+    delta->SetImageResolution(image->GetDimensions()[0], image->GetDimensions()[1]);
+    delta->SetQuality(0);
+    if (!DoTest(datas["DELTA (quality: 0)"], delta.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkZlibImageCompressor> zlib;
     zlib->SetCompressionLevel(1);
     if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input))
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVQuadricClustering.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVQuadricClustering reduces a height field to input points
+// with their point data, passes cell data and is deterministic.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPVQuadricClustering.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int Size = 100;
+
+// A height field of Size^2 quads with the ids of the points and cells.
+vtkSmartPointer<vtkPolyData> MakeSurface()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (int j = 0; j <= Size; ++j)
+  {
+    for (int i = 0; i <= Size; ++i)
+    {
+      pointIds->InsertNextValue(points->InsertNextPoint(
+        i, j, 10.0 * std::sin(0.1 * i) * std::cos(0.1 * j)));
+    }
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (int j = 0; j < Size; ++j)
+  {
+    for (int i = 0; i < Size; ++i)
+    {
+      const vtkIdType p = i + (Size + 1) * j;
+      vtkIdType quad[4] = { p, p + 1, p + Size + 2, p + Size + 1 };
+      cellIds->InsertNextValue(polys->InsertNextCell(4, quad));
+    }
+  }
+
+  auto surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->SetPoints(points.GetPointer());
+  surface->SetPolys(polys.GetPointer());
+  surface->GetPointData()->AddArray(pointIds.GetPointer());
+  surface->GetCellData()->AddArray(cellIds.GetPointer());
+  return surface;
+}
+}
+
+int TestPVQuadricClustering(int, char* [])
+{
+  vtkSmartPointer<vtkPolyData> surface = MakeSurface();
+
+  vtkNew<vtkPVQuadricClustering> decimator;
+  decimator->SetInputData(surface);
+  decimator->SetNumberOfDivisions(20, 20, 20);
+  decimator->Update();
+
+  vtkSmartPointer<vtkPolyData> output = decimator->GetOutput();
+  expect(output->GetNumberOfPolys() > 0, "no triangles were generated.");
+  expect(output->GetNumberOfPolys() < 2 * Size * Size, "the surface was not decimated.");
+  expect(output->GetNumberOfVerts() == 0 && output->GetNumberOfLines() == 0,
+    "unexpected vertices or lines.");
+
+  // output points are input points, with their point data.
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("PointIds"));
+  expect(pointIds && pointIds->GetNumberOfTuples() == output->GetNumberOfPoints(),
+    "missing point data.");
+  for (vtkIdType cc = 0; cc < output->GetNumberOfPoints(); ++cc)
+  {
+    double x[3], y[3];
+    output->GetPoint(cc, x);
+    surface->GetPoint(pointIds->GetValue(cc), y);
+    expect(vtkMath::Distance2BetweenPoints(x, y) == 0.0, "output point is not an input point.");
+  }
+
+  vtkIdTypeArray* cellIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("CellIds"));
+  expect(cellIds && cellIds->GetNumberOfTuples() == output->GetNumberOfCells(),
+    "missing cell data.");
+
+  // the output does not change from one execution to the next.
+  vtkNew<vtkPVQuadricClustering> decimator2;
+  decimator2->SetInputData(surface);
+  decimator2->SetNumberOfDivisions(20, 20, 20);
+  decimator2->Update();
+  vtkPolyData* output2 = decimator2->GetOutput();
+  expect(output2->GetNumberOfPoints() == output->GetNumberOfPoints() &&
+      output2->GetNumberOfCells() == output->GetNumberOfCells(),
+    "outputs differ.");
+  vtkIdTypeArray* pointIds2 =
+    vtkIdTypeArray::SafeDownCast(output2->GetPointData()->GetArray("PointIds"));
+  for (vtkIdType cc = 0; cc < output->GetNumberOfPoints(); ++cc)
+  {
+    expect(pointIds2->GetValue(cc) == pointIds->GetValue(cc), "outputs differ.");
+  }
+
+  // finer grids keep more of the surface.
+  decimator2->SetNumberOfDivisions(50, 50, 50);
+  decimator2->Update();
+  expect(decimator2->GetOutput()->GetNumberOfPolys() > output->GetNumberOfPolys(),
+    "finer grid does not produce more triangles.");
+
+  // with a single bin, everything collapses.
+  decimator2->SetNumberOfDivisions(1, 1, 1);
+  decimator2->Update();
+  expect(decimator2->GetOutput()->GetNumberOfCells() == 0, "cells did not collapse.");
+  return EXIT_SUCCESS;
+}
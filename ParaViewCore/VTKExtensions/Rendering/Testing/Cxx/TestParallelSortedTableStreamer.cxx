@@ -0,0 +1,196 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestParallelSortedTableStreamer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the blocks returned by vtkSortedTableStreamer across processes
+// holding the same values, so that every value is tied across processes, with
+// enough rows that the splitters are limited by MAX_SPLITTERS and must be
+// computed again around each block. The index is kept in memory and sorted
+// in a temporary file.
+#include <mpi.h>
+
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <vector>
+
+// Failures are recorded instead of returning, so that every process keeps
+// taking part in the same collective requests.
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "rank " << controller->GetLocalProcessId() << ", line " << __LINE__ << ": " msg        \
+         << endl;                                                                                  \
+    success = false;                                                                               \
+  }
+
+namespace
+{
+// Each process has RowsPerProcess rows holding NumberOfValues values, each
+// one RowsPerValue times. With 2 or more processes, the splitters are then
+// more than 4 * BlockSize rows apart and a block spans several processes.
+const vtkIdType RowsPerProcess = 1 << 21;
+const vtkIdType NumberOfValues = 1024;
+const vtkIdType RowsPerValue = RowsPerProcess / NumberOfValues;
+const vtkIdType BlockSize = 3;
+
+// Row i holds the value (i * 7919) % NumberOfValues, so the rows holding
+// value v are FirstRow[v] + k * NumberOfValues.
+float GetValue(vtkIdType row)
+{
+  return static_cast<float>((row * 7919) % NumberOfValues);
+}
+
+vtkSmartPointer<vtkTable> MakeTable()
+{
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(RowsPerProcess);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(RowsPerProcess);
+  for (vtkIdType cc = 0; cc < RowsPerProcess; ++cc)
+  {
+    values->SetValue(cc, GetValue(cc));
+    ids->SetValue(cc, static_cast<int>(cc));
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  table->AddColumn(values.GetPointer());
+  table->AddColumn(ids.GetPointer());
+  return table;
+}
+
+// Row at position `rank` in the global order: by value, then by process id,
+// then by row id. The inverted order is the exact reverse.
+void GetExpectedRow(vtkIdType rank, int numProcs, const std::vector<vtkIdType>& firstRow,
+  float& value, int& process, vtkIdType& id)
+{
+  const vtkIdType rowsPerGlobalValue = numProcs * RowsPerValue;
+  const vtkIdType v = rank / rowsPerGlobalValue;
+  const vtkIdType rest = rank % rowsPerGlobalValue;
+  value = static_cast<float>(v);
+  process = static_cast<int>(rest / RowsPerValue);
+  id = firstRow[v] + (rest % RowsPerValue) * NumberOfValues;
+}
+
+bool TestBlocks(vtkMultiProcessController* controller, vtkTable* table,
+  vtkIdType indexMemoryLimit, bool invertOrder)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  const vtkIdType globalRows = numProcs * RowsPerProcess;
+  std::vector<vtkIdType> firstRow(NumberOfValues);
+  for (vtkIdType cc = 0; cc < NumberOfValues; ++cc)
+  {
+    firstRow[static_cast<vtkIdType>(GetValue(cc))] = cc;
+  }
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(controller);
+  streamer->SetInputData(table);
+  streamer->SetColumnNameToSort("Values");
+  streamer->SetInvertOrder(invertOrder ? 1 : 0);
+  streamer->SetBlockSize(BlockSize);
+  streamer->SetIndexMemoryLimit(indexMemoryLimit);
+
+  bool success = true;
+  // The first and last blocks, and the blocks around the rows where the
+  // process changes, within a value and between two values.
+  const vtkIdType withinValue = 5 * numProcs * RowsPerValue + RowsPerValue;
+  const vtkIdType betweenValues = 6 * numProcs * RowsPerValue;
+  const vtkIdType numberOfBlocks = (globalRows + BlockSize - 1) / BlockSize;
+  const vtkIdType blocks[] = { 0, withinValue / BlockSize - 1, withinValue / BlockSize,
+    withinValue / BlockSize + 1, betweenValues / BlockSize - 1, betweenValues / BlockSize,
+    betweenValues / BlockSize + 1, numberOfBlocks - 1, withinValue / BlockSize };
+  for (vtkIdType block : blocks)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+
+    const vtkIdType first = block * BlockSize;
+    const vtkIdType expectedRows = vtkMath::Min(BlockSize, globalRows - first);
+    vtkIdType localRows = output->GetNumberOfRows();
+    vtkIdType rows = 0;
+    controller->AllReduce(&localRows, &rows, 1, vtkCommunicator::SUM_OP);
+    expect(rows == expectedRows, "block " << block << " has " << rows << " rows, expected "
+                                          << expectedRows << ".");
+    if (localRows == 0 || rows != expectedRows)
+    {
+      continue;
+    }
+
+    vtkDataArray* values = vtkDataArray::SafeDownCast(output->GetColumnByName("Values"));
+    vtkDataArray* ids = vtkDataArray::SafeDownCast(output->GetColumnByName("Ids"));
+    vtkDataArray* processes =
+      vtkDataArray::SafeDownCast(output->GetColumnByName("vtkOriginalProcessIds"));
+    expect(values && ids && (processes || numProcs == 1), "missing columns.");
+    for (vtkIdType row = 0; success && values && ids && row < localRows; ++row)
+    {
+      const vtkIdType rank = invertOrder ? globalRows - 1 - (first + row) : first + row;
+      float expectedValue;
+      int expectedProcess;
+      vtkIdType expectedId;
+      GetExpectedRow(rank, numProcs, firstRow, expectedValue, expectedProcess, expectedId);
+
+      const double value = values->GetTuple1(row);
+      const int process = processes ? static_cast<int>(processes->GetTuple1(row)) : 0;
+      const vtkIdType id = static_cast<vtkIdType>(ids->GetTuple1(row));
+      expect(value == expectedValue && process == expectedProcess && id == expectedId,
+        "block " << block << " row " << row << " is " << value << " from row " << id
+                 << " of process " << process << ", expected " << expectedValue << " from row "
+                 << expectedId << " of process " << expectedProcess << ".");
+    }
+  }
+  return success;
+}
+}
+
+int TestParallelSortedTableStreamer(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  vtkSmartPointer<vtkTable> table = MakeTable();
+  int success = 1;
+
+  // 0 keeps the index in memory, while 1 MiB is far less than what the index
+  // of RowsPerProcess rows takes, so that it is sorted in a temporary file.
+  for (vtkIdType indexMemoryLimit : { 0, 1024 })
+  {
+    for (bool invertOrder : { false, true })
+    {
+      if (!TestBlocks(controller.GetPointer(), table, indexMemoryLimit, invertOrder))
+      {
+        cerr << "Failed with IndexMemoryLimit " << indexMemoryLimit << " and InvertOrder "
+             << invertOrder << "." << endl;
+        success = 0;
+      }
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::MIN_OP);
+
+  vtkMultiProcessController::SetGlobalController(NULL);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSortedTableStreamer.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the blocks returned by vtkSortedTableStreamer, with the sorted index
+// kept in memory and sorted in a temporary file.
+
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const vtkIdType NumberOfRows = 10000;
+const vtkIdType BlockSize = 128;
+
+// Rows with the values 0 to NumberOfRows - 1, shuffled, and the row ids.
+vtkSmartPointer<vtkTable> MakeTable()
+{
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(NumberOfRows);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(NumberOfRows);
+  for (vtkIdType cc = 0; cc < NumberOfRows; ++cc)
+  {
+    // 7919 is prime, hence coprime with NumberOfRows.
+    values->SetValue(cc, static_cast<double>((cc * 7919) % NumberOfRows));
+    ids->SetValue(cc, cc);
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  table->AddColumn(values.GetPointer());
+  table->AddColumn(ids.GetPointer());
+  return table;
+}
+
+// Requests some of the blocks, including the last, partial one, and checks
+// that they hold the expected rows.
+bool TestBlocks(vtkIdType indexMemoryLimit, bool invertOrder)
+{
+  vtkNew<vtkDummyController> controller;
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(controller.GetPointer());
+  streamer->SetInputData(MakeTable());
+  streamer->SetColumnNameToSort("Values");
+  streamer->SetInvertOrder(invertOrder ? 1 : 0);
+  streamer->SetBlockSize(BlockSize);
+  streamer->SetIndexMemoryLimit(indexMemoryLimit);
+
+  const vtkIdType numberOfBlocks = (NumberOfRows + BlockSize - 1) / BlockSize;
+  const vtkIdType blocks[] = { 0, 1, 40, 3, numberOfBlocks - 1, 40 };
+  for (vtkIdType block : blocks)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+    vtkDataArray* values = vtkDataArray::SafeDownCast(output->GetColumnByName("Values"));
+    vtkDataArray* ids = vtkDataArray::SafeDownCast(output->GetColumnByName("Ids"));
+    expect(values && ids, "missing columns.");
+
+    const vtkIdType first = block * BlockSize;
+    const vtkIdType expectedRows = std::min(BlockSize, NumberOfRows - first);
+    expect(output->GetNumberOfRows() == expectedRows, "block " << block << " has "
+                                                              << output->GetNumberOfRows()
+                                                              << " rows, expected "
+                                                              << expectedRows << ".");
+    for (vtkIdType row = 0; row < expectedRows; ++row)
+    {
+      const vtkIdType rank = first + row;
+      const double expected = static_cast<double>(invertOrder ? NumberOfRows - 1 - rank : rank);
+      const double value = values->GetTuple1(row);
+      expect(value == expected, "block " << block << " row " << row << " is " << value
+                                         << ", expected " << expected << ".");
+      const vtkIdType id = static_cast<vtkIdType>(ids->GetTuple1(row));
+      expect(static_cast<double>((id * 7919) % NumberOfRows) == value,
+        "row " << row << " of block " << block << " does not match its id.");
+    }
+  }
+  return true;
+}
+}
+
+int TestSortedTableStreamer(int, char* [])
+{
+  // 0 keeps the index in memory, while 1 KiB is far less than what the index
+  // of NumberOfRows rows takes, so that it is sorted in a temporary file by
+  // many runs.
+  for (vtkIdType indexMemoryLimit : { 0, 1 })
+  {
+    for (bool invertOrder : { false, true })
+    {
+      if (!TestBlocks(indexMemoryLimit, invertOrder))
+      {
+        cerr << "Failed with IndexMemoryLimit " << indexMemoryLimit << " and InvertOrder "
+             << invertOrder << "." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestThreadedSurfaceExtraction.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the threaded surface extraction of vtkPVGeometryFilter produces
+// the same surface as vtkDataSetSurfaceFilter for grids of hexahedra and
+// tetrahedra, including the original ids arrays, and that hidden cells are
+// ignored while ghost cells only hide the faces of their neighbors.
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int Size = 4;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Size + 1) * (j + (Size + 1) * k);
+}
+
+// A cube of Size^3 hexahedra, or of 6 tetrahedra per hexahedron.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(bool tetrahedra)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Size; ++k)
+  {
+    for (int j = 0; j <= Size; ++j)
+    {
+      for (int i = 0; i <= Size; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points.Get());
+  grid->Allocate();
+  for (int k = 0; k < Size; ++k)
+  {
+    for (int j = 0; j < Size; ++j)
+    {
+      for (int i = 0; i < Size; ++i)
+      {
+        if (!tetrahedra)
+        {
+          vtkIdType hex[8] = { PointId(i, j, k), PointId(i + 1, j, k), PointId(i + 1, j + 1, k),
+            PointId(i, j + 1, k), PointId(i, j, k + 1), PointId(i + 1, j, k + 1),
+            PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+          continue;
+        }
+        // split along the main diagonal so that the faces of neighboring
+        // cells match.
+        const int axes[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 },
+          { 2, 1, 0 } };
+        for (int t = 0; t < 6; ++t)
+        {
+          int ijk[3] = { i, j, k };
+          vtkIdType tet[4];
+          tet[0] = PointId(ijk[0], ijk[1], ijk[2]);
+          for (int cc = 0; cc < 3; ++cc)
+          {
+            ++ijk[axes[t][cc]];
+            tet[cc + 1] = PointId(ijk[0], ijk[1], ijk[2]);
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+      }
+    }
+  }
+  return grid;
+}
+
+// Faces as their cell id and their sorted point ids in the grid.
+typedef std::set<std::pair<vtkIdType, std::vector<vtkIdType> > > FaceSet;
+
+// The faces of the visible cells that no other visible cell uses, except
+// those of ghost cells.
+FaceSet GetExpectedFaces(vtkUnstructuredGrid* grid)
+{
+  vtkUnsignedCharArray* ghosts = grid->GetCellGhostArray();
+  std::map<std::vector<vtkIdType>, std::vector<vtkIdType> > cellsPerFace;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    if (ghosts && (ghosts->GetValue(cellId) & vtkDataSetAttributes::HIDDENCELL))
+    {
+      continue;
+    }
+    vtkCell* cell = grid->GetCell(cellId);
+    for (int face = 0; face < cell->GetNumberOfFaces(); ++face)
+    {
+      vtkIdList* ids = cell->GetFace(face)->GetPointIds();
+      std::vector<vtkIdType> key(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds());
+      std::sort(key.begin(), key.end());
+      cellsPerFace[key].push_back(cellId);
+    }
+  }
+  FaceSet faces;
+  for (const auto& face : cellsPerFace)
+  {
+    const vtkIdType cellId = face.second[0];
+    if (face.second.size() == 1 &&
+      !(ghosts && (ghosts->GetValue(cellId) & vtkDataSetAttributes::DUPLICATECELL)))
+    {
+      faces.insert(std::make_pair(cellId, face.first));
+    }
+  }
+  return faces;
+}
+
+// The faces of a surface, using its original ids.
+FaceSet GetFaces(vtkPolyData* surface)
+{
+  vtkIdTypeArray* cellIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetCellData()->GetArray("vtkOriginalCellIds"));
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+  FaceSet faces;
+  if (!cellIds || !pointIds)
+  {
+    return faces;
+  }
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cc = 0; cc < surface->GetNumberOfCells(); ++cc)
+  {
+    surface->GetCellPoints(cc, ids.Get());
+    std::vector<vtkIdType> key;
+    for (vtkIdType pp = 0; pp < ids->GetNumberOfIds(); ++pp)
+    {
+      key.push_back(pointIds->GetValue(ids->GetId(pp)));
+    }
+    std::sort(key.begin(), key.end());
+    faces.insert(std::make_pair(cellIds->GetValue(cc), key));
+  }
+  return faces;
+}
+
+// Flags the cells of the grid, i being the fastest varying index of the
+// hexahedra, and 6 tetrahedra being made of each hexahedron.
+void SetGhosts(vtkUnstructuredGrid* grid, bool tetrahedra,
+  const std::vector<std::pair<int, unsigned char> >& hexahedra)
+{
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(grid->GetNumberOfCells());
+  ghosts->FillValue(0);
+  const int cellsPerHexahedron = tetrahedra ? 6 : 1;
+  for (const auto& hexahedron : hexahedra)
+  {
+    for (int cc = 0; cc < cellsPerHexahedron; ++cc)
+    {
+      ghosts->SetValue(hexahedron.first * cellsPerHexahedron + cc, hexahedron.second);
+    }
+  }
+  grid->GetCellData()->AddArray(ghosts.Get());
+}
+
+vtkSmartPointer<vtkPolyData> ExtractSurface(vtkUnstructuredGrid* grid, bool threaded)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetUseThreadedSurfaceExtraction(threaded);
+  filter->SetInputData(grid);
+  filter->Update();
+  return vtkPolyData::SafeDownCast(filter->GetOutputDataObject(0));
+}
+}
+
+int TestThreadedSurfaceExtraction(int, char* [])
+{
+  const vtkIdType numSurfacePoints = (Size + 1) * (Size + 1) * (Size + 1) -
+    (Size - 1) * (Size - 1) * (Size - 1);
+  for (int tetrahedra = 0; tetrahedra < 2; ++tetrahedra)
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(tetrahedra != 0);
+    vtkSmartPointer<vtkPolyData> reference = ExtractSurface(grid, false);
+    vtkSmartPointer<vtkPolyData> surface = ExtractSurface(grid, true);
+    expect(reference && surface, "missing output.");
+
+    const vtkIdType numFaces = 6 * Size * Size * (tetrahedra ? 2 : 1);
+    expect(reference->GetNumberOfPolys() == numFaces, "unexpected reference surface.");
+    expect(surface->GetNumberOfPolys() == numFaces,
+      "expected " << numFaces << " faces, got " << surface->GetNumberOfPolys());
+    expect(surface->GetNumberOfPoints() == numSurfacePoints,
+      "expected " << numSurfacePoints << " points, got " << surface->GetNumberOfPoints());
+
+    vtkIdTypeArray* cellIds =
+      vtkIdTypeArray::SafeDownCast(surface->GetCellData()->GetArray("vtkOriginalCellIds"));
+    vtkIdTypeArray* pointIds =
+      vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+    expect(cellIds && cellIds->GetNumberOfTuples() == numFaces, "missing vtkOriginalCellIds.");
+    expect(pointIds && pointIds->GetNumberOfTuples() == numSurfacePoints,
+      "missing vtkOriginalPointIds.");
+    for (vtkIdType cc = 0; cc < numSurfacePoints; ++cc)
+    {
+      double p1[3], p2[3];
+      surface->GetPoint(cc, p1);
+      grid->GetPoint(pointIds->GetValue(cc), p2);
+      expect(p1[0] == p2[0] && p1[1] == p2[1] && p1[2] == p2[2], "wrong vtkOriginalPointIds.");
+      const bool onBoundary = p1[0] == 0 || p1[0] == Size || p1[1] == 0 || p1[1] == Size ||
+        p1[2] == 0 || p1[2] == Size;
+      expect(onBoundary, "point not on the surface.");
+    }
+    expect(GetFaces(surface) == GetExpectedFaces(grid) && GetFaces(reference) == GetFaces(surface),
+      "the faces differ from those of the reference surface.");
+
+    // Hidden cells, at a corner and inside, are ignored: the faces of their
+    // neighbors become part of the surface.
+    const int corner = 0;
+    const int inside = 1 + Size * (1 + Size);
+    SetGhosts(grid, tetrahedra != 0, { { corner, vtkDataSetAttributes::HIDDENCELL },
+                                       { inside, vtkDataSetAttributes::HIDDENCELL } });
+    surface = ExtractSurface(grid, true);
+    const FaceSet expectedHidden = GetExpectedFaces(grid);
+    expect(expectedHidden.size() == static_cast<size_t>(numFaces + 6 * (tetrahedra ? 2 : 1)),
+      "unexpected reference surface with hidden cells.");
+    expect(GetFaces(surface) == expectedHidden, "wrong surface with hidden cells, "
+        << surface->GetNumberOfPolys() << " faces instead of " << expectedHidden.size());
+
+    // Ghost cells, on the side x = Size as when they come from another
+    // process, hide the faces of their neighbors and have no faces.
+    std::vector<std::pair<int, unsigned char> > ghostCells;
+    for (int cc = Size - 1; cc < Size * Size * Size; cc += Size)
+    {
+      ghostCells.push_back(std::make_pair(cc, vtkDataSetAttributes::DUPLICATECELL));
+    }
+    SetGhosts(grid, tetrahedra != 0, ghostCells);
+    surface = ExtractSurface(grid, true);
+    const FaceSet expectedGhosts = GetExpectedFaces(grid);
+    const vtkIdType ghostFaces = (Size * Size + 4 * Size) * (tetrahedra ? 2 : 1);
+    expect(expectedGhosts.size() == static_cast<size_t>(numFaces - ghostFaces),
+      "unexpected reference surface with ghost cells.");
+    expect(GetFaces(surface) == expectedGhosts, "wrong surface with ghost cells, "
+        << surface->GetNumberOfPolys() << " faces instead of " << expectedGhosts.size());
+  }
+  return EXIT_SUCCESS;
+}
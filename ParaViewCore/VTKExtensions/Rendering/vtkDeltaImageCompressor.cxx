@@ -0,0 +1,401 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkType.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+// Layout of the stream produced by vtkDeltaImageCompressor::Compress():
+//   Header
+//   NumberOfTiles x vtkTypeInt32 tile ids
+//   LZ4 compressed payload (PayloadSize bytes when decompressed)
+struct vtkDeltaImageHeader
+{
+  vtkTypeInt32 Magic;
+  vtkTypeInt32 Width;
+  vtkTypeInt32 Height;
+  vtkTypeInt32 NumberOfComponents;
+  vtkTypeInt32 TileSize;
+  vtkTypeInt32 KeyFrame;
+  vtkTypeInt32 NumberOfTiles;
+  vtkTypeInt32 PayloadSize;
+};
+
+const vtkTypeInt32 DELTA_IMAGE_MAGIC = 0x31544c44; // "DLT1"
+
+// Visits the rows of a tile. The functor is called with the byte offset of
+// the row in the image and the number of bytes in the row.
+template <typename Functor>
+void ForEachTileRow(int tileId, int width, int height, int tileSize, int numComps, Functor f)
+{
+  const int tilesX = (width + tileSize - 1) / tileSize;
+  const int x0 = (tileId % tilesX) * tileSize;
+  const int y0 = (tileId / tilesX) * tileSize;
+  const int x1 = std::min(x0 + tileSize, width);
+  const int y1 = std::min(y0 + tileSize, height);
+  const size_t rowBytes = static_cast<size_t>(x1 - x0) * numComps;
+  for (int y = y0; y < y1; ++y)
+  {
+    f((static_cast<size_t>(y) * width + x0) * numComps, rowBytes);
+  }
+}
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(3)
+  , TileSize(32)
+  , Width(0)
+  , Height(0)
+  , NumberOfChangedTiles(0)
+  , LastFrameWasKeyFrame(false)
+  , ForceKeyFrame(true)
+  , LastCompressLevel(-1)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::Reset()
+{
+  this->ForceKeyFrame = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  if (this->Width != width || this->Height != height)
+  {
+    this->Width = width;
+    this->Height = height;
+    this->Reset();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+    { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+  int compress_level = this->LossLessMode ? 0 : this->Quality;
+  assert(compress_level >= 0 && compress_level <= 5);
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+
+  int width = this->Width;
+  int height = this->Height;
+  if (static_cast<vtkIdType>(width) * height != numPixels)
+  {
+    width = static_cast<int>(numPixels);
+    height = 1;
+  }
+
+  if (compress_level > 0 && numComps == 4)
+  {
+    unsigned int compress_mask;
+    memcpy(&compress_mask, &compress_masks[compress_level], 4);
+
+    this->TemporaryBuffer->SetNumberOfComponents(numComps);
+    this->TemporaryBuffer->SetNumberOfTuples(numPixels);
+    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
+    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
+    for (vtkIdType cc = 0; cc < numPixels; ++cc)
+    {
+      out[cc] = in[cc] & compress_mask;
+    }
+    input = this->TemporaryBuffer.Get();
+  }
+
+  vtkUnsignedCharArray* reference = this->EncoderReference.Get();
+  const bool keyFrame = this->ForceKeyFrame || compress_level != this->LastCompressLevel ||
+    reference->GetNumberOfComponents() != numComps || reference->GetNumberOfTuples() != numPixels;
+  if (keyFrame)
+  {
+    reference->SetNumberOfComponents(numComps);
+    reference->SetNumberOfTuples(numPixels);
+  }
+
+  const int tileSize = this->TileSize;
+  const int tilesX = (width + tileSize - 1) / tileSize;
+  const int tilesY = (height + tileSize - 1) / tileSize;
+  const unsigned char* current = input->GetPointer(0);
+  unsigned char* previous = reference->GetPointer(0);
+
+  std::vector<vtkTypeInt32> tileIds;
+  this->Payload.clear();
+  for (int tileId = 0, maxTileId = tilesX * tilesY; tileId < maxTileId; ++tileId)
+  {
+    bool changed = keyFrame;
+    if (!changed)
+    {
+      ForEachTileRow(tileId, width, height, tileSize, numComps, [&](size_t offset, size_t bytes) {
+        changed = changed || memcmp(current + offset, previous + offset, bytes) != 0;
+      });
+    }
+    if (changed)
+    {
+      tileIds.push_back(tileId);
+      ForEachTileRow(tileId, width, height, tileSize, numComps, [&](size_t offset, size_t bytes) {
+        this->Payload.insert(this->Payload.end(), current + offset, current + offset + bytes);
+        memcpy(previous + offset, current + offset, bytes);
+      });
+    }
+  }
+
+  vtkDeltaImageHeader header;
+  header.Magic = DELTA_IMAGE_MAGIC;
+  header.Width = width;
+  header.Height = height;
+  header.NumberOfComponents = numComps;
+  header.TileSize = tileSize;
+  header.KeyFrame = keyFrame ? 1 : 0;
+  header.NumberOfTiles = static_cast<vtkTypeInt32>(tileIds.size());
+  header.PayloadSize = static_cast<vtkTypeInt32>(this->Payload.size());
+
+  const size_t idsSize = tileIds.size() * sizeof(vtkTypeInt32);
+  const int maxPayloadSize = LZ4_compressBound(header.PayloadSize);
+  const size_t maxOutputSize = sizeof(header) + idsSize + maxPayloadSize;
+
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* outPtr =
+    this->Output->WritePointer(0, static_cast<vtkIdType>(maxOutputSize));
+  memcpy(outPtr, &header, sizeof(header));
+  if (idsSize > 0)
+  {
+    memcpy(outPtr + sizeof(header), &tileIds[0], idsSize);
+  }
+
+  int compressedSize = 0;
+  if (header.PayloadSize > 0)
+  {
+    compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(&this->Payload[0]),
+      reinterpret_cast<char*>(outPtr + sizeof(header) + idsSize), header.PayloadSize,
+      maxPayloadSize, 1);
+    if (compressedSize <= 0)
+    {
+      vtkErrorMacro("LZ4 compression of changed tiles failed.");
+      this->Reset();
+      return VTK_ERROR;
+    }
+  }
+  this->Output->SetNumberOfTuples(
+    static_cast<vtkIdType>(sizeof(header) + idsSize + compressedSize));
+
+  this->ForceKeyFrame = false;
+  this->LastCompressLevel = compress_level;
+  this->LastFrameWasKeyFrame = keyFrame;
+  this->NumberOfChangedTiles = header.NumberOfTiles;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType inputSize =
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents();
+  if (inputSize < static_cast<vtkIdType>(sizeof(vtkDeltaImageHeader)))
+  {
+    vtkErrorMacro("Compressed stream is too small.");
+    return VTK_ERROR;
+  }
+
+  const unsigned char* inPtr = this->Input->GetPointer(0);
+  vtkDeltaImageHeader header;
+  memcpy(&header, inPtr, sizeof(header));
+  if (header.Magic != DELTA_IMAGE_MAGIC || header.Width < 0 || header.Height < 0 ||
+    header.TileSize <= 0 || header.NumberOfTiles < 0 || header.PayloadSize < 0)
+  {
+    vtkErrorMacro("Invalid delta image stream.");
+    return VTK_ERROR;
+  }
+
+  const int numComps = header.NumberOfComponents;
+  const vtkIdType numPixels = static_cast<vtkIdType>(header.Width) * header.Height;
+  if (this->Output->GetNumberOfComponents() != numComps ||
+    this->Output->GetNumberOfTuples() != numPixels)
+  {
+    vtkErrorMacro("Output array does not match the compressed image dimensions.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* reference = this->DecoderReference.Get();
+  if (header.KeyFrame)
+  {
+    reference->SetNumberOfComponents(numComps);
+    reference->SetNumberOfTuples(numPixels);
+  }
+  else if (reference->GetNumberOfComponents() != numComps ||
+    reference->GetNumberOfTuples() != numPixels)
+  {
+    vtkErrorMacro("Received a delta frame without a matching reference frame.");
+    return VTK_ERROR;
+  }
+
+  const size_t idsSize = static_cast<size_t>(header.NumberOfTiles) * sizeof(vtkTypeInt32);
+  if (static_cast<vtkIdType>(sizeof(header) + idsSize) > inputSize)
+  {
+    vtkErrorMacro("Compressed stream is truncated.");
+    return VTK_ERROR;
+  }
+  std::vector<vtkTypeInt32> tileIds(header.NumberOfTiles);
+  if (idsSize > 0)
+  {
+    memcpy(&tileIds[0], inPtr + sizeof(header), idsSize);
+  }
+
+  this->Payload.resize(header.PayloadSize);
+  if (header.PayloadSize > 0)
+  {
+    const int compressedSize = static_cast<int>(inputSize - sizeof(header) - idsSize);
+    int decompressedSize =
+      LZ4_decompress_safe(reinterpret_cast<const char*>(inPtr + sizeof(header) + idsSize),
+        reinterpret_cast<char*>(&this->Payload[0]), compressedSize, header.PayloadSize);
+    if (decompressedSize != header.PayloadSize)
+    {
+      vtkErrorMacro("LZ4 decompression of changed tiles failed.");
+      return VTK_ERROR;
+    }
+  }
+
+  const int tilesX = (header.Width + header.TileSize - 1) / header.TileSize;
+  const int tilesY = (header.Height + header.TileSize - 1) / header.TileSize;
+  unsigned char* refPtr = reference->GetPointer(0);
+  size_t payloadOffset = 0;
+  bool overflow = false;
+  for (auto tileId : tileIds)
+  {
+    if (tileId < 0 || tileId >= tilesX * tilesY)
+    {
+      overflow = true;
+      break;
+    }
+    ForEachTileRow(tileId, header.Width, header.Height, header.TileSize, numComps,
+      [&](size_t offset, size_t bytes) {
+        if (payloadOffset + bytes > this->Payload.size())
+        {
+          overflow = true;
+          return;
+        }
+        memcpy(refPtr + offset, &this->Payload[payloadOffset], bytes);
+        payloadOffset += bytes;
+      });
+  }
+  if (overflow)
+  {
+    vtkErrorMacro("Invalid tile data in delta image stream.");
+    return VTK_ERROR;
+  }
+
+  memcpy(this->Output->GetPointer(0), refPtr, static_cast<size_t>(numPixels) * numComps);
+  this->LastFrameWasKeyFrame = header.KeyFrame != 0;
+  this->NumberOfChangedTiles = header.NumberOfTiles;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->TileSize;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, tileSize;
+    *stream >> quality >> tileSize;
+    this->SetQuality(quality);
+    this->SetTileSize(tileSize);
+    this->Reset();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " " << this->TileSize;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality = this->Quality;
+    int tileSize = this->TileSize;
+    iss >> quality;
+    // TileSize is optional so that "vtkDeltaImageCompressor 0 3" is valid.
+    if (!(iss >> tileSize))
+    {
+      iss.clear();
+      iss.seekg(0, std::ios::end);
+    }
+    this->SetQuality(quality);
+    this->SetTileSize(tileSize);
+    this->Reset();
+    return stream + iss.tellg();
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "NumberOfChangedTiles: " << this->NumberOfChangedTiles << endl;
+  os << indent << "LastFrameWasKeyFrame: " << this->LastFrameWasKeyFrame << endl;
+}
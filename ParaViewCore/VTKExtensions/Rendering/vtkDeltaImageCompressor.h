@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that only transmits the tiles that
+ * changed since the previous frame.
+ *
+ * vtkDeltaImageCompressor splits the image into square tiles of TileSize
+ * pixels and compares each tile against the previously compressed frame. Only
+ * the tiles that differ are packed and encoded with LZ4. The decompressing
+ * side keeps its own copy of the last decoded frame and patches the received
+ * tiles into it.
+ *
+ * Since both sides must agree on the reference frame, the compressing side
+ * decides when a full frame (key frame) is sent: on the first frame, whenever
+ * the image resolution or the number of components changes, whenever the
+ * effective quality changes (e.g. switching between interactive and still
+ * renders) and after Reset() has been called. The decompressing side simply
+ * follows what is recorded in the stream.
+ *
+ * Like vtkLZ4Compressor, Quality values greater than 0 apply a color mask to
+ * RGBA images before comparing and encoding them. The mask is applied to the
+ * reference frame as well, so small color variations below the mask
+ * precision do not cause tiles to be retransmitted.
+ *
+ * Compress() and Decompress() expect SetImageResolution() to have been called
+ * with the dimensions of the image. If the resolution does not match the
+ * number of tuples in the input, the image is treated as a single row.
+*/
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkNew.h"                            // needed for vtkNew
+#include "vtkPVVTKExtensionsRenderingModule.h" // needed for exports
+
+#include <vector> // needed for std::vector
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. Same as vtkLZ4Compressor::SetQuality.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the edge length, in pixels, of the square tiles the image is split
+   * into. Smaller tiles track changes more tightly at the expense of a larger
+   * tile index. Default is 32.
+   */
+  vtkSetClampMacro(TileSize, int, 4, 512);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Overridden to reset the reference frame when the resolution changes.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  /**
+   * Discard the reference frame. The next call to Compress() will encode a
+   * full frame.
+   */
+  void Reset();
+
+  /**
+   * Returns the number of tiles encoded by the last call to Compress() or
+   * decoded by the last call to Decompress().
+   */
+  vtkGetMacro(NumberOfChangedTiles, int);
+
+  /**
+   * Returns true if the last frame compressed or decompressed was a key frame.
+   */
+  vtkGetMacro(LastFrameWasKeyFrame, bool);
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   * Restoring a configuration resets the reference frame.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int TileSize;
+  int Width;
+  int Height;
+
+  int NumberOfChangedTiles;
+  bool LastFrameWasKeyFrame;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  // Last frame encoded by Compress(), with the color mask applied.
+  vtkNew<vtkUnsignedCharArray> EncoderReference;
+  // Last frame reconstructed by Decompress().
+  vtkNew<vtkUnsignedCharArray> DecoderReference;
+  // Used when Quality > 0.
+  vtkNew<vtkUnsignedCharArray> TemporaryBuffer;
+  // Packed pixels for the changed tiles.
+  std::vector<unsigned char> Payload;
+
+  bool ForceKeyFrame;
+  int LastCompressLevel;
+};
+
+#endif
@@ -17,9 +17,101 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkType.h"
 #include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
+
+namespace
+{
+// Stream produced by vtkImageCompressor::CompressBands():
+//   vtkTypeInt32 magic
+//   vtkTypeInt32 number of bands
+//   number of bands x [vtkTypeInt32 number of tuples, vtkTypeInt32 compressed size]
+//   compressed bands, back to back.
+const vtkTypeInt32 BANDED_IMAGE_MAGIC = 0x31444e42; // "BND1"
+
+struct vtkBandInfo
+{
+  vtkTypeInt32 NumberOfTuples;
+  vtkTypeInt32 CompressedSize;
+};
+}
+
+class vtkImageCompressor::vtkInternals
+{
+public:
+  struct Band
+  {
+    vtkSmartPointer<vtkImageCompressor> Compressor;
+    vtkSmartPointer<vtkUnsignedCharArray> Input;
+    vtkSmartPointer<vtkUnsignedCharArray> Output;
+    vtkIdType Offset; // in tuples, for the uncompressed image.
+    vtkIdType NumberOfTuples;
+    int Status;
+  };
+  std::vector<Band> Bands;
+
+  // Ensures that there are `count` bands, each with a compressor instance
+  // of the same type and configuration as `self`.
+  void Prepare(vtkImageCompressor* self, int count)
+  {
+    vtkMultiProcessStream config;
+    self->SaveConfiguration(&config);
+
+    this->Bands.resize(count);
+    for (auto& band : this->Bands)
+    {
+      if (band.Compressor == nullptr ||
+        strcmp(band.Compressor->GetClassName(), self->GetClassName()) != 0)
+      {
+        band.Compressor.TakeReference(self->NewInstance());
+        band.Input = vtkSmartPointer<vtkUnsignedCharArray>::New();
+        band.Output = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      }
+      vtkMultiProcessStream copy(config);
+      band.Compressor->RestoreConfiguration(&copy);
+      band.Compressor->SetNumberOfBands(1);
+      band.Compressor->SetInput(band.Input);
+      band.Compressor->SetOutput(band.Output);
+      band.Status = VTK_ERROR;
+    }
+  }
+
+  // Runs Compress() or Decompress() on each band using vtkSMPTools.
+  class BandWorker
+  {
+  public:
+    std::vector<Band>& Bands;
+    bool Decompress;
+    BandWorker(std::vector<Band>& bands, bool decompress)
+      : Bands(bands)
+      , Decompress(decompress)
+    {
+    }
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        Band& band = this->Bands[cc];
+        band.Status =
+          this->Decompress ? band.Compressor->Decompress() : band.Compressor->Compress();
+      }
+    }
+  };
+
+  void Execute(bool decompress)
+  {
+    BandWorker worker(this->Bands, decompress);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Bands.size()), 1, worker);
+  }
+};
 
 //-----------------------------------------------------------------------------
 vtkCxxSetObjectMacro(vtkImageCompressor, Output, vtkUnsignedCharArray);
@@ -32,7 +124,9 @@ vtkImageCompressor::vtkImageCompressor()
   : Output(0)
   , Input(0)
   , LossLessMode(0)
+  , NumberOfBands(1)
   , Configuration(0)
+  , Internals(new vtkImageCompressor::vtkInternals())
 {
   // Always allocate output array as a convenience.
   vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
@@ -46,6 +140,7 @@ vtkImageCompressor::~vtkImageCompressor()
   this->SetOutput(0);
   this->SetInput(0);
   this->SetConfiguration(NULL);
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
@@ -53,6 +148,142 @@ void vtkImageCompressor::SetImageResolution(int, int)
 {
 }
 
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::CompressBands()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numTuples = input->GetNumberOfTuples();
+  const int numBands =
+    static_cast<int>(std::max<vtkIdType>(1, std::min<vtkIdType>(this->NumberOfBands, numTuples)));
+
+  auto& bands = this->Internals->Bands;
+  this->Internals->Prepare(this, numBands);
+  for (int cc = 0; cc < numBands; ++cc)
+  {
+    auto& band = bands[cc];
+    band.Offset = (numTuples * cc) / numBands;
+    band.NumberOfTuples = (numTuples * (cc + 1)) / numBands - band.Offset;
+    band.Input->SetNumberOfComponents(numComps);
+    band.Input->SetArray(
+      input->GetPointer(band.Offset * numComps), band.NumberOfTuples * numComps, /*save*/ 1);
+  }
+
+  this->Internals->Execute(/*decompress*/ false);
+
+  std::vector<vtkBandInfo> infos(numBands);
+  size_t totalSize = 2 * sizeof(vtkTypeInt32) + numBands * sizeof(vtkBandInfo);
+  for (int cc = 0; cc < numBands; ++cc)
+  {
+    auto& band = bands[cc];
+    if (band.Status == VTK_ERROR)
+    {
+      return VTK_ERROR;
+    }
+    infos[cc].NumberOfTuples = static_cast<vtkTypeInt32>(band.NumberOfTuples);
+    infos[cc].CompressedSize = static_cast<vtkTypeInt32>(
+      band.Output->GetNumberOfTuples() * band.Output->GetNumberOfComponents());
+    totalSize += infos[cc].CompressedSize;
+  }
+
+  vtkTypeInt32 header[2] = { BANDED_IMAGE_MAGIC, numBands };
+  this->Output->SetNumberOfComponents(1);
+  unsigned char* outPtr = this->Output->WritePointer(0, static_cast<vtkIdType>(totalSize));
+  memcpy(outPtr, header, sizeof(header));
+  outPtr += sizeof(header);
+  memcpy(outPtr, &infos[0], numBands * sizeof(vtkBandInfo));
+  outPtr += numBands * sizeof(vtkBandInfo);
+  for (int cc = 0; cc < numBands; ++cc)
+  {
+    memcpy(outPtr, bands[cc].Output->GetPointer(0), infos[cc].CompressedSize);
+    outPtr += infos[cc].CompressedSize;
+  }
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+int vtkImageCompressor::DecompressBands()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType inputSize =
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents();
+  const unsigned char* inPtr = this->Input->GetPointer(0);
+  vtkTypeInt32 header[2] = { 0, 0 };
+  if (inputSize >= static_cast<vtkIdType>(sizeof(header)))
+  {
+    memcpy(header, inPtr, sizeof(header));
+  }
+  const int numBands = header[1];
+  if (header[0] != BANDED_IMAGE_MAGIC || numBands <= 0 ||
+    inputSize < static_cast<vtkIdType>(sizeof(header) + numBands * sizeof(vtkBandInfo)))
+  {
+    vtkErrorMacro("Input is not a band-parallel compressed image.");
+    return VTK_ERROR;
+  }
+
+  std::vector<vtkBandInfo> infos(numBands);
+  memcpy(&infos[0], inPtr + sizeof(header), numBands * sizeof(vtkBandInfo));
+
+  vtkUnsignedCharArray* output = this->Output;
+  const int numComps = output->GetNumberOfComponents();
+  auto& bands = this->Internals->Bands;
+  this->Internals->Prepare(this, numBands);
+
+  vtkIdType inOffset = sizeof(header) + numBands * sizeof(vtkBandInfo);
+  vtkIdType outOffset = 0;
+  for (int cc = 0; cc < numBands; ++cc)
+  {
+    auto& band = bands[cc];
+    if (infos[cc].NumberOfTuples < 0 || infos[cc].CompressedSize < 0 ||
+      inOffset + infos[cc].CompressedSize > inputSize ||
+      outOffset + infos[cc].NumberOfTuples > output->GetNumberOfTuples())
+    {
+      vtkErrorMacro("Band-parallel compressed image is truncated or corrupt.");
+      return VTK_ERROR;
+    }
+    band.Offset = outOffset;
+    band.NumberOfTuples = infos[cc].NumberOfTuples;
+    band.Input->SetNumberOfComponents(1);
+    band.Input->SetArray(const_cast<unsigned char*>(inPtr + inOffset),
+      infos[cc].CompressedSize, /*save*/ 1);
+    band.Output->SetNumberOfComponents(numComps);
+    band.Output->SetArray(
+      output->GetPointer(band.Offset * numComps), band.NumberOfTuples * numComps, /*save*/ 1);
+    inOffset += infos[cc].CompressedSize;
+    outOffset += infos[cc].NumberOfTuples;
+  }
+
+  this->Internals->Execute(/*decompress*/ true);
+
+  for (int cc = 0; cc < numBands; ++cc)
+  {
+    auto& band = bands[cc];
+    if (band.Status == VTK_ERROR)
+    {
+      return VTK_ERROR;
+    }
+    // some compressors (e.g. vtkZlibImageCompressor) may replace the output
+    // buffer instead of filling the one provided.
+    unsigned char* dest = output->GetPointer(band.Offset * numComps);
+    if (band.Output->GetPointer(0) != dest)
+    {
+      memcpy(dest, band.Output->GetPointer(0), band.NumberOfTuples * numComps);
+    }
+  }
+  return VTK_OK;
+}
+
 //-----------------------------------------------------------------------------
 void vtkImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
@@ -107,5 +338,6 @@ void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Input:          " << this->Input << endl
      << indent << "Output:         " << this->Output << endl
-     << indent << "LossLessMode: " << this->LossLessMode << endl;
+     << indent << "LossLessMode: " << this->LossLessMode << endl
+     << indent << "NumberOfBands: " << this->NumberOfBands << endl;
 }
@@ -24,6 +24,11 @@
  * the LossLessMode ivar, which is used by the composite manager to force
  * loss less compression during a still render. Additionally compressors
  * must be able to seriealize and restore their setting from a stream.
+ *
+ * Subclasses may also support band-parallel compression (see
+ * SetNumberOfBands()). In that mode, the image is split into horizontal bands
+ * that are compressed (and decompressed) concurrently using vtkSMPTools, each
+ * band by its own copy of the compressor.
 */
 
 #ifndef vtkImageCompressor_h
@@ -78,6 +83,20 @@ public:
    */
   virtual int Decompress() = 0;
 
+  //@{
+  /**
+   * Set the number of horizontal bands the image is split into for
+   * band-parallel compression. When greater than 1, subclasses that support it
+   * (vtkLZ4Compressor, vtkSquirtCompressor and vtkZlibImageCompressor) produce
+   * a multi-chunk stream where each band is compressed independently and
+   * concurrently. The same value must be used for decompression, but the
+   * number of bands actually used is read back from the stream. Default is 1
+   * i.e. the whole image is compressed as a single chunk.
+   */
+  vtkSetClampMacro(NumberOfBands, int, 1, 256);
+  vtkGetMacro(NumberOfBands, int);
+  //@}
+
   /**
    * Communicates the next expected image resolution.
    */
@@ -122,11 +141,26 @@ protected:
   vtkUnsignedCharArray* Input;
 
   int LossLessMode;
+  int NumberOfBands;
+
+  //@{
+  /**
+   * Band-parallel implementation of Compress() and Decompress() used by
+   * subclasses when NumberOfBands > 1. Each band is processed by a separate
+   * instance of the concrete compressor configured from this one, by calling
+   * its Compress() / Decompress() on a band of the Input / Output.
+   */
+  int CompressBands();
+  int DecompressBands();
+  //@}
 
   vtkSetStringMacro(Configuration);
   char* Configuration;
 
 private:
+  class vtkInternals;
+  vtkInternals* Internals;
+
   vtkImageCompressor(const vtkImageCompressor&) = delete;
   void operator=(const vtkImageCompressor&) = delete;
 };
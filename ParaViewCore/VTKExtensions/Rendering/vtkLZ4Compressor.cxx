@@ -43,6 +43,11 @@ int vtkLZ4Compressor::Compress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->CompressBands();
+  }
+
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -88,6 +93,11 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->DecompressBands();
+  }
+
   int maxDecompressedSize =
     this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
   int decompressedSize =
@@ -37,6 +37,7 @@
 #include "vtkHierarchicalBoxDataSet.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
@@ -51,10 +52,13 @@
 #include "vtkPVRecoverGeometryWireframe.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -71,8 +75,10 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <map>
 #include <math.h>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -174,6 +180,7 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->PassThroughCellIds = 1;
   this->PassThroughPointIds = 1;
+  this->UseThreadedSurfaceExtraction = false;
   this->ForceUseStrips = 0;
   this->StripModFirstPass = 1;
 
@@ -1367,6 +1374,355 @@ void vtkPVGeometryFilter::RectilinearGridExecute(vtkRectilinearGrid* input, vtkP
   output->CopyStructure(outline->GetOutput());
 }
 
+namespace
+{
+// Faces of the linear 3D cells, using the point ordering of the VTK cells so
+// that the face normals point outward.
+struct vtkPVGeometryFilterCellFaces
+{
+  int NumberOfFaces;
+  int FaceSizes[6];
+  int Faces[6][4];
+};
+
+const vtkPVGeometryFilterCellFaces* vtkPVGeometryFilterGetCellFaces(int cellType)
+{
+  static const vtkPVGeometryFilterCellFaces tetra = { 4, { 3, 3, 3, 3 },
+    { { 0, 1, 3 }, { 1, 2, 3 }, { 2, 0, 3 }, { 0, 2, 1 } } };
+  static const vtkPVGeometryFilterCellFaces voxel = { 6, { 4, 4, 4, 4, 4, 4 },
+    { { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 2, 3, 1 },
+      { 4, 5, 7, 6 } } };
+  static const vtkPVGeometryFilterCellFaces hexahedron = { 6, { 4, 4, 4, 4, 4, 4 },
+    { { 0, 4, 7, 3 }, { 1, 2, 6, 5 }, { 0, 1, 5, 4 }, { 3, 7, 6, 2 }, { 0, 3, 2, 1 },
+      { 4, 5, 6, 7 } } };
+  static const vtkPVGeometryFilterCellFaces wedge = { 5, { 3, 3, 4, 4, 4 },
+    { { 0, 1, 2 }, { 3, 5, 4 }, { 0, 3, 4, 1 }, { 1, 4, 5, 2 }, { 2, 5, 3, 0 } } };
+  static const vtkPVGeometryFilterCellFaces pyramid = { 5, { 4, 3, 3, 3, 3 },
+    { { 0, 3, 2, 1 }, { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 } } };
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      return &tetra;
+    case VTK_VOXEL:
+      return &voxel;
+    case VTK_HEXAHEDRON:
+      return &hexahedron;
+    case VTK_WEDGE:
+      return &wedge;
+    case VTK_PYRAMID:
+      return &pyramid;
+    default:
+      return nullptr;
+  }
+}
+
+// Faces are identified by their cell id and their index in the cell.
+inline vtkIdType vtkPVGeometryFilterFaceHandle(vtkIdType cellId, int face)
+{
+  return cellId * 8 + face;
+}
+
+// Returns the sorted point ids of a face, padded with -1, and the number of
+// points.
+int vtkPVGeometryFilterGetFaceKey(vtkUnstructuredGrid* input, vtkIdType handle, vtkIdType key[4])
+{
+  vtkIdType npts;
+  vtkIdType* pts;
+  input->GetCellPoints(handle / 8, npts, pts);
+  const vtkPVGeometryFilterCellFaces* faces =
+    vtkPVGeometryFilterGetCellFaces(input->GetCellType(handle / 8));
+  const int face = static_cast<int>(handle % 8);
+  const int size = faces->FaceSizes[face];
+  key[3] = -1;
+  for (int cc = 0; cc < size; ++cc)
+  {
+    key[cc] = pts[faces->Faces[face][cc]];
+  }
+  std::sort(key, key + size);
+  return size;
+}
+
+// Cells whose faces are never part of the surface.
+inline bool vtkPVGeometryFilterIsHiddenCell(const unsigned char* ghosts, vtkIdType cellId)
+{
+  return ghosts && (ghosts[cellId] & vtkDataSetAttributes::HIDDENCELL);
+}
+
+// Counts the faces of the cells per smallest point id.
+struct vtkPVGeometryFilterCountFaces
+{
+  vtkUnstructuredGrid* Input;
+  const unsigned char* Ghosts;
+  std::atomic<vtkIdType>* Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (vtkPVGeometryFilterIsHiddenCell(this->Ghosts, cellId))
+      {
+        continue;
+      }
+      vtkIdType npts;
+      vtkIdType* pts;
+      this->Input->GetCellPoints(cellId, npts, pts);
+      const vtkPVGeometryFilterCellFaces* faces =
+        vtkPVGeometryFilterGetCellFaces(this->Input->GetCellType(cellId));
+      for (int face = 0; face < faces->NumberOfFaces; ++face)
+      {
+        vtkIdType minId = pts[faces->Faces[face][0]];
+        for (int cc = 1; cc < faces->FaceSizes[face]; ++cc)
+        {
+          minId = std::min(minId, pts[faces->Faces[face][cc]]);
+        }
+        ++this->Counts[minId];
+      }
+    }
+  }
+};
+
+// Buckets the faces of the cells by smallest point id.
+struct vtkPVGeometryFilterBucketFaces
+{
+  vtkUnstructuredGrid* Input;
+  const unsigned char* Ghosts;
+  std::atomic<vtkIdType>* Cursors;
+  vtkIdType* Faces;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (vtkPVGeometryFilterIsHiddenCell(this->Ghosts, cellId))
+      {
+        continue;
+      }
+      vtkIdType npts;
+      vtkIdType* pts;
+      this->Input->GetCellPoints(cellId, npts, pts);
+      const vtkPVGeometryFilterCellFaces* faces =
+        vtkPVGeometryFilterGetCellFaces(this->Input->GetCellType(cellId));
+      for (int face = 0; face < faces->NumberOfFaces; ++face)
+      {
+        vtkIdType minId = pts[faces->Faces[face][0]];
+        for (int cc = 1; cc < faces->FaceSizes[face]; ++cc)
+        {
+          minId = std::min(minId, pts[faces->Faces[face][cc]]);
+        }
+        this->Faces[this->Cursors[minId]++] = vtkPVGeometryFilterFaceHandle(cellId, face);
+      }
+    }
+  }
+};
+
+// Finds the faces used by a single cell within each bucket and flags them in
+// the face mask of their cell.
+struct vtkPVGeometryFilterFindExternalFaces
+{
+  vtkUnstructuredGrid* Input;
+  const unsigned char* Ghosts;
+  const vtkIdType* Offsets;
+  const vtkIdType* Faces;
+  std::atomic<unsigned char>* FaceMasks;
+
+  struct FaceKey
+  {
+    vtkIdType Key[4];
+    vtkIdType Handle;
+    bool operator<(const FaceKey& other) const
+    {
+      return std::lexicographical_compare(this->Key, this->Key + 4, other.Key, other.Key + 4);
+    }
+    bool operator==(const FaceKey& other) const
+    {
+      return std::equal(this->Key, this->Key + 4, other.Key);
+    }
+  };
+  vtkSMPThreadLocal<std::vector<FaceKey> > Keys;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<FaceKey>& keys = this->Keys.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType first = this->Offsets[ptId];
+      const vtkIdType last = this->Offsets[ptId + 1];
+      keys.resize(static_cast<size_t>(last - first));
+      for (vtkIdType cc = first; cc < last; ++cc)
+      {
+        FaceKey& key = keys[cc - first];
+        key.Handle = this->Faces[cc];
+        vtkPVGeometryFilterGetFaceKey(this->Input, key.Handle, key.Key);
+      }
+      std::sort(keys.begin(), keys.end());
+      for (size_t cc = 0; cc < keys.size();)
+      {
+        size_t next = cc + 1;
+        while (next < keys.size() && keys[next] == keys[cc])
+        {
+          ++next;
+        }
+        // faces of ghost cells only hide the matching faces of their
+        // neighbors.
+        const vtkIdType cellId = keys[cc].Handle / 8;
+        if (next == cc + 1 &&
+          !(this->Ghosts && (this->Ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)))
+        {
+          this->FaceMasks[cellId] |= static_cast<unsigned char>(1 << (keys[cc].Handle % 8));
+        }
+        cc = next;
+      }
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeometryFilter::ThreadedUnstructuredGridExecute(
+  vtkUnstructuredGrid* input, vtkPolyData* output)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numCells == 0 || numPts == 0)
+  {
+    return false;
+  }
+
+  vtkNew<vtkCellTypes> types;
+  input->GetCellTypes(types.Get());
+  for (vtkIdType cc = 0; cc < types->GetNumberOfTypes(); ++cc)
+  {
+    if (vtkPVGeometryFilterGetCellFaces(types->GetCellType(cc)) == nullptr)
+    {
+      return false;
+    }
+  }
+
+  vtkUnsignedCharArray* ghostArray = input->GetCellGhostArray();
+  const unsigned char* ghosts = ghostArray ? ghostArray->GetPointer(0) : nullptr;
+
+  // Bucket all the faces by their smallest point id, so that matching faces
+  // end up in the same bucket, then look for unmatched faces in each bucket.
+  std::unique_ptr<std::atomic<vtkIdType>[]> counts(new std::atomic<vtkIdType>[numPts]);
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    counts[cc] = 0;
+  }
+  vtkPVGeometryFilterCountFaces countFaces{ input, ghosts, counts.get() };
+  vtkSMPTools::For(0, numCells, countFaces);
+
+  std::vector<vtkIdType> offsets(numPts + 1);
+  offsets[0] = 0;
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    offsets[cc + 1] = offsets[cc] + counts[cc];
+    counts[cc] = offsets[cc];
+  }
+
+  std::vector<vtkIdType> faces(offsets[numPts]);
+  vtkPVGeometryFilterBucketFaces bucketFaces{ input, ghosts, counts.get(), faces.data() };
+  vtkSMPTools::For(0, numCells, bucketFaces);
+  counts.reset();
+  this->UpdateProgress(0.4);
+
+  std::unique_ptr<std::atomic<unsigned char>[]> faceMasks(
+    new std::atomic<unsigned char>[numCells]);
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    faceMasks[cc] = 0;
+  }
+  vtkPVGeometryFilterFindExternalFaces findFaces{ input, ghosts, offsets.data(), faces.data(),
+    faceMasks.get(), {} };
+  vtkSMPTools::For(0, numPts, findFaces);
+  faces = std::vector<vtkIdType>();
+  offsets = std::vector<vtkIdType>();
+  this->UpdateProgress(0.8);
+
+  // Build the output in cell order, keeping only the points used by the
+  // surface.
+  vtkPointData* inPD = input->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* outCD = output->GetCellData();
+  outPD->CopyGlobalIdsOn();
+  outPD->CopyAllocate(inPD);
+  outCD->CopyGlobalIdsOn();
+  outCD->CopyAllocate(inCD);
+
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  std::vector<vtkIdType> outPointIds;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdTypeArray> originalCellIds;
+  originalCellIds->SetName("vtkOriginalCellIds");
+  vtkIdType facePts[4];
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    const unsigned char mask = faceMasks[cellId];
+    if (mask == 0)
+    {
+      continue;
+    }
+    vtkIdType npts;
+    vtkIdType* pts;
+    input->GetCellPoints(cellId, npts, pts);
+    const vtkPVGeometryFilterCellFaces* cellFaces =
+      vtkPVGeometryFilterGetCellFaces(input->GetCellType(cellId));
+    for (int face = 0; face < cellFaces->NumberOfFaces; ++face)
+    {
+      if ((mask & (1 << face)) == 0)
+      {
+        continue;
+      }
+      const int size = cellFaces->FaceSizes[face];
+      for (int cc = 0; cc < size; ++cc)
+      {
+        vtkIdType& outId = pointMap[pts[cellFaces->Faces[face][cc]]];
+        if (outId < 0)
+        {
+          outId = static_cast<vtkIdType>(outPointIds.size());
+          outPointIds.push_back(pts[cellFaces->Faces[face][cc]]);
+        }
+        facePts[cc] = outId;
+      }
+      const vtkIdType outCellId = polys->InsertNextCell(size, facePts);
+      outCD->CopyData(inCD, cellId, outCellId);
+      if (this->PassThroughCellIds)
+      {
+        originalCellIds->InsertNextValue(cellId);
+      }
+    }
+  }
+
+  const vtkIdType numOutPts = static_cast<vtkIdType>(outPointIds.size());
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numOutPts);
+  vtkNew<vtkIdTypeArray> originalPointIds;
+  originalPointIds->SetName("vtkOriginalPointIds");
+  for (vtkIdType cc = 0; cc < numOutPts; ++cc)
+  {
+    points->SetPoint(cc, input->GetPoint(outPointIds[cc]));
+    outPD->CopyData(inPD, outPointIds[cc], cc);
+    if (this->PassThroughPointIds)
+    {
+      originalPointIds->InsertNextValue(outPointIds[cc]);
+    }
+  }
+
+  output->SetPoints(points.Get());
+  output->SetPolys(polys.Get());
+  if (this->PassThroughCellIds)
+  {
+    outCD->AddArray(originalCellIds.Get());
+  }
+  if (this->PassThroughPointIds)
+  {
+    outPD->AddArray(originalPointIds.Get());
+  }
+  output->Squeeze();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeometryFilter::UnstructuredGridExecute(
   vtkUnstructuredGridBase* input, vtkPolyData* output, int doCommunicate)
@@ -1456,7 +1812,13 @@ void vtkPVGeometryFilter::UnstructuredGridExecute(
       }
     }
 
-    if (input->GetNumberOfCells() > 0)
+    vtkUnstructuredGrid* ugInput = vtkUnstructuredGrid::SafeDownCast(input);
+    if (!handleSubdivision && this->UseThreadedSurfaceExtraction && ugInput &&
+      this->ThreadedUnstructuredGridExecute(ugInput, output))
+    {
+      vtkDebugMacro("Extracted the surface using the threaded path.");
+    }
+    else if (input->GetNumberOfCells() > 0)
     {
       this->DataSetSurfaceFilter->UnstructuredGridExecute(input, output);
     }
@@ -1736,6 +2098,8 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "UseThreadedSurfaceExtraction: "
+     << (this->UseThreadedSurfaceExtraction ? "On\n" : "Off\n");
 }
 
 //----------------------------------------------------------------------------
@@ -42,6 +42,7 @@ class vtkPolyData;
 class vtkPVRecoverGeometryWireframe;
 class vtkRectilinearGrid;
 class vtkStructuredGrid;
+class vtkUnstructuredGrid;
 class vtkUnstructuredGridBase;
 class vtkUnstructuredGridGeometryFilter;
 class vtkAMRBox;
@@ -178,6 +179,20 @@ public:
   vtkBooleanMacro(GenerateProcessIds, bool);
   //@}
 
+  //@{
+  /**
+   * If on, the surface of unstructured grids made only of linear 3D cells
+   * (tetrahedra, hexahedra, voxels, wedges and pyramids) is extracted using
+   * multiple threads rather than vtkDataSetSurfaceFilter. Other unstructured
+   * grids always use vtkDataSetSurfaceFilter. The surface is the same, but
+   * its faces and points are ordered by cell rather than in the order of
+   * vtkDataSetSurfaceFilter. The default is off.
+   */
+  vtkSetMacro(UseThreadedSurfaceExtraction, bool);
+  vtkGetMacro(UseThreadedSurfaceExtraction, bool);
+  vtkBooleanMacro(UseThreadedSurfaceExtraction, bool);
+  //@}
+
   //@{
   /**
    * This property affects the way AMR outlines and faces are generated.
@@ -266,6 +281,13 @@ protected:
   void UnstructuredGridExecute(
     vtkUnstructuredGridBase* input, vtkPolyData* output, int doCommunicate);
 
+  /**
+   * Multithreaded external faces extraction for unstructured grids of linear
+   * 3D cells. Returns false, without changing the output, if the input
+   * contains other cells.
+   */
+  bool ThreadedUnstructuredGridExecute(vtkUnstructuredGrid* input, vtkPolyData* output);
+
   void PolyDataExecute(vtkPolyData* input, vtkPolyData* output, int doCommunicate);
 
   void HyperTreeGridExecute(vtkHyperTreeGrid* input, vtkPolyData* output, int doCommunicate);
@@ -321,6 +343,7 @@ protected:
   bool GenerateProcessIds;
   int PassThroughCellIds;
   int PassThroughPointIds;
+  bool UseThreadedSurfaceExtraction;
   int ForceUseStrips;
   vtkTimeStamp StripSettingMTime;
   int StripModFirstPass;
@@ -0,0 +1,643 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVQuadricClustering.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVQuadricClustering.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Returns the dimension of the cells of a vtkPolyData, or -1 for cells that are
+// ignored.
+int vtkPVQuadricClusteringGetDimension(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+      return 0;
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+      return 1;
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_PIXEL:
+    case VTK_POLYGON:
+    case VTK_TRIANGLE_STRIP:
+      return 2;
+    default:
+      return -1;
+  }
+}
+
+// Calls `f` for each triangle of a 2D cell, keeping the orientation of the
+// cell.
+template <typename FunctorT>
+void vtkPVQuadricClusteringForEachTriangle(
+  int cellType, vtkIdType npts, const vtkIdType* pts, FunctorT& f)
+{
+  if (cellType == VTK_TRIANGLE_STRIP)
+  {
+    for (vtkIdType cc = 0; cc + 2 < npts; ++cc)
+    {
+      if (cc % 2 == 0)
+      {
+        f(pts[cc], pts[cc + 1], pts[cc + 2]);
+      }
+      else
+      {
+        f(pts[cc + 1], pts[cc], pts[cc + 2]);
+      }
+    }
+  }
+  else if (cellType == VTK_PIXEL && npts == 4)
+  {
+    f(pts[0], pts[1], pts[3]);
+    f(pts[0], pts[3], pts[2]);
+  }
+  else
+  {
+    for (vtkIdType cc = 1; cc + 1 < npts; ++cc)
+    {
+      f(pts[0], pts[cc], pts[cc + 1]);
+    }
+  }
+}
+
+// Adds the quadric of the plane of a triangle, weighted by its area, to `q`.
+// Quadrics are stored as the upper half of the symmetric 4x4 matrix.
+void vtkPVQuadricClusteringAddQuadric(
+  const double p0[3], const double p1[3], const double p2[3], double q[10])
+{
+  double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+  double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+  double n[3];
+  vtkMath::Cross(e1, e2, n);
+  const double length = vtkMath::Norm(n);
+  if (length == 0.0)
+  {
+    return;
+  }
+  const double area = 0.5 * length;
+  const double a = n[0] / length;
+  const double b = n[1] / length;
+  const double c = n[2] / length;
+  const double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+  q[0] += area * a * a;
+  q[1] += area * a * b;
+  q[2] += area * a * c;
+  q[3] += area * a * d;
+  q[4] += area * b * b;
+  q[5] += area * b * c;
+  q[6] += area * b * d;
+  q[7] += area * c * c;
+  q[8] += area * c * d;
+  q[9] += area * d * d;
+}
+
+double vtkPVQuadricClusteringEvaluate(const double q[10], const double x[3])
+{
+  return q[0] * x[0] * x[0] + 2 * q[1] * x[0] * x[1] + 2 * q[2] * x[0] * x[2] +
+    2 * q[3] * x[0] + q[4] * x[1] * x[1] + 2 * q[5] * x[1] * x[2] + 2 * q[6] * x[1] +
+    q[7] * x[2] * x[2] + 2 * q[8] * x[2] + q[9];
+}
+
+typedef std::pair<vtkIdType, vtkIdType> vtkPVQuadricClusteringPair;
+
+// Computes the bounds of the points. Unlike vtkDataSet::GetBounds(), nothing is
+// cached in the input, which may be shared with other threads.
+struct vtkPVQuadricClusteringComputeBounds
+{
+  vtkPoints* Points;
+  vtkSMPThreadLocal<vtkBoundingBox> Bounds;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkBoundingBox& bounds = this->Bounds.Local();
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      bounds.AddPoint(x);
+    }
+  }
+
+  void GetBounds(double bounds[6])
+  {
+    vtkBoundingBox box;
+    for (auto iter = this->Bounds.begin(); iter != this->Bounds.end(); ++iter)
+    {
+      box.AddBox(*iter);
+    }
+    box.GetBounds(bounds);
+  }
+};
+
+// Computes the bin of each point, as (bin, point id) pairs.
+struct vtkPVQuadricClusteringBinPoints
+{
+  vtkPoints* Points;
+  double Origin[3];
+  double Scale[3];
+  int Divisions[3];
+  vtkPVQuadricClusteringPair* Bins;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      vtkIdType ijk[3];
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        const int index = static_cast<int>((x[cc] - this->Origin[cc]) * this->Scale[cc]);
+        ijk[cc] = std::min(std::max(index, 0), this->Divisions[cc] - 1);
+      }
+      this->Bins[ptId].first =
+        ijk[0] + this->Divisions[0] * (ijk[1] + this->Divisions[1] * ijk[2]);
+      this->Bins[ptId].second = ptId;
+    }
+  }
+};
+
+// Stores the index of the occupied bin of each point.
+struct vtkPVQuadricClusteringIndexPoints
+{
+  const vtkPVQuadricClusteringPair* Bins;
+  const vtkIdType* BinStarts;
+  vtkIdType* PointBins;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType bin = begin; bin < end; ++bin)
+    {
+      for (vtkIdType cc = this->BinStarts[bin]; cc < this->BinStarts[bin + 1]; ++cc)
+      {
+        this->PointBins[this->Bins[cc].second] = bin;
+      }
+    }
+  }
+};
+
+// Lists the bins touched by each 2D cell, as (bin, cell id) pairs.
+struct vtkPVQuadricClusteringCollectCells
+{
+  vtkPolyData* Input;
+  const vtkIdType* PointBins;
+  vtkSMPThreadLocal<std::vector<vtkPVQuadricClusteringPair> > Pairs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkPVQuadricClusteringPair>& pairs = this->Pairs.Local();
+    std::vector<vtkIdType> bins;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (vtkPVQuadricClusteringGetDimension(this->Input->GetCellType(cellId)) != 2)
+      {
+        continue;
+      }
+      vtkIdType npts;
+      vtkIdType* pts;
+      this->Input->GetCellPoints(cellId, npts, pts);
+      bins.resize(static_cast<size_t>(npts));
+      for (vtkIdType cc = 0; cc < npts; ++cc)
+      {
+        bins[cc] = this->PointBins[pts[cc]];
+      }
+      std::sort(bins.begin(), bins.end());
+      auto last = std::unique(bins.begin(), bins.end());
+      for (auto iter = bins.begin(); iter != last; ++iter)
+      {
+        pairs.push_back(vtkPVQuadricClusteringPair(*iter, cellId));
+      }
+    }
+  }
+};
+
+// Accumulates the quadric of each bin and picks the input point of the bin
+// that minimizes it.
+struct vtkPVQuadricClusteringChooseRepresentatives
+{
+  vtkPolyData* Input;
+  const vtkIdType* PointBins;
+  const vtkPVQuadricClusteringPair* Bins;
+  const vtkIdType* BinStarts;
+  const vtkPVQuadricClusteringPair* CellPairs;
+  vtkIdType NumberOfCellPairs;
+  vtkIdType* Representatives;
+
+  struct AddTriangle
+  {
+    vtkPoints* Points;
+    const vtkIdType* PointBins;
+    vtkIdType Bin;
+    double* Quadric;
+
+    void operator()(vtkIdType a, vtkIdType b, vtkIdType c)
+    {
+      if (this->PointBins[a] == this->Bin || this->PointBins[b] == this->Bin ||
+        this->PointBins[c] == this->Bin)
+      {
+        double p0[3], p1[3], p2[3];
+        this->Points->GetPoint(a, p0);
+        this->Points->GetPoint(b, p1);
+        this->Points->GetPoint(c, p2);
+        vtkPVQuadricClusteringAddQuadric(p0, p1, p2, this->Quadric);
+      }
+    }
+  };
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkPoints* points = this->Input->GetPoints();
+    const vtkPVQuadricClusteringPair* cellPairsEnd = this->CellPairs + this->NumberOfCellPairs;
+    for (vtkIdType bin = begin; bin < end; ++bin)
+    {
+      double quadric[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+      AddTriangle addTriangle = { points, this->PointBins, bin, quadric };
+      const vtkPVQuadricClusteringPair* first = std::lower_bound(
+        this->CellPairs, cellPairsEnd, vtkPVQuadricClusteringPair(bin, VTK_ID_MIN));
+      for (auto iter = first; iter != cellPairsEnd && iter->first == bin; ++iter)
+      {
+        vtkIdType npts;
+        vtkIdType* pts;
+        this->Input->GetCellPoints(iter->second, npts, pts);
+        vtkPVQuadricClusteringForEachTriangle(
+          this->Input->GetCellType(iter->second), npts, pts, addTriangle);
+      }
+
+      // The distance to the center of the bin breaks ties, e.g. in flat
+      // regions or in bins with vertices and lines only.
+      double center[3] = { 0, 0, 0 };
+      double x[3];
+      const vtkIdType binStart = this->BinStarts[bin];
+      const vtkIdType binEnd = this->BinStarts[bin + 1];
+      for (vtkIdType cc = binStart; cc < binEnd; ++cc)
+      {
+        points->GetPoint(this->Bins[cc].second, x);
+        vtkMath::Add(center, x, center);
+      }
+      vtkMath::MultiplyScalar(center, 1.0 / (binEnd - binStart));
+      const double weight = 1e-3 * (quadric[0] + quadric[4] + quadric[7]);
+
+      double bestError = VTK_DOUBLE_MAX;
+      double bestDistance = VTK_DOUBLE_MAX;
+      for (vtkIdType cc = binStart; cc < binEnd; ++cc)
+      {
+        points->GetPoint(this->Bins[cc].second, x);
+        const double distance = vtkMath::Distance2BetweenPoints(x, center);
+        const double error = vtkPVQuadricClusteringEvaluate(quadric, x) + weight * distance;
+        if (error < bestError || (error == bestError && distance < bestDistance))
+        {
+          bestError = error;
+          bestDistance = distance;
+          this->Representatives[bin] = this->Bins[cc].second;
+        }
+      }
+    }
+  }
+};
+
+// A cell of the output, given by the bins of its points.
+struct vtkPVQuadricClusteringCell
+{
+  int Dimension;
+  vtkIdType Key[3];
+  vtkIdType Bins[3];
+  vtkIdType CellId;
+  vtkIdType Sequence;
+
+  static bool SameKey(const vtkPVQuadricClusteringCell& a, const vtkPVQuadricClusteringCell& b)
+  {
+    return a.Dimension == b.Dimension && std::equal(a.Key, a.Key + 3, b.Key);
+  }
+
+  // Groups identical cells, the one coming first in the input first.
+  static bool LessKey(const vtkPVQuadricClusteringCell& a, const vtkPVQuadricClusteringCell& b)
+  {
+    if (a.Dimension != b.Dimension)
+    {
+      return a.Dimension < b.Dimension;
+    }
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (a.Key[cc] != b.Key[cc])
+      {
+        return a.Key[cc] < b.Key[cc];
+      }
+    }
+    return LessOrder(a, b);
+  }
+
+  // Verts, lines and polys, each in input order.
+  static bool LessOrder(const vtkPVQuadricClusteringCell& a, const vtkPVQuadricClusteringCell& b)
+  {
+    if (a.Dimension != b.Dimension)
+    {
+      return a.Dimension < b.Dimension;
+    }
+    return a.CellId != b.CellId ? a.CellId < b.CellId : a.Sequence < b.Sequence;
+  }
+};
+
+// Generates the cells that do not collapse.
+struct vtkPVQuadricClusteringEmitCells
+{
+  vtkPolyData* Input;
+  const vtkIdType* PointBins;
+  vtkSMPThreadLocal<std::vector<vtkPVQuadricClusteringCell> > Cells;
+
+  struct AddTriangle
+  {
+    const vtkIdType* PointBins;
+    std::vector<vtkPVQuadricClusteringCell>* Cells;
+    vtkIdType CellId;
+    vtkIdType Sequence;
+
+    void operator()(vtkIdType a, vtkIdType b, vtkIdType c)
+    {
+      vtkPVQuadricClusteringCell cell = { 2, { this->PointBins[a], this->PointBins[b],
+                                               this->PointBins[c] },
+        { this->PointBins[a], this->PointBins[b], this->PointBins[c] }, this->CellId,
+        this->Sequence++ };
+      std::sort(cell.Key, cell.Key + 3);
+      if (cell.Key[0] != cell.Key[1] && cell.Key[1] != cell.Key[2])
+      {
+        this->Cells->push_back(cell);
+      }
+    }
+  };
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkPVQuadricClusteringCell>& cells = this->Cells.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const int cellType = this->Input->GetCellType(cellId);
+      const int dimension = vtkPVQuadricClusteringGetDimension(cellType);
+      vtkIdType npts;
+      vtkIdType* pts;
+      this->Input->GetCellPoints(cellId, npts, pts);
+      if (dimension == 0)
+      {
+        for (vtkIdType cc = 0; cc < npts; ++cc)
+        {
+          const vtkIdType bin = this->PointBins[pts[cc]];
+          vtkPVQuadricClusteringCell cell = { 0, { bin, -1, -1 }, { bin, -1, -1 }, cellId, cc };
+          cells.push_back(cell);
+        }
+      }
+      else if (dimension == 1)
+      {
+        for (vtkIdType cc = 0; cc + 1 < npts; ++cc)
+        {
+          const vtkIdType bin0 = this->PointBins[pts[cc]];
+          const vtkIdType bin1 = this->PointBins[pts[cc + 1]];
+          if (bin0 != bin1)
+          {
+            vtkPVQuadricClusteringCell cell = { 1, { std::min(bin0, bin1), std::max(bin0, bin1),
+                                                     -1 },
+              { bin0, bin1, -1 }, cellId, cc };
+            cells.push_back(cell);
+          }
+        }
+      }
+      else if (dimension == 2)
+      {
+        AddTriangle addTriangle = { this->PointBins, &cells, cellId, 0 };
+        vtkPVQuadricClusteringForEachTriangle(cellType, npts, pts, addTriangle);
+      }
+    }
+  }
+};
+
+template <typename T>
+void vtkPVQuadricClusteringGather(vtkSMPThreadLocal<std::vector<T> >& local, std::vector<T>& result)
+{
+  size_t size = 0;
+  for (auto iter = local.begin(); iter != local.end(); ++iter)
+  {
+    size += iter->size();
+  }
+  result.reserve(size);
+  for (auto iter = local.begin(); iter != local.end(); ++iter)
+  {
+    result.insert(result.end(), iter->begin(), iter->end());
+  }
+}
+}
+
+vtkStandardNewMacro(vtkPVQuadricClustering);
+//----------------------------------------------------------------------------
+vtkPVQuadricClustering::vtkPVQuadricClustering()
+{
+  this->NumberOfDivisions[0] = this->NumberOfDivisions[1] = this->NumberOfDivisions[2] = 50;
+  this->CopyCellData = true;
+}
+
+//----------------------------------------------------------------------------
+vtkPVQuadricClustering::~vtkPVQuadricClustering()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkPVQuadricClustering::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0], 0);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numPts == 0 || numCells == 0)
+  {
+    return 1;
+  }
+  if (input->NeedToBuildCells())
+  {
+    input->BuildCells();
+  }
+
+  // bin the points.
+  vtkPVQuadricClusteringComputeBounds computeBounds;
+  computeBounds.Points = input->GetPoints();
+  vtkSMPTools::For(0, numPts, computeBounds);
+  double bounds[6];
+  computeBounds.GetBounds(bounds);
+  vtkPVQuadricClusteringBinPoints binPoints;
+  binPoints.Points = input->GetPoints();
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    binPoints.Divisions[cc] = std::max(this->NumberOfDivisions[cc], 1);
+    binPoints.Origin[cc] = bounds[2 * cc];
+    const double length = bounds[2 * cc + 1] - bounds[2 * cc];
+    binPoints.Scale[cc] = length > 0 ? binPoints.Divisions[cc] / length : 0.0;
+  }
+  std::vector<vtkPVQuadricClusteringPair> bins(static_cast<size_t>(numPts));
+  binPoints.Bins = bins.data();
+  vtkSMPTools::For(0, numPts, binPoints);
+  vtkSMPTools::Sort(bins.begin(), bins.end());
+  this->UpdateProgress(0.2);
+  if (this->GetAbortExecute())
+  {
+    return 1;
+  }
+
+  // number the occupied bins.
+  std::vector<vtkIdType> binStarts;
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    if (cc == 0 || bins[cc].first != bins[cc - 1].first)
+    {
+      binStarts.push_back(cc);
+    }
+  }
+  const vtkIdType numBins = static_cast<vtkIdType>(binStarts.size());
+  binStarts.push_back(numPts);
+
+  std::vector<vtkIdType> pointBins(static_cast<size_t>(numPts));
+  vtkPVQuadricClusteringIndexPoints indexPoints = { bins.data(), binStarts.data(),
+    pointBins.data() };
+  vtkSMPTools::For(0, numBins, indexPoints);
+
+  // find the cells contributing to the quadric of each bin.
+  vtkPVQuadricClusteringCollectCells collectCells;
+  collectCells.Input = input;
+  collectCells.PointBins = pointBins.data();
+  vtkSMPTools::For(0, numCells, collectCells);
+  std::vector<vtkPVQuadricClusteringPair> cellPairs;
+  vtkPVQuadricClusteringGather(collectCells.Pairs, cellPairs);
+  vtkSMPTools::Sort(cellPairs.begin(), cellPairs.end());
+  this->UpdateProgress(0.4);
+  if (this->GetAbortExecute())
+  {
+    return 1;
+  }
+
+  std::vector<vtkIdType> representatives(static_cast<size_t>(numBins));
+  vtkPVQuadricClusteringChooseRepresentatives choose = { input, pointBins.data(), bins.data(),
+    binStarts.data(), cellPairs.data(), static_cast<vtkIdType>(cellPairs.size()),
+    representatives.data() };
+  vtkSMPTools::For(0, numBins, choose);
+  std::vector<vtkPVQuadricClusteringPair>().swap(cellPairs);
+  std::vector<vtkPVQuadricClusteringPair>().swap(bins);
+  this->UpdateProgress(0.6);
+  if (this->GetAbortExecute())
+  {
+    return 1;
+  }
+
+  // generate the cells that do not collapse and remove duplicates.
+  vtkPVQuadricClusteringEmitCells emitCells;
+  emitCells.Input = input;
+  emitCells.PointBins = pointBins.data();
+  vtkSMPTools::For(0, numCells, emitCells);
+  std::vector<vtkPVQuadricClusteringCell> cells;
+  vtkPVQuadricClusteringGather(emitCells.Cells, cells);
+  vtkSMPTools::Sort(cells.begin(), cells.end(), vtkPVQuadricClusteringCell::LessKey);
+  cells.erase(std::unique(cells.begin(), cells.end(), vtkPVQuadricClusteringCell::SameKey),
+    cells.end());
+  vtkSMPTools::Sort(cells.begin(), cells.end(), vtkPVQuadricClusteringCell::LessOrder);
+  this->UpdateProgress(0.8);
+  if (this->GetAbortExecute())
+  {
+    return 1;
+  }
+
+  // build the output.
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outPD->CopyAllocate(inPD, numBins);
+  if (this->CopyCellData)
+  {
+    outCD->CopyAllocate(inCD, static_cast<vtkIdType>(cells.size()));
+  }
+
+  vtkNew<vtkPoints> newPoints;
+  newPoints->SetDataType(input->GetPoints()->GetDataType());
+  std::vector<vtkIdType> pointIds(static_cast<size_t>(numBins), -1);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkCellArray* cellArrays[3] = { verts.GetPointer(), lines.GetPointer(), polys.GetPointer() };
+  vtkIdType outCellId = 0;
+  for (const auto& cell : cells)
+  {
+    vtkIdType ids[3];
+    for (int cc = 0; cc <= cell.Dimension; ++cc)
+    {
+      vtkIdType& ptId = pointIds[cell.Bins[cc]];
+      if (ptId < 0)
+      {
+        const vtkIdType inPtId = representatives[cell.Bins[cc]];
+        double x[3];
+        input->GetPoint(inPtId, x);
+        ptId = newPoints->InsertNextPoint(x);
+        outPD->CopyData(inPD, inPtId, ptId);
+      }
+      ids[cc] = ptId;
+    }
+    cellArrays[cell.Dimension]->InsertNextCell(cell.Dimension + 1, ids);
+    if (this->CopyCellData)
+    {
+      outCD->CopyData(inCD, cell.CellId, outCellId);
+    }
+    ++outCellId;
+  }
+  outPD->Squeeze();
+
+  output->SetPoints(newPoints.GetPointer());
+  if (verts->GetNumberOfCells() > 0)
+  {
+    output->SetVerts(verts.GetPointer());
+  }
+  if (lines->GetNumberOfCells() > 0)
+  {
+    output->SetLines(lines.GetPointer());
+  }
+  if (polys->GetNumberOfCells() > 0)
+  {
+    output->SetPolys(polys.GetPointer());
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfDivisions: " << this->NumberOfDivisions[0] << ", "
+     << this->NumberOfDivisions[1] << ", " << this->NumberOfDivisions[2] << endl;
+  os << indent << "CopyCellData: " << this->CopyCellData << endl;
+}
@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVQuadricClustering.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVQuadricClustering
+ * @brief   multithreaded decimation of polygonal data by vertex clustering.
+ *
+ * vtkPVQuadricClustering reduces polygonal data the same way
+ * vtkQuadricClustering does when using input points: the bounds of the input
+ * points are divided in a regular grid of NumberOfDivisions bins, all the
+ * points in a bin are replaced by a single point of the input and cells that
+ * collapse are removed. The representative point of a bin is the input point that
+ * minimizes the error quadric accumulated from the triangles touching the
+ * bin.
+ *
+ * Unlike vtkQuadricClustering, only occupied bins are stored so that the cost
+ * does not depend on the number of divisions, and all the passes run using
+ * vtkSMPTools. The output does not depend on the number of threads.
+ *
+ * Vertices, lines, polygons and triangle strips are supported. Polygons and
+ * strips are output as triangles. Point data of the representative points
+ * and, if CopyCellData is on, cell data of the cells the output cells come
+ * from are passed.
+ *
+ * The filter checks AbortExecute between its passes, which makes it possible
+ * to cancel it from another thread.
+ */
+
+#ifndef vtkPVQuadricClustering_h
+#define vtkPVQuadricClustering_h
+
+#include "vtkPVVTKExtensionsRenderingModule.h" // needed for export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class VTKPVVTKEXTENSIONSRENDERING_EXPORT vtkPVQuadricClustering : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkPVQuadricClustering* New();
+  vtkTypeMacro(vtkPVQuadricClustering, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the number of bins along each axis. Default is 50x50x50.
+   */
+  vtkSetVector3Macro(NumberOfDivisions, int);
+  vtkGetVector3Macro(NumberOfDivisions, int);
+  //@}
+
+  //@{
+  /**
+   * When on, cell data is copied from the input cells to the output cells.
+   * On by default.
+   */
+  vtkSetMacro(CopyCellData, bool);
+  vtkGetMacro(CopyCellData, bool);
+  vtkBooleanMacro(CopyCellData, bool);
+  //@}
+
+protected:
+  vtkPVQuadricClustering();
+  ~vtkPVQuadricClustering() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int NumberOfDivisions[3];
+  bool CopyCellData;
+
+private:
+  vtkPVQuadricClustering(const vtkPVQuadricClustering&) = delete;
+  void operator=(const vtkPVQuadricClustering&) = delete;
+};
+
+#endif
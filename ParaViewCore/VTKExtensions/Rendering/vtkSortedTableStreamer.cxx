@@ -47,8 +47,15 @@
 #include "vtkMultiProcessController.h"
 #include "vtkUnsignedIntArray.h"
 
+#include <vtksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <queue>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include <float.h>
@@ -57,6 +64,28 @@
 #include <string>
 using std::ostringstream;
 
+namespace
+{
+// Default for vtkSortedTableStreamer::IndexMemoryLimit, in kibibytes.
+vtkIdType vtkSortedTableStreamerDefaultIndexMemoryLimit()
+{
+  if (const char* limit = vtksys::SystemTools::GetEnv("PV_SORTED_TABLE_INDEX_MEMORY_LIMIT"))
+  {
+    return static_cast<vtkIdType>(std::strtol(limit, nullptr, 10)) * 1024;
+  }
+  return 1024 * 1024;
+}
+
+bool vtkSortedTableStreamerSeek(FILE* file, vtkTypeInt64 offset)
+{
+#if defined(_WIN32)
+  return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+}
+
 //****************************************************************************
 class vtkSortedTableStreamer::InternalsBase
 {
@@ -65,6 +94,7 @@ public:
   virtual ~InternalsBase() {}
 
   virtual void SetSelectedComponent(int newValue) = 0;
+  virtual void SetIndexMemoryLimit(vtkIdType kibibytes) = 0;
   virtual void InvalidateCache() = 0;
   virtual int Extract(
     vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
@@ -440,6 +470,7 @@ public:
     ArraySorter()
     {
       this->Array = 0;
+      this->ArraySize = 0;
       this->Histo = 0;
     }
 
@@ -475,6 +506,24 @@ public:
       }
     }
 
+    // Value used to sort the tuple i, either a component or the magnitude
+    // when selectedComponent is negative.
+    static T GetSortValue(
+      const T* dataPtr, vtkIdType i, int numComponents, int selectedComponent)
+    {
+      if (selectedComponent < 0)
+      {
+        double value = 0;
+        for (int k = 0; k < numComponents; k++)
+        {
+          double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+          value += tmp * tmp;
+        }
+        return static_cast<T>(sqrt(value) / sqrt(static_cast<double>(numComponents)));
+      }
+      return dataPtr[selectedComponent + i * numComponents];
+    }
+
     void Update(T* dataPtr, vtkIdType numTuples, int numComponents, int selectedComponent,
       vtkIdType histogramSize, double* scalarRange, bool reverseOrder)
     {
@@ -497,25 +546,8 @@ public:
       for (vtkIdType i = 0; i < this->ArraySize; ++i)
       {
         this->Array[i].OriginalIndex = i;
-        double value = 0;
-        double tmp;
-        if (selectedComponent < 0)
-        {
-          // Compute magnitude
-          for (int k = 0; k < numComponents; k++)
-          {
-            tmp = static_cast<double>(dataPtr[k + i * numComponents]);
-            value += tmp * tmp;
-          }
-          value = sqrt(value) / sqrt(static_cast<double>(numComponents));
-          this->Array[i].Value = static_cast<T>(value);
-        }
-        else
-        {
-          this->Array[i].Value = dataPtr[selectedComponent + i * numComponents];
-          value = static_cast<double>(this->Array[i].Value);
-        }
-        this->Histo->AddValue(value);
+        this->Array[i].Value = GetSortValue(dataPtr, i, numComponents, selectedComponent);
+        this->Histo->AddValue(static_cast<double>(this->Array[i].Value));
       }
 
       // Sort it
@@ -562,13 +594,221 @@ public:
       }
     }
   };
+  class Splitter
+  {
+  public:
+    T Value;
+    int Process;
+    vtkIdType Position; // Position in the sorted array of Process
+  };
+  // Description:
+  // Global order of the rows: by value, then by process id, then by position
+  // in the sorted array of the process. Values and process ids are in
+  // descending order when the order is inverted.
+  class SplitterOrder
+  {
+  public:
+    SplitterOrder(bool inverted)
+      : Inverted(inverted)
+    {
+    }
+
+    bool IsValueBefore(const T& a, const T& b) const
+    {
+      return this->Inverted ? a > b : a < b;
+    }
+
+    bool IsProcessBefore(int a, int b) const { return this->Inverted ? a > b : a < b; }
+
+    bool operator()(const Splitter& a, const Splitter& b) const
+    {
+      if (this->IsValueBefore(a.Value, b.Value))
+      {
+        return true;
+      }
+      if (this->IsValueBefore(b.Value, a.Value))
+      {
+        return false;
+      }
+      if (a.Process != b.Process)
+      {
+        return this->IsProcessBefore(a.Process, b.Process);
+      }
+      return a.Position < b.Position;
+    }
+
+  private:
+    bool Inverted;
+  };
+  // Predicates to search a value in a sorted array
+  class Before
+  {
+  public:
+    Before(const T& value, bool inverted)
+      : Value(value)
+      , Inverted(inverted)
+    {
+    }
+    bool operator()(const SortableArrayItem& item) const
+    {
+      return this->Inverted ? item.Value > this->Value : item.Value < this->Value;
+    }
+
+  private:
+    T Value;
+    bool Inverted;
+  };
+  class NotAfter
+  {
+  public:
+    NotAfter(const T& value, bool inverted)
+      : Value(value)
+      , Inverted(inverted)
+    {
+    }
+    bool operator()(const SortableArrayItem& item) const
+    {
+      return this->Inverted ? !(item.Value < this->Value) : !(item.Value > this->Value);
+    }
+
+  private:
+    T Value;
+    bool Inverted;
+  };
+  // Description:
+  // Sorted values picked on all processes with their exact position in the
+  // global sorted order. The rows between two splitters are the only ones
+  // that need to be gathered to provide the rows between their positions.
+  class SplitterList
+  {
+  public:
+    std::vector<vtkIdType> GlobalRanks;  // Number of rows before each splitter
+    std::vector<vtkIdType> LocalOffsets; // Number of local rows before each splitter
+
+    void Clear()
+    {
+      this->GlobalRanks.clear();
+      this->LocalOffsets.clear();
+    }
+
+    // Narrow [localBegin, localEnd[ and [globalBegin, globalEnd[ to the
+    // splitters surrounding the global range [first, last[.
+    void Locate(vtkIdType first, vtkIdType last, vtkIdType& localBegin, vtkIdType& localEnd,
+      vtkIdType& globalBegin, vtkIdType& globalEnd) const
+    {
+      std::vector<vtkIdType>::const_iterator lower =
+        std::upper_bound(this->GlobalRanks.begin(), this->GlobalRanks.end(), first);
+      if (lower != this->GlobalRanks.begin())
+      {
+        --lower;
+        globalBegin = *lower;
+        localBegin = this->LocalOffsets[lower - this->GlobalRanks.begin()];
+      }
+      std::vector<vtkIdType>::const_iterator upper =
+        std::lower_bound(this->GlobalRanks.begin(), this->GlobalRanks.end(), last);
+      if (upper != this->GlobalRanks.end())
+      {
+        globalEnd = *upper;
+        localEnd = this->LocalOffsets[upper - this->GlobalRanks.begin()];
+      }
+    }
+  };
+  // Description:
+  // Access to the sorted items [Begin, End[ of an array or of a file. Those
+  // of a file are read by chunks of BufferSize items, so reading them in
+  // increasing order only reads each of them once.
+  class SortedItemStream
+  {
+  public:
+    SortedItemStream(const SortableArrayItem* items, FILE* file, vtkIdType begin, vtkIdType end,
+      vtkIdType bufferSize)
+      : Items(items)
+      , File(file)
+      , End(end)
+      , BufferSize(bufferSize)
+      , BufferBegin(begin)
+    {
+    }
+
+    // Returns the item at `index`, in [Begin, End[.
+    const SortableArrayItem& Get(vtkIdType index)
+    {
+      if (!this->File)
+      {
+        return this->Items[index];
+      }
+      if (index < this->BufferBegin ||
+        index >= this->BufferBegin + static_cast<vtkIdType>(this->Buffer.size()))
+      {
+        this->BufferBegin = index;
+        this->Buffer.resize(static_cast<size_t>(vtkMath::Min(this->BufferSize, this->End - index)));
+        const vtkTypeInt64 offset =
+          static_cast<vtkTypeInt64>(index) * static_cast<vtkTypeInt64>(sizeof(SortableArrayItem));
+        if (!vtkSortedTableStreamerSeek(this->File, offset) ||
+          fread(&this->Buffer[0], sizeof(SortableArrayItem), this->Buffer.size(), this->File) !=
+            this->Buffer.size())
+        {
+          cout << "ERROR vtkSortedTableStreamer failed to read the sorted index." << endl;
+          std::fill(this->Buffer.begin(), this->Buffer.end(), SortableArrayItem());
+        }
+      }
+      return this->Buffer[index - this->BufferBegin];
+    }
+
+    // Returns the first index in [index, End[ of an item for which `pred` is
+    // false, `pred` being true for a prefix of the items.
+    template <class Predicate>
+    vtkIdType Advance(vtkIdType index, const Predicate& pred)
+    {
+      if (!this->File)
+      {
+        return std::partition_point(this->Items + index, this->Items + this->End, pred) -
+          this->Items;
+      }
+      while (index < this->End && pred(this->Get(index)))
+      {
+        ++index;
+      }
+      return index;
+    }
+
+  private:
+    const SortableArrayItem* Items;
+    FILE* File;
+    vtkIdType End;
+    vtkIdType BufferSize;
+    vtkIdType BufferBegin;
+    std::vector<SortableArrayItem> Buffer;
+  };
+  // Description:
+  // Orders the items of the runs merged into the index file, the next item
+  // of the merge being on top.
+  class RunOrder
+  {
+  public:
+    typedef std::pair<SortableArrayItem, size_t> RunItem;
+
+    RunOrder(bool inverted)
+      : Inverted(inverted)
+    {
+    }
+    bool operator()(const RunItem& a, const RunItem& b) const
+    {
+      return this->Inverted ? SortableArrayItem::Ascendent(b.first, a.first)
+                            : SortableArrayItem::Descendent(b.first, a.first);
+    }
+
+  private:
+    bool Inverted;
+  };
 
 public:
   Internals()
   {
     // Only used for testing
     this->LocalSorter = 0;
-    this->GlobalHistogram = 0;
+    this->IndexFile = 0;
+    this->GlobalSize = 0;
     this->Debug = false;
   }
 
@@ -593,15 +833,16 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
+    this->IndexFile = 0;
+    this->IndexMemoryLimit = 0;
+    this->GlobalSize = 0;
   }
 
   ~Internals() override
   {
+    this->ReleaseIndex();
     if (this->LocalSorter)
       delete this->LocalSorter;
-    if (this->GlobalHistogram)
-      delete this->GlobalHistogram;
   }
 
   // --------------------------------------------------------------------------
@@ -672,9 +913,7 @@ public:
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
-
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    this->ReleaseIndex();
 
     // Is there something to sort ???
     if (!sortableArray)
@@ -685,44 +924,286 @@ public:
         this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
       }
     }
+    else if (this->DataToSort && this->IsIndexTooLarge(this->DataToSort->GetNumberOfTuples()) &&
+      this->SortToIndexFile(invertOrder))
+    {
+      // Sorted on disk
+    }
+    else if (this->DataToSort)
+    {
+      // Sort and build local histogram
+      this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
+        this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
+        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
+    }
     else
     {
-      if (this->DataToSort)
+      this->LocalSorter->Clear();
+      this->LocalSorter->ArraySize = 0;
+    }
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Number of sorted items held in memory when the index is on disk: the
+  // size of the runs sorted in memory and of the buffers used to read it.
+  vtkIdType GetIndexBufferSize() const
+  {
+    return vtkMath::Max(static_cast<vtkIdType>(1),
+      this->IndexMemoryLimit * 1024 / static_cast<vtkIdType>(sizeof(SortableArrayItem)));
+  }
+
+  // --------------------------------------------------------------------------
+  bool IsIndexTooLarge(vtkIdType numTuples) const
+  {
+    return this->IndexMemoryLimit > 0 &&
+      numTuples * static_cast<vtkIdType>(sizeof(SortableArrayItem)) / 1024 >
+      this->IndexMemoryLimit;
+  }
+
+  // --------------------------------------------------------------------------
+  // Sort the local rows into a temporary file without holding all of them in
+  // memory: runs of GetIndexBufferSize() items are sorted and written to a
+  // first file, then merged into the index file. Returns false, leaving the
+  // sort to be done in memory, if a file could not be written.
+  bool SortToIndexFile(bool invertOrder)
+  {
+    FILE* runs = tmpfile();
+    FILE* index = runs ? tmpfile() : 0;
+    if (!index)
+    {
+      if (runs)
       {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
+        fclose(runs);
       }
-      else
+      return false;
+    }
+
+    const T* dataPtr = static_cast<T*>(this->DataToSort->GetVoidPointer(0));
+    const vtkIdType numTuples = this->DataToSort->GetNumberOfTuples();
+    const int numComponents = this->DataToSort->GetNumberOfComponents();
+    const int selectedComponent =
+      (numComponents == 1 && this->SelectedComponent < 0) ? 0 : this->SelectedComponent;
+    const vtkIdType runSize = this->GetIndexBufferSize();
+    bool (*compare)(const SortableArrayItem&, const SortableArrayItem&) =
+      invertOrder ? SortableArrayItem::Ascendent : SortableArrayItem::Descendent;
+    this->LocalSorter->Clear();
+
+    // Sort the runs
+    std::vector<vtkIdType> runBegins;
+    bool written = true;
+    {
+      std::vector<SortableArrayItem> run;
+      for (vtkIdType begin = 0; begin < numTuples && written; begin += runSize)
       {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
+        const vtkIdType end = vtkMath::Min(begin + runSize, numTuples);
+        run.resize(static_cast<size_t>(end - begin));
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          run[i - begin].OriginalIndex = i;
+          run[i - begin].Value =
+            ArraySorter::GetSortValue(dataPtr, i, numComponents, selectedComponent);
+        }
+        std::sort(run.begin(), run.end(), compare);
+        runBegins.push_back(begin);
+        written = fwrite(&run[0], sizeof(SortableArrayItem), run.size(), runs) == run.size();
       }
+    }
+    runBegins.push_back(numTuples);
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+    // Merge them, the buffer being shared by the runs and the output
+    const size_t nbRuns = runBegins.size() - 1;
+    const vtkIdType chunkSize =
+      vtkMath::Max(static_cast<vtkIdType>(1), runSize / static_cast<vtkIdType>(nbRuns + 1));
+    typedef typename RunOrder::RunItem RunItem;
+    std::vector<SortedItemStream> streams;
+    std::vector<vtkIdType> cursors(runBegins.begin(), runBegins.end() - 1);
+    const RunOrder runOrder(invertOrder);
+    std::priority_queue<RunItem, std::vector<RunItem>, RunOrder> merge(runOrder);
+    for (size_t r = 0; r < nbRuns && written; ++r)
+    {
+      streams.push_back(SortedItemStream(0, runs, runBegins[r], runBegins[r + 1], chunkSize));
+      merge.push(RunItem(streams[r].Get(cursors[r]), r));
+    }
+    std::vector<SortableArrayItem> output;
+    output.reserve(static_cast<size_t>(chunkSize));
+    while (!merge.empty() && written)
+    {
+      const size_t r = merge.top().second;
+      output.push_back(merge.top().first);
+      merge.pop();
+      if (++cursors[r] < runBegins[r + 1])
+      {
+        merge.push(RunItem(streams[r].Get(cursors[r]), r));
+      }
+      if (static_cast<vtkIdType>(output.size()) == chunkSize || merge.empty())
+      {
+        written = fwrite(&output[0], sizeof(SortableArrayItem), output.size(), index) ==
+          output.size();
+        output.clear();
+      }
+    }
+    fclose(runs);
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    if (!written)
+    {
+      fclose(index);
+      return false;
+    }
+    this->IndexFile = index;
+    this->LocalSorter->ArraySize = numTuples;
+    return true;
+  }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+  // --------------------------------------------------------------------------
+  // Build the index used to locate the rows of any block: the global number
+  // of rows and splitters spaced so that a block only spans a few of them
+  // on each process.
+  void BuildIndex(vtkIdType blockSize, bool invertOrder)
+  {
+    vtkIdType localSize = this->LocalSorter->ArraySize;
+    this->MPI->AllReduce(&localSize, &this->GlobalSize, 1, vtkCommunicator::SUM_OP);
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    vtkIdType spacing = vtkMath::Max(static_cast<vtkIdType>(1), blockSize / this->NumProcs);
+    this->ComputeSplitters(0, localSize, spacing, invertOrder, this->Splitters);
+  }
+
+  // --------------------------------------------------------------------------
+  // Sample the local sorted items [begin, end[ every `spacing` items, share
+  // the samples between all processes and compute their exact global rank.
+  // The items are read in order, from the disk if the index has been written
+  // to it. Collective.
+  void ComputeSplitters(
+    vtkIdType begin, vtkIdType end, vtkIdType spacing, bool invertOrder, SplitterList& splitters)
+  {
+    splitters.Clear();
+    if (!this->LocalSorter->Array && !this->IndexFile)
+    {
+      end = begin;
+    }
+    SortedItemStream items(
+      this->LocalSorter->Array, this->IndexFile, begin, end, this->GetIndexBufferSize());
+
+    // Pick the local samples
+    const vtkIdType count = end - begin;
+    const vtkIdType maxSamples = vtkMath::Max(
+      static_cast<vtkIdType>(1), static_cast<vtkIdType>(MAX_SPLITTERS / this->NumProcs));
+    const vtkIdType nbSamples = vtkMath::Min(maxSamples, (count + spacing - 1) / spacing);
+    std::vector<T> sampleValues(nbSamples);
+    std::vector<vtkIdType> samplePositions(nbSamples);
+    for (vtkIdType i = 0; i < nbSamples; ++i)
+    {
+      vtkIdType position = begin + i * count / nbSamples;
+      sampleValues[i] = items.Get(position).Value;
+      samplePositions[i] = position;
+    }
+
+    // Share them with everybody
+    std::vector<vtkIdType> nbSamplesPerProcess(this->NumProcs);
+    this->MPI->AllGather(&nbSamples, &nbSamplesPerProcess[0], 1);
+    std::vector<vtkIdType> offsets(this->NumProcs, 0);
+    std::vector<vtkIdType> valueLengths(this->NumProcs);
+    std::vector<vtkIdType> valueOffsets(this->NumProcs);
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      offsets[pid] = pid == 0 ? 0 : offsets[pid - 1] + nbSamplesPerProcess[pid - 1];
+      valueLengths[pid] = nbSamplesPerProcess[pid] * static_cast<vtkIdType>(sizeof(T));
+      valueOffsets[pid] = offsets[pid] * static_cast<vtkIdType>(sizeof(T));
+    }
+    const vtkIdType nbSplitters =
+      offsets[this->NumProcs - 1] + nbSamplesPerProcess[this->NumProcs - 1];
+    if (nbSplitters == 0)
+    {
+      return;
+    }
+    std::vector<T> allValues(nbSplitters);
+    std::vector<vtkIdType> allPositions(nbSplitters);
+    T dummyValue = T();
+    vtkIdType dummyPosition = 0;
+    this->MPI->AllGatherV(
+      reinterpret_cast<const char*>(nbSamples ? &sampleValues[0] : &dummyValue),
+      reinterpret_cast<char*>(&allValues[0]), nbSamples * static_cast<vtkIdType>(sizeof(T)),
+      &valueLengths[0], &valueOffsets[0]);
+    this->MPI->AllGatherV(nbSamples ? &samplePositions[0] : &dummyPosition, &allPositions[0],
+      nbSamples, &nbSamplesPerProcess[0], &offsets[0]);
+
+    // Sort them in the global order: by value, then by process id, then by
+    // position in the sorted array of the process.
+    std::vector<Splitter> candidates(nbSplitters);
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      for (vtkIdType i = offsets[pid], last = offsets[pid] + nbSamplesPerProcess[pid]; i < last;
+           ++i)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        candidates[i].Value = allValues[i];
+        candidates[i].Process = pid;
+        candidates[i].Position = allPositions[i];
       }
     }
+    SplitterOrder order(invertOrder);
+    std::sort(candidates.begin(), candidates.end(), order);
 
-    delete[] bufferHistogramValues;
-    return 1;
+    // Count the local items placed before each of them and sum it up. As
+    // the splitters are in the global order, these counts never decrease and
+    // the local items are read once.
+    std::vector<vtkIdType> localOffsets(nbSplitters);
+    vtkIdType bound = begin;
+    for (vtkIdType i = 0; i < nbSplitters; ++i)
+    {
+      const Splitter& splitter = candidates[i];
+      if (splitter.Process == this->Me)
+      {
+        bound = splitter.Position;
+      }
+      else if (order.IsProcessBefore(this->Me, splitter.Process))
+      {
+        bound = items.Advance(bound, NotAfter(splitter.Value, invertOrder));
+      }
+      else
+      {
+        bound = items.Advance(bound, Before(splitter.Value, invertOrder));
+      }
+      localOffsets[i] = bound;
+    }
+    splitters.LocalOffsets = localOffsets;
+    splitters.GlobalRanks.resize(nbSplitters);
+    this->MPI->AllReduce(
+      &localOffsets[0], &splitters.GlobalRanks[0], nbSplitters, vtkCommunicator::SUM_OP);
+  }
+
+  // --------------------------------------------------------------------------
+  void ReleaseIndex()
+  {
+    if (this->IndexFile)
+    {
+      fclose(this->IndexFile);
+      this->IndexFile = 0;
+    }
+    this->Splitters.Clear();
+    this->GlobalSize = 0;
+  }
+
+  // --------------------------------------------------------------------------
+  // Returns the local sorted items [begin, end[, read from the disk if the
+  // index has been written to it. `buffer` is used to store them in that case.
+  const SortableArrayItem* GetSortedItems(
+    vtkIdType begin, vtkIdType end, std::vector<SortableArrayItem>& buffer)
+  {
+    if (!this->IndexFile || end <= begin)
+    {
+      return this->LocalSorter->Array ? this->LocalSorter->Array + begin : 0;
+    }
+    buffer.resize(static_cast<size_t>(end - begin));
+    const vtkTypeInt64 offset =
+      static_cast<vtkTypeInt64>(begin) * static_cast<vtkTypeInt64>(sizeof(SortableArrayItem));
+    if (!vtkSortedTableStreamerSeek(this->IndexFile, offset) ||
+      fread(&buffer[0], sizeof(SortableArrayItem), buffer.size(), this->IndexFile) != buffer.size())
+    {
+      cout << "ERROR vtkSortedTableStreamer failed to read the sorted index." << endl;
+      buffer.clear();
+      return 0;
+    }
+    return &buffer[0];
   }
 
   // --------------------------------------------------------------------------
@@ -865,194 +1346,188 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    //    This will sort the local array and build the index, that's why we
+    //    don't want to do it at each execution. Specially when we only change
+    //    the requested block.
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
       this->BuildCache(true, revertOrder);
+      this->BuildIndex(blockSize, revertOrder);
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
-    // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
+    // Search the local rows of the requested block
+    //    The splitters surrounding the block give a local range on each
+    //    process. If it is too large, the range is split again.
     // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    const vtkIdType first = vtkMath::Min(block * blockSize, this->GlobalSize);
+    const vtkIdType last = vtkMath::Min(first + blockSize, this->GlobalSize);
+    vtkIdType localBegin = 0;
+    vtkIdType localEnd = this->LocalSorter->ArraySize;
+    vtkIdType globalBegin = 0;
+    vtkIdType globalEnd = this->GlobalSize;
+    std::vector<SortableArrayItem> buffer;
+    const SortableArrayItem* items = 0;
+    if (first < last)
+    {
+      this->Splitters.Locate(first, last, localBegin, localEnd, globalBegin, globalEnd);
+
+      const vtkIdType spacing =
+        vtkMath::Max(static_cast<vtkIdType>(1), blockSize / this->NumProcs);
+      while (globalEnd - globalBegin > 4 * blockSize)
+      {
+        SplitterList splitters;
+        this->ComputeSplitters(localBegin, localEnd, spacing, revertOrder, splitters);
+
+        const vtkIdType previousSize = globalEnd - globalBegin;
+        splitters.Locate(first, last, localBegin, localEnd, globalBegin, globalEnd);
+        if (globalEnd - globalBegin >= previousSize)
+        {
+          break;
+        }
+      }
+    }
+    else
+    {
+      localEnd = localBegin;
+      globalBegin = first;
+    }
 
     // ------------------------------------------------------------------------
     // Build local subset table
     // ------------------------------------------------------------------------
+    items = this->GetSortedItems(localBegin, localEnd, buffer);
     vtkSmartPointer<vtkTable> localSubset;
     localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
+      this->NewSubsetTable(input, items, items ? localEnd - localBegin : 0));
 
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
     // ------------------------------------------------------------------------
     int mergePid = GetMergingProcessId(localSubset.GetPointer());
 
-    // ------------------------------------------------------------------------
-    // Add local meta-data in case of merge process
-    // ------------------------------------------------------------------------
-    if (this->NumProcs > 1 && this->Me == mergePid)
-    {
-      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
-      processIdArray->SetName("vtkOriginalProcessIds");
-      processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
-      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
-      {
-        processIdArray->InsertNextTuple1(mergePid);
-      }
-      localSubset->GetRowData()->AddArray(processIdArray);
-    }
-
     // ------------------------------------------------------------------------
     // Send local subset array to process mergePid
     // ------------------------------------------------------------------------
     if (this->Me != mergePid)
     {
       this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+
+      // Ask other processes to provide metadata for table decoration
+      this->DecorateTable(input, NULL, mergePid);
+      return 1;
     }
 
     // ------------------------------------------------------------------------
     // Merging procedure only on process mergePid
+    //    Pieces are appended in the order of the process ids so that a stable
+    //    sort on the values gives the global order.
     // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    std::vector<vtkSmartPointer<vtkTable> > pieces(this->NumProcs);
+    pieces[this->Me] = localSubset;
+    for (int i = 0; i < this->NumProcs; i++)
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
-      for (int i = 0; i < this->NumProcs; i++)
-      {
-        if (i == mergePid)
-          continue;
+      if (i == mergePid)
+        continue;
 
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
-      }
+      pieces[i] = vtkSmartPointer<vtkTable>::New();
+      this->MPI->Receive(pieces[i].GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
+    }
 
-      // Sort new table/array
-      if (!this->DataToSort)
+    vtkSmartPointer<vtkTable> mergedSubset = vtkSmartPointer<vtkTable>::New();
+    vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    processIdArray->SetName("vtkOriginalProcessIds");
+    processIdArray->SetNumberOfComponents(1);
+    processIdArray->Allocate(globalEnd - globalBegin);
+    for (int i = 0; i < this->NumProcs; i++)
+    {
+      int pid = revertOrder ? this->NumProcs - 1 - i : i;
+      this->MergeTable(-1, pieces[pid].GetPointer(), mergedSubset.GetPointer(),
+        globalEnd - globalBegin);
+      for (vtkIdType idx = 0; idx < pieces[pid]->GetNumberOfRows(); idx++)
       {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        processIdArray->InsertNextTuple1(pid);
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
+      pieces[pid] = NULL;
+    }
+    if (this->NumProcs > 1)
+    {
+      mergedSubset->GetRowData()->AddArray(processIdArray);
+    }
 
-      if (!subsetArray)
+    // Sort new table/array
+    vtkDataArray* subsetArray = this->DataToSort
+      ? vtkDataArray::SafeDownCast(mergedSubset->GetColumnByName(this->DataToSort->GetName()))
+      : NULL;
+    ArraySorter sorter;
+    sorter.FillArray(mergedSubset->GetNumberOfRows());
+    if (subsetArray)
+    {
+      const T* dataPtr = static_cast<T*>(subsetArray->GetVoidPointer(0));
+      const int numComponents = subsetArray->GetNumberOfComponents();
+      const int selectedComponent =
+        (numComponents == 1 && this->SelectedComponent < 0) ? 0 : this->SelectedComponent;
+      for (vtkIdType idx = 0; idx < sorter.ArraySize; ++idx)
       {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
+        sorter.Array[idx].Value =
+          ArraySorter::GetSortValue(dataPtr, idx, numComponents, selectedComponent);
       }
-
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
-
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
-
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
+      SplitterOrder order(revertOrder);
+      std::stable_sort(sorter.Array, sorter.Array + sorter.ArraySize,
+        [&order](const SortableArrayItem& a, const SortableArrayItem& b) {
+          return order.IsValueBefore(a.Value, b.Value);
+        });
     }
-    else
+    else if (mergedSubset->GetNumberOfRows() > 0)
     {
-      // Ask other processes to provide metadata for table decoration
-      this->DecorateTable(input, NULL, mergePid);
+      vtkSortedTableStreamer::PrintInfo(mergedSubset.GetPointer());
     }
 
+    // trim it (remove head and tail that don't belong to the result)
+    localSubset.TakeReference(this->NewSubsetTable(
+      mergedSubset.GetPointer(), &sorter, first - globalBegin, last - first));
+
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), mergePid);
+
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
     return 1;
   }
 
   // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
+  static vtkTable* NewSubsetTable(
+    vtkTable* srcTable, const SortableArrayItem* items, vtkIdType size)
   {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
+    vtkTable* subTable = vtkTable::New();
 
-    do
+    // Loop on all column of the table
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
 
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
+      vtkAbstractArray* subArray = srcArray->NewInstance();
+      subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      subArray->SetName(srcArray->GetName());
+      subArray->Allocate(size * srcArray->GetNumberOfComponents());
+      if (auto sinfo = srcArray->GetInformation())
       {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
+        subArray->CopyInformation(sinfo);
       }
-
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
+      for (vtkIdType idx = 0; idx < size; ++idx)
       {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        if (subArray->InsertNextTuple(items[idx].OriginalIndex, srcArray) == -1)
+        {
+          cout << "ERROR NewSubsetTable::InsertNextTuple is not working." << endl;
+        }
       }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
+      subTable->GetRowData()->AddArray(subArray);
+      subArray->FastDelete();
+    }
 
-    delete[] bufferHistogramValues;
+    // Return the new subset vtkTable
+    return subTable;
   }
 
   // --------------------------------------------------------------------------
@@ -1117,6 +1592,9 @@ public:
     }
   }
 
+  // --------------------------------------------------------------------------
+  void SetIndexMemoryLimit(vtkIdType kibibytes) override { this->IndexMemoryLimit = kibibytes; }
+
   // --------------------------------------------------------------------------
   void InvalidateCache() override { this->NeedToBuildCache = true; }
 
@@ -1321,7 +1799,10 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
+  SplitterList Splitters;     // Global position of some of the sorted values
+  vtkIdType GlobalSize;       // Number of rows across processes
+  FILE* IndexFile;            // Local sorted array when written to disk
+  vtkIdType IndexMemoryLimit; // Size above which the index is sorted on disk
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
@@ -1338,6 +1819,9 @@ private:
   // Maybe make some test on huge cluster to see which histogram size is
   // the best.
   const static int HISTOGRAM_SIZE = 256;
+  // Maximum number of splitters, to bound the memory used by the index
+  // and the communications needed to build it.
+  const static int MAX_SPLITTERS = 1 << 18;
 };
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
@@ -1354,6 +1838,8 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->BlockSize = 1024;
   this->Internal = 0;
   this->SelectedComponent = 0;
+  this->IndexMemoryLimit = vtkSortedTableStreamerDefaultIndexMemoryLimit();
+  this->MergedInputMTime = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -1391,8 +1877,13 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool orderInverted = this->InvertOrder > 0;
 
-  // Convert a composite dataset into a vtkTable input.
-  if (!input)
+  // Convert a composite dataset into a vtkTable input. The merged table is
+  // kept so that the sorted index remains valid when only the block changes.
+  if (!input && this->MergedInput && this->MergedInputMTime == inputDO->GetMTime())
+  {
+    input = this->MergedInput;
+  }
+  else if (!input)
   {
     vtkSmartPointer<vtkCompositeDataSet> inputCompositeDS =
       vtkCompositeDataSet::SafeDownCast(inputDO);
@@ -1470,6 +1961,13 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
       }
     }
     iter->Delete();
+
+    this->MergedInput = input;
+    this->MergedInputMTime = inputDO->GetMTime();
+  }
+  else
+  {
+    this->MergedInput = NULL;
   }
 
   // Get input data
@@ -1497,6 +1995,7 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   int realComponent =
     (!arrayToProcess) ? 0 : this->GetSelectedComponent() % arrayToProcess->GetNumberOfComponents();
   this->Internal->SetSelectedComponent(realComponent);
+  this->Internal->SetIndexMemoryLimit(this->IndexMemoryLimit);
 
   // Manage custom case where sorting occur on a virtual array (process id)
   if (!this->Internal->IsSortable() ||
@@ -1518,6 +2017,7 @@ void vtkSortedTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Sorting column: " << (this->ColumnToSort ? this->ColumnToSort : "(none)")
      << endl;
+  os << indent << "IndexMemoryLimit: " << this->IndexMemoryLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1528,8 +2028,12 @@ const char* vtkSortedTableStreamer::GetColumnNameToSort()
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 {
+  // Keep the sorted index when the same column is set again
+  bool changed = (columnName == NULL) != (this->ColumnToSort == NULL) ||
+    (columnName && strcmp(columnName, this->ColumnToSort) != 0);
   this->SetColumnToSort(columnName);
-  if (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0)
+  if (changed && this->GetColumnToSort() &&
+    strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0)
   {
     if (this->Internal)
     {
@@ -20,12 +20,22 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * Each process sorts its rows once per column to sort and builds an index
+ * giving the global position of some of the sorted values. Requesting
+ * another block only gathers the rows around that block, so the index is
+ * reused while scrolling as long as the input, the column, the component and
+ * the order stay the same. When the local sorted index is larger than
+ * IndexMemoryLimit, it is sorted by runs of that size which are merged into
+ * a temporary file, so that it is never held in memory as a whole, and only
+ * the rows of the requested block are read back.
 */
 
 #ifndef vtkSortedTableStreamer_h
 #define vtkSortedTableStreamer_h
 
 #include "vtkPVVTKExtensionsRenderingModule.h" // needed for export macro
+#include "vtkSmartPointer.h" // for vtkSmartPointer
 #include "vtkTableAlgorithm.h"
 class vtkTable;
 class vtkDataArray;
@@ -101,6 +111,19 @@ public:
   void SetInvertOrder(int newValue);
   vtkGetMacro(InvertOrder, int);
 
+  //@{
+  /**
+   * Size, in kibibytes, above which the local sorted index is built in a
+   * temporary file instead of in memory, using about that much memory to
+   * sort and read it. 0 keeps it in memory.
+   * Defaults to the value, in MiB, of the PV_SORTED_TABLE_INDEX_MEMORY_LIMIT
+   * environment variable, or to 1 GiB. Changes apply the next time the
+   * index is built.
+   */
+  vtkSetMacro(IndexMemoryLimit, vtkIdType);
+  vtkGetMacro(IndexMemoryLimit, vtkIdType);
+  //@}
+
 protected:
   vtkSortedTableStreamer();
   ~vtkSortedTableStreamer() override;
@@ -125,6 +148,11 @@ protected:
   char* ColumnToSort;
   int SelectedComponent;
   int InvertOrder;
+  vtkIdType IndexMemoryLimit;
+
+  // Table merged from a composite input, with the MTime of that input
+  vtkSmartPointer<vtkTable> MergedInput;
+  vtkMTimeType MergedInputMTime;
 
 private:
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
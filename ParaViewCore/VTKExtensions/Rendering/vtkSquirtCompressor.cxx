@@ -45,6 +45,11 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->CompressBands();
+  }
+
   vtkUnsignedCharArray* input = this->GetInput();
 
   if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
@@ -185,6 +190,11 @@ int vtkSquirtCompressor::Decompress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->DecompressBands();
+  }
+
   vtkUnsignedCharArray* out = this->GetOutput();
 
   // We assume that 'out' has exactly the same number of component set as the
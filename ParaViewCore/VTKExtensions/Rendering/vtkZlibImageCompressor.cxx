@@ -343,6 +343,11 @@ int vtkZlibImageCompressor::Compress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->CompressBands();
+  }
+
   // Reduce color space and strip alpha if requested.
   unsigned char* inImage;
   int freeInImage;
@@ -381,6 +386,11 @@ int vtkZlibImageCompressor::Decompress()
     return VTK_ERROR;
   }
 
+  if (this->NumberOfBands > 1)
+  {
+    return this->DecompressBands();
+  }
+
   // size input.
   unsigned char* compIm = this->Input->GetPointer(1);
   const vtkIdType compImSize = this->Input->GetNumberOfTuples() - 1;
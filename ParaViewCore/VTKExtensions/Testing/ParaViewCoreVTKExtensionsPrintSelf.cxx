@@ -34,6 +34,7 @@
 #include "vtkCleanUnstructuredGrid.h"
 #include "vtkCompositeDataToUnstructuredGridFilter.h"
 #include "vtkDataSetToRectilinearGrid.h"
+#include "vtkDeltaImageCompressor.h"
 //#include "vtkEnzoReader.h"
 #include "vtkEquivalenceSet.h"
 #include "vtkExodusFileSeriesReader.h"
@@ -214,6 +215,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char* [])
   PRINT_SELF(vtkCSVExporter);
   PRINT_SELF(vtkCSVWriter);
   PRINT_SELF(vtkDataSetToRectilinearGrid);
+  PRINT_SELF(vtkDeltaImageCompressor);
   // PRINT_SELF(vtkEnzoReader);
   PRINT_SELF(vtkEquivalenceSet);
   PRINT_SELF(vtkExodusFileSeriesReader);
@@ -92,5 +92,30 @@ int TestExtractHistogram(int, char* [])
     vtkGenericWarningMacro("incorrect bin value.");
     return 1;
   }
+  if (extraction->GetOutputIsEstimate())
+  {
+    vtkGenericWarningMacro("exact histogram reported as an estimate.");
+    return 1;
+  }
+
+  // Sampled histograms are estimates of all the values.
+  extraction->SetSampleSize(10);
+  extraction->Update();
+  bin_values = vtkIntArray::SafeDownCast(extraction->GetOutput()->GetRowData()->GetArray(1));
+  if (!extraction->GetOutputIsEstimate())
+  {
+    vtkGenericWarningMacro("sampled histogram not reported as an estimate.");
+    return 1;
+  }
+  int total = 0;
+  for (int i = 0; i < bin_count; ++i)
+  {
+    total += bin_values->GetValue(i);
+  }
+  if (total < 45 || total > 55)
+  {
+    vtkGenericWarningMacro("incorrect sampled bin values.");
+    return 1;
+  }
   return 0;
 }
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotDecodeInParallel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the cell fields of a SpyPlot file decoded with DecodeInParallel
+// are the same as when each plane is decoded as soon as it is read, for float
+// fields as well as for down converted volume fractions.
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkNew.h"
+#include "vtkSpyPlotUniReader.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <string>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return -1;                                                                                     \
+  }
+
+namespace
+{
+bool Open(vtkSpyPlotUniReader* reader, vtkDataArraySelection* selection, const std::string& fname,
+  bool decodeInParallel)
+{
+  reader->SetFileName(fname.c_str());
+  reader->SetCellArraySelection(selection);
+  reader->SetDecodeInParallel(decodeInParallel ? 1 : 0);
+  if (!reader->ReadInformation())
+  {
+    return false;
+  }
+  selection->EnableAllArrays();
+  return true;
+}
+
+bool Load(vtkSpyPlotUniReader* reader, int timeStep)
+{
+  reader->SetCurrentTimeStep(timeStep);
+  reader->SetNeedToCheck(1);
+  return reader->MakeCurrent() != 0;
+}
+
+// Returns the number of arrays compared, or -1 if they differ.
+int Compare(const std::string& fname)
+{
+  cout << "Opening " << fname.c_str() << endl;
+  vtkNew<vtkDataArraySelection> serialSelection;
+  vtkNew<vtkSpyPlotUniReader> serial;
+  vtkNew<vtkDataArraySelection> parallelSelection;
+  vtkNew<vtkSpyPlotUniReader> parallel;
+  expect(Open(serial, serialSelection, fname, false) &&
+      Open(parallel, parallelSelection, fname, true),
+    "failed to read the information of " << fname);
+
+  int numArrays = 0;
+  int* range = serial->GetTimeStepRange();
+  for (int step = range[0]; step <= range[1]; ++step)
+  {
+    expect(Load(serial, step) && Load(parallel, step),
+      "failed to read time step " << step << " of " << fname);
+    expect(serial->GetNumberOfDataBlocks() == parallel->GetNumberOfDataBlocks(),
+      "the number of blocks differs at time step " << step);
+    for (int field = 0; field < serial->GetNumberOfCellFields(); ++field)
+    {
+      for (int block = 0; block < serial->GetNumberOfDataBlocks(); ++block)
+      {
+        int fixed;
+        vtkDataArray* expected = serial->GetCellFieldData(block, field, &fixed);
+        vtkDataArray* decoded = parallel->GetCellFieldData(block, field, &fixed);
+        if (!expected)
+        {
+          continue;
+        }
+        const char* name = serial->GetCellFieldName(field);
+        expect(decoded && decoded->GetDataType() == expected->GetDataType() &&
+            decoded->GetNumberOfValues() == expected->GetNumberOfValues(),
+          "array " << name << " of block " << block << " differs at time step " << step);
+        expect(memcmp(decoded->GetVoidPointer(0), expected->GetVoidPointer(0),
+                 expected->GetNumberOfValues() * expected->GetDataTypeSize()) == 0,
+          "values of " << name << " of block " << block << " differ at time step " << step);
+        ++numArrays;
+      }
+    }
+  }
+  return numArrays;
+}
+}
+
+int TestSpyPlotDecodeInParallel(int argc, char* argv[])
+{
+  const char* files[] = { "Testing/Data/SPCTH/spcth.0",
+    "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a.0" };
+  int numArrays = 0;
+  for (const char* file : files)
+  {
+    char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, file);
+    std::string path = fname ? fname : "";
+    delete[] fname;
+
+    const int count = Compare(path);
+    if (count < 0)
+    {
+      return EXIT_FAILURE;
+    }
+    numArrays += count;
+  }
+  if (numArrays == 0)
+  {
+    cerr << "ERROR: no cell field was compared." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << __FILE__ << " tests passed." << endl;
+  return EXIT_SUCCESS;
+}
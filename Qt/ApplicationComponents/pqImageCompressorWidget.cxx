@@ -42,7 +42,8 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
@@ -122,6 +123,13 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp deltaRegExp("^vtkDeltaImageCompressor"
+                      "\\s+"          // space
+                      "0"             // 0
+                      "\\s+"          // space
+                      "([0-9]+)"      // num-of-bits.
+                      "(\\s+[0-9]+)?" // optional tile size.
+                      "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -151,6 +159,12 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.zlibColorSpace->setValue(numBits);
     ui.zlibStripAlpha->setCheckState(stripAlpha ? Qt::Checked : Qt::Unchecked);
   }
+  else if (deltaRegExp.exactMatch(value))
+  {
+    int numBits = deltaRegExp.cap(1).toInt();
+    ui.compressionType->setCurrentIndex(DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+  }
   else if (nvpipeRegExp.exactMatch(value))
   {
     int level = nvpipeRegExp.cap(1).toInt();
@@ -181,6 +195,9 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case DELTA_COMPRESSION: // delta
+      return QString("vtkDeltaImageCompressor 0 %1").arg(ui.squirtColorSpace->value());
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +209,10 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  bool squirtLike =
+    (index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION);
+  ui.squirtLabel->setVisible(squirtLike);
+  ui.squirtColorSpace->setVisible(squirtLike);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
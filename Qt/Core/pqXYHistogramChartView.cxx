@@ -31,16 +31,57 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ========================================================================*/
 #include "pqXYHistogramChartView.h"
 
+#include "pqRepresentation.h"
+#include "pqUndoStack.h"
+#include "vtkSMChartRepresentationProxy.h"
 #include "vtkSMContextViewProxy.h"
+#include "vtkSMPropertyHelper.h"
 
 //-----------------------------------------------------------------------------
 pqXYHistogramChartView::pqXYHistogramChartView(const QString& group, const QString& name,
   vtkSMContextViewProxy* viewModule, pqServer* server, QObject* p /*=NULL*/)
   : Superclass(XYHistogramChartViewType(), group, name, viewModule, server, p)
 {
+  QObject::connect(this, SIGNAL(representationAdded(pqRepresentation*)), this,
+    SLOT(onRepresentationAdded(pqRepresentation*)));
+  QObject::connect(this, SIGNAL(endRender()), this, SLOT(refineEarlyResults()));
 }
 
 //-----------------------------------------------------------------------------
 pqXYHistogramChartView::~pqXYHistogramChartView()
 {
 }
+
+//-----------------------------------------------------------------------------
+void pqXYHistogramChartView::onRepresentationAdded(pqRepresentation* repr)
+{
+  vtkSMProxy* proxy = repr->getProxy();
+  if (proxy->GetProperty("EarlyResult"))
+  {
+    pqScopedUndoExclude exclude;
+    vtkSMPropertyHelper(proxy, "EarlyResult").Set(1);
+    proxy->UpdateVTKObjects();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqXYHistogramChartView::refineEarlyResults()
+{
+  bool needsRender = false;
+  QList<pqRepresentation*> reprs = this->getRepresentations();
+  foreach (pqRepresentation* repr, reprs)
+  {
+    vtkSMChartRepresentationProxy* proxy =
+      vtkSMChartRepresentationProxy::SafeDownCast(repr->getProxy());
+    if (proxy && repr->isVisible() && proxy->RefineEarlyResult())
+    {
+      needsRender = true;
+    }
+  }
+  if (needsRender)
+  {
+    // render() is deferred: the estimate gets painted before the exact
+    // histogram is computed.
+    this->render();
+  }
+}
@@ -36,11 +36,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 class vtkSMSourceProxy;
 class pqDataRepresentation;
+class pqRepresentation;
 
 /**
-* pqContextView subclass for "HistogramView". Doesn't do much expect adds
-* the API to get the chartview type and indicates that this view supports
-* selection.
+* pqContextView subclass for "HistogramView". Adds the API to get the
+* chartview type and indicates that this view supports selection.
+* Representations added to this view show early results: large histograms are
+* first estimated and rendered, then refined to the exact counts by a second
+* render.
 */
 class PQCORE_EXPORT pqXYHistogramChartView : public pqContextView
 {
@@ -60,6 +63,18 @@ public:
 
   ~pqXYHistogramChartView() override;
 
+private slots:
+  /**
+  * Turns on early results for the new representation.
+  */
+  void onRepresentationAdded(pqRepresentation*);
+
+  /**
+  * Requests the exact histograms of the representations that rendered an
+  * estimate, and renders again if needed.
+  */
+  void refineEarlyResults();
+
 private:
   Q_DISABLE_COPY(pqXYHistogramChartView)
 };